@@ -34,9 +34,11 @@ bool CsvImport::beforeImport(const ImportManager::StandardImportConfig& config)
 
     stream = new QTextStream(file);
     stream->setCodec(config.codec.toLatin1().data());
+    reader = new CsvReader(stream, csvFormat);
 
     if (!extractColumns())
     {
+        safe_delete(reader);
         safe_delete(stream);
         safe_delete(file);
         return false;
@@ -47,15 +49,16 @@ bool CsvImport::beforeImport(const ImportManager::StandardImportConfig& config)
 
 void CsvImport::afterImport()
 {
+    safe_delete(reader);
     safe_delete(stream);
     safe_delete(file);
 }
 
 bool CsvImport::extractColumns()
 {
-    QStringList deserializedEntry = CsvSerializer::deserializeOneEntry(*stream, csvFormat);
-    while (deserializedEntry.isEmpty() && !stream->atEnd())
-        deserializedEntry = CsvSerializer::deserializeOneEntry(*stream, csvFormat);
+    QStringList deserializedEntry = reader->readEntry();
+    while (deserializedEntry.isEmpty() && !reader->atEnd())
+        deserializedEntry = reader->readEntry();
 
     if (deserializedEntry.isEmpty())
     {
@@ -75,6 +78,7 @@ bool CsvImport::extractColumns()
             columnNames << colTmp.arg(i);
 
         stream->seek(0);
+        reader->reset();
     }
 
     return true;
@@ -120,7 +124,7 @@ QList<ImportPlugin::ColumnDefinition> CsvImport::getColumns() const
 
 QList<QVariant> CsvImport::next()
 {
-    QStringList deserializedEntry = CsvSerializer::deserializeOneEntry(*stream, csvFormat);
+    QStringList deserializedEntry = reader->readEntry();
 
     QList<QVariant> values;
     if (deserializedEntry.isEmpty())
@@ -146,6 +150,14 @@ QList<QVariant> CsvImport::next()
     return values;
 }
 
+qint64 CsvImport::getReadBytes() const
+{
+    if (!file)
+        return -1;
+
+    return file->pos();
+}
+
 CfgMain* CsvImport::getConfig()
 {
     return &cfg;
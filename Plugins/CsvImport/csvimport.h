@@ -34,6 +34,7 @@ class CSVIMPORTSHARED_EXPORT CsvImport : public GenericPlugin, public ImportPlug
         void afterImport();
         QList<ColumnDefinition> getColumns() const;
         QList<QVariant> next();
+        qint64 getReadBytes() const;
         CfgMain* getConfig();
         QString getImportConfigFormName() const;
         bool validateOptions();
@@ -47,6 +48,7 @@ class CSVIMPORTSHARED_EXPORT CsvImport : public GenericPlugin, public ImportPlug
 
         QFile* file = nullptr;
         QTextStream* stream = nullptr;
+        CsvReader* reader = nullptr;
         QStringList columnNames;
         CsvFormat csvFormat;
         CFG_LOCAL_PERSISTABLE(CsvImportConfig, cfg)
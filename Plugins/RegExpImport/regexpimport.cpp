@@ -140,6 +140,14 @@ QList<QVariant> RegExpImport::next()
     return values;
 }
 
+qint64 RegExpImport::getReadBytes() const
+{
+    if (!file)
+        return -1;
+
+    return file->pos();
+}
+
 CfgMain* RegExpImport::getConfig()
 {
     return &cfg;
@@ -35,6 +35,7 @@ class REGEXPIMPORTSHARED_EXPORT RegExpImport : public GenericPlugin, public Impo
         void afterImport();
         QList<ColumnDefinition> getColumns() const;
         QList<QVariant> next();
+        qint64 getReadBytes() const;
         CfgMain* getConfig();
         QString getImportConfigFormName() const;
         bool validateOptions();
@@ -8,29 +8,31 @@
 #include <QDebug>
 #include <QMutexLocker>
 
+QMutex ScriptingTcl::threadContextsMutex;
+
 ScriptingTcl::ScriptingTcl()
 {
-    mainInterpMutex = new QMutex();
 }
 
 ScriptingTcl::~ScriptingTcl()
 {
-    safe_delete(mainInterpMutex);
 }
 
 bool ScriptingTcl::init()
 {
     Q_INIT_RESOURCE(scriptingtcl);
-    QMutexLocker locker(mainInterpMutex);
-    mainContext = new ContextTcl();
     return true;
 }
 
 void ScriptingTcl::deinit()
 {
-    QMutexLocker locker(mainInterpMutex);
-    safe_delete(mainContext);
-    Tcl_Finalize();
+    if (threadContexts.hasLocalData())
+        threadContexts.setLocalData(nullptr);
+
+    // Explicit contexts that were not released keep their interpreters too
+    if (finalizeThreadContexts() && contexts.isEmpty())
+        Tcl_Finalize();
+
     Q_CLEANUP_RESOURCE(scriptingtcl);
 }
 
@@ -118,12 +120,12 @@ QVariant ScriptingTcl::evaluate(ScriptingPlugin::Context* context, const QString
 
 QVariant ScriptingTcl::evaluate(const QString& code, const QList<QVariant>& args, Db* db, bool locking, QString* errorMessage)
 {
-    QMutexLocker locker(mainInterpMutex);
-    setArgs(mainContext, args);
-    QVariant results = compileAndEval(mainContext, code, db, locking);
+    ContextTcl* ctx = getThreadContext();
+    setArgs(ctx, args);
+    QVariant results = compileAndEval(ctx, code, db, locking);
 
-    if (errorMessage && !mainContext->error.isEmpty())
-        *errorMessage = mainContext->error;
+    if (errorMessage && !ctx->error.isEmpty())
+        *errorMessage = ctx->error;
 
     return results;
 }
@@ -137,6 +139,38 @@ ScriptingTcl::ContextTcl* ScriptingTcl::getContext(ScriptingPlugin::Context* con
     return ctx;
 }
 
+ScriptingTcl::ContextTcl* ScriptingTcl::getThreadContext()
+{
+    if (!threadContexts.hasLocalData())
+    {
+        ContextTcl* ctx = new ContextTcl();
+        ctx->threadContextOwner = this;
+        threadContexts.setLocalData(ctx);
+
+        QMutexLocker locker(&threadContextsMutex);
+        liveThreadContexts << ctx;
+    }
+
+    return threadContexts.localData();
+}
+
+bool ScriptingTcl::finalizeThreadContexts()
+{
+    // Tcl interpreter can be deleted only by the thread that created it, so interpreters
+    // of threads that are still running cannot be deleted here. They are deleted when their threads finish,
+    // but Tcl cannot be finalized before that happens, so in that case it's not finalized at all.
+    QMutexLocker locker(&threadContextsMutex);
+    if (liveThreadContexts.isEmpty())
+        return true;
+
+    qWarning() << "Tcl is not finalized, because" << liveThreadContexts.size() << "thread(s) still have Tcl interpreter.";
+    for (ContextTcl* ctx : liveThreadContexts)
+        ctx->threadContextOwner = nullptr;
+
+    liveThreadContexts.clear();
+    return false;
+}
+
 QVariant ScriptingTcl::compileAndEval(ScriptingTcl::ContextTcl* ctx, const QString& code, Db* db, bool locking)
 {
     ScriptObject* scriptObj = nullptr;
@@ -152,13 +186,17 @@ QVariant ScriptingTcl::compileAndEval(ScriptingTcl::ContextTcl* ctx, const QStri
     Tcl_ResetResult(ctx->interp);
     ctx->error.clear();
 
+    // Previous db is restored afterwards, in case the script was called from a query
+    // executed by another script evaluated in this context.
+    Db* previousDb = ctx->db;
+    bool previousLocking = ctx->useDbLocking;
     ctx->db = db;
     ctx->useDbLocking = locking;
 
     int result = Tcl_EvalObjEx(ctx->interp, scriptObj->getTclObj(), TCL_EVAL_GLOBAL);
 
-    ctx->db = nullptr;
-    ctx->useDbLocking = false;
+    ctx->db = previousDb;
+    ctx->useDbLocking = previousLocking;
 
     if (result != TCL_OK)
     {
@@ -176,8 +214,15 @@ QVariant ScriptingTcl::extractResult(ScriptingTcl::ContextTcl* ctx)
 
 void ScriptingTcl::setArgs(ScriptingTcl::ContextTcl* ctx, const QList<QVariant>& args)
 {
-    setVariable(ctx, "argc", args.size());
-    setVariable(ctx, "argv", args);
+    Tcl_Obj* argc = Tcl_NewIntObj(args.size());
+    Tcl_IncrRefCount(argc);
+    Tcl_ObjSetVar2(ctx->interp, ctx->argcVarName, nullptr, argc, 0);
+    Tcl_DecrRefCount(argc);
+
+    Tcl_Obj* argv = argsToList(args);
+    Tcl_IncrRefCount(argv);
+    Tcl_ObjSetVar2(ctx->interp, ctx->argvVarName, nullptr, argv, 0);
+    Tcl_DecrRefCount(argv);
 }
 
 Tcl_Obj* ScriptingTcl::argsToList(const QList<QVariant>& args)
@@ -655,12 +700,25 @@ Tcl_Obj* ScriptingTcl::ScriptObject::getTclObj()
 ScriptingTcl::ContextTcl::ContextTcl()
 {
     scriptCache.setMaxCost(cacheSize);
+    argcVarName = Tcl_NewStringObj("argc", -1);
+    Tcl_IncrRefCount(argcVarName);
+    argvVarName = Tcl_NewStringObj("argv", -1);
+    Tcl_IncrRefCount(argvVarName);
     interp = Tcl_CreateInterp();
     init();
 }
 
 ScriptingTcl::ContextTcl::~ContextTcl()
 {
+    {
+        QMutexLocker locker(&ScriptingTcl::threadContextsMutex);
+        if (threadContextOwner)
+            threadContextOwner->liveThreadContexts.removeOne(this);
+    }
+
+    scriptCache.clear();
+    Tcl_DecrRefCount(argcVarName);
+    Tcl_DecrRefCount(argvVarName);
     Tcl_DeleteInterp(interp);
 }
 
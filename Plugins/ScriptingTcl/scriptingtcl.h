@@ -6,9 +6,10 @@
 #include "plugins/scriptingplugin.h"
 #include "db/sqlquery.h"
 #include <QCache>
+#include <QThreadStorage>
+#include <QMutex>
 #include <tcl.h>
 
-class QMutex;
 struct Tcl_Interp;
 struct Tcl_Obj;
 
@@ -61,6 +62,15 @@ class SCRIPTINGTCLSHARED_EXPORT ScriptingTcl : public GenericPlugin, public DbAw
                 QString error;
                 Db* db = nullptr;
                 bool useDbLocking = false;
+                Tcl_Obj* argcVarName = nullptr;
+                Tcl_Obj* argvVarName = nullptr;
+
+                /**
+                 * @brief Plugin that has this context registered as one of its thread contexts.
+                 *
+                 * Set only for thread contexts. Guarded by ScriptingTcl::threadContextsMutex.
+                 */
+                ScriptingTcl* threadContextOwner = nullptr;
 
             private:
                 void init();
@@ -82,6 +92,8 @@ class SCRIPTINGTCLSHARED_EXPORT ScriptingTcl : public GenericPlugin, public DbAw
         };
 
         ContextTcl* getContext(ScriptingPlugin::Context* context) const;
+        ContextTcl* getThreadContext();
+        bool finalizeThreadContexts();
         QVariant compileAndEval(ContextTcl* ctx, const QString& code, Db* db, bool locking);
         QVariant extractResult(ContextTcl* ctx);
         void setArgs(ContextTcl* ctx, const QList<QVariant>& args);
@@ -104,9 +116,33 @@ class SCRIPTINGTCLSHARED_EXPORT ScriptingTcl : public GenericPlugin, public DbAw
 
         static const constexpr int cacheSize = 5;
 
-        ContextTcl* mainContext = nullptr;
         QList<Context*> contexts;
-        QMutex* mainInterpMutex = nullptr;
+
+        /**
+         * @brief Contexts used by evaluations without explicit context (i.e. SQL functions), one per thread.
+         *
+         * Tcl interpreter (and every Tcl_Obj created with it) can be used only by the thread that created it,
+         * so every thread gets its own interpreter and its own script cache. Evaluations from different threads
+         * (i.e. queries on different databases) can run in parallel. Context of a thread is deleted when the thread finishes.
+         *
+         * This also means that global Tcl variables set by one evaluation are visible only to later evaluations
+         * in the same thread, not to all evaluations, as it was with a single shared interpreter.
+         */
+        QThreadStorage<ContextTcl*> threadContexts;
+
+        /**
+         * @brief All thread contexts that are still alive, in any thread.
+         *
+         * Tcl can be finalized only once none of them is alive. Guarded by threadContextsMutex.
+         */
+        QList<ContextTcl*> liveThreadContexts;
+
+        /**
+         * @brief Guards liveThreadContexts and ContextTcl::threadContextOwner.
+         *
+         * It's static, so a context deleted at the end of its thread can still lock it after the plugin is gone.
+         */
+        static QMutex threadContextsMutex;
 };
 
 #endif // SCRIPTINGTCL_H
@@ -6,6 +6,7 @@
 #include "common/unused.h"
 #include "services/codeformatter.h"
 #include <QTextCodec>
+#include <QDebug>
 
 SqlExport::SqlExport()
 {
@@ -61,10 +62,11 @@ bool SqlExport::beforeExportQueryResults(const QString& query, QList<QueryExecut
 
     writeBegin();
 
+    theTable = wrapObjIfNeeded(cfg.SqlExport.QueryTable.get(), dialect);
+    prepareInsertTemplate(false);
     if (!cfg.SqlExport.GenerateCreateTable.get())
         return true;
 
-    theTable = wrapObjIfNeeded(cfg.SqlExport.QueryTable.get(), dialect);
     QString ddl = "CREATE TABLE " + theTable + " (" + this->columns + ");";
     writeln("");
 
@@ -77,10 +79,7 @@ bool SqlExport::beforeExportQueryResults(const QString& query, QList<QueryExecut
 
 bool SqlExport::exportQueryResultsRow(SqlResultsRowPtr row)
 {
-    QStringList argList = rowToArgList(row);
-    QString argStr = argList.join(", ");
-    QString sql = "INSERT INTO " + theTable + " (" + this->columns + ") VALUES (" + argStr + ");";
-    writeln(sql);
+    appendInsertRow(row);
     return true;
 }
 
@@ -122,6 +121,7 @@ bool SqlExport::exportTable(const QString& database, const QString& table, const
     writeln(tr("-- Table: %1").arg(fullName));
 
     theTable = getNameForObject(database, table, true, dialect);
+    prepareInsertTemplate(!cfg.SqlExport.FormatDdlsOnly.get());
 
     if (cfg.SqlExport.GenerateDrop.get())
         writeln(formatQuery(dropDdl.arg(theTable)));
@@ -132,18 +132,25 @@ bool SqlExport::exportTable(const QString& database, const QString& table, const
 
 bool SqlExport::exportTableRow(SqlResultsRowPtr data)
 {
-    QStringList argList = rowToArgList(data);
-    QString argStr = argList.join(", ");
-    QString sql = "INSERT INTO " + theTable + " (" + columns + ") VALUES (" + argStr + ");";
-    if (!cfg.SqlExport.FormatDdlsOnly.get())
-        sql = formatQuery(sql);
-
-    writeln(sql);
+    appendInsertRow(data);
     return true;
 }
 
+bool SqlExport::afterExportQueryResults()
+{
+    flushInsert();
+    return GenericExportPlugin::afterExportQueryResults();
+}
+
+bool SqlExport::afterExportTable()
+{
+    flushInsert();
+    return GenericExportPlugin::afterExportTable();
+}
+
 bool SqlExport::afterExport()
 {
+    flushInsert();
     writeCommit();
     writeFkEnable();
     return true;
@@ -263,9 +270,74 @@ QString SqlExport::getNameForObject(const QString& database, const QString& name
     return obj;
 }
 
-QStringList SqlExport::rowToArgList(SqlResultsRowPtr row)
+void SqlExport::prepareInsertTemplate(bool format)
+{
+    static_qstring(valuesPlaceholder, ":sqlitestudio_values");
+
+    // SQLite 2 doesn't support multiple rows in single INSERT
+    rowsPerInsert = qMax(1, cfg.SqlExport.RowsPerInsert.get());
+    if (db->getDialect() == Dialect::Sqlite2)
+        rowsPerInsert = 1;
+
+    rowsInInsert = 0;
+    insertPrefix = "INSERT INTO " + theTable + " (" + columns + ") VALUES (";
+    insertRowSeparator = "), (";
+    insertSuffix = ");";
+    if (!format || !cfg.SqlExport.UseFormatter.get())
+        return;
+
+    // Formatter is applied to the statement with a placeholder in place of values. Parts around it are used for all rows.
+    QString formatted = formatQuery(insertPrefix + valuesPlaceholder + insertSuffix);
+    int idx = formatted.indexOf(valuesPlaceholder);
+    if (idx < 0 || formatted.indexOf(valuesPlaceholder, idx + 1) > -1)
+    {
+        qWarning() << "Could not find values placeholder in formatted INSERT statement. Statements will not be formatted.";
+        return;
+    }
+
+    insertPrefix = formatted.left(idx);
+    insertSuffix = formatted.mid(idx + valuesPlaceholder.length());
+}
+
+void SqlExport::appendInsertRow(SqlResultsRowPtr row)
 {
-    return valueListToSqlList(row->valueList(), db->getDialect());
+    if (rowsInInsert == 0)
+    {
+        // Reserved capacity is kept by resize(0), so the buffer is not reallocated for each statement
+        if (insertBuffer.capacity() == 0)
+            insertBuffer.reserve(INSERT_BUFFER_SIZE);
+
+        insertBuffer.resize(0);
+        insertBuffer += insertPrefix;
+    }
+    else
+    {
+        insertBuffer += insertRowSeparator;
+    }
+
+    Dialect dialect = db->getDialect();
+    bool first = true;
+    for (const QVariant& value : row->valueList())
+    {
+        if (!first)
+            insertBuffer += ", ";
+
+        appendValueAsSql(insertBuffer, value, dialect);
+        first = false;
+    }
+
+    if (++rowsInInsert >= rowsPerInsert)
+        flushInsert();
+}
+
+void SqlExport::flushInsert()
+{
+    if (rowsInInsert == 0)
+        return;
+
+    insertBuffer += insertSuffix;
+    writeln(insertBuffer);
+    rowsInInsert = 0;
 }
 
 void SqlExport::validateOptions()
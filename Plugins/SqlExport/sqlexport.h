@@ -13,6 +13,7 @@ CFG_CATEGORIES(SqlExportConfig,
          CFG_ENTRY(bool,    UseFormatter,           false)
          CFG_ENTRY(bool,    FormatDdlsOnly,         false)
          CFG_ENTRY(bool,    GenerateDrop,           false)
+         CFG_ENTRY(int,     RowsPerInsert,          1)
      )
 )
 
@@ -38,6 +39,8 @@ class SQLEXPORTSHARED_EXPORT SqlExport : public GenericExportPlugin
         bool exportVirtualTable(const QString& database, const QString& table, const QStringList& columnNames, const QString& ddl, SqliteCreateVirtualTablePtr createTable,
                                 const QHash<ExportManager::ExportProviderFlag,QVariant> providedData);
         bool exportTableRow(SqlResultsRowPtr data);
+        bool afterExportQueryResults();
+        bool afterExportTable();
         bool afterExport();
         bool beforeExportDatabase(const QString& database);
         bool exportIndex(const QString& database, const QString& name, const QString& ddl, SqliteCreateIndexPtr createIndex);
@@ -56,10 +59,33 @@ class SQLEXPORTSHARED_EXPORT SqlExport : public GenericExportPlugin
         void writeFkEnable();
         QString formatQuery(const QString& sql);
         QString getNameForObject(const QString& database, const QString& name, bool wrapped, Dialect dialect = Dialect::Sqlite3);
-        QStringList rowToArgList(SqlResultsRowPtr row);
+        void prepareInsertTemplate(bool format);
+        void appendInsertRow(SqlResultsRowPtr row);
+        void flushInsert();
 
         QString theTable;
         QString columns;
+
+        /**
+         * @brief Parts of INSERT statement surrounding values of rows.
+         *
+         * They're prepared (and formatted if needed) once per table, so rows don't need to be parsed and formatted.
+         * Statement is made of the prefix, values of rows separated with the row separator and the suffix.
+         */
+        QString insertPrefix;
+        QString insertRowSeparator;
+        QString insertSuffix;
+
+        /**
+         * @brief INSERT statement being built.
+         *
+         * The same buffer is reused for all statements, so its memory is allocated only once.
+         */
+        QString insertBuffer;
+        int rowsInInsert = 0;
+        int rowsPerInsert = 1;
+
+        static const int INSERT_BUFFER_SIZE = 64 * 1024;
         CFG_LOCAL_PERSISTABLE(SqlExportConfig, cfg)
 };
 
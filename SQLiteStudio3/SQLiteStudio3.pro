@@ -13,7 +13,7 @@ lessThan(QT_MAJOR_VERSION, $$REQ_QT_MAJOR)|lessThan(QT_MINOR_VERSION, $$REQ_QT_M
 core.subdir = coreSQLiteStudio
 
 tests.subdir = Tests
-tests.depends = core
+tests.depends = core gui
 
 gui.subdir = guiSQLiteStudio
 gui.depends = core
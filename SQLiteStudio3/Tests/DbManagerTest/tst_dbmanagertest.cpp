@@ -0,0 +1,323 @@
+#include "services/impl/dbmanagerimpl.h"
+#include "plugins/dbpluginstdfilebase.h"
+#include "plugins/genericplugin.h"
+#include "plugins/plugintype.h"
+#include "db/dbsqlite3.h"
+#include "parser/keywords.h"
+#include "parser/lexer.h"
+#include "sqlitestudio.h"
+#include "dbsqlite3mock.h"
+#include "configmock.h"
+#include "pluginmanagermock.h"
+#include "mocks.h"
+#include <QString>
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QAtomicInt>
+#include <QThread>
+
+class TestDbPlugin : public GenericPlugin, public DbPluginStdFileBase
+{
+    public:
+        QString getName() const
+        {
+            return "TestDbPlugin";
+        }
+
+        Db* getInstance(const QString& name, const QString& path, const QHash<QString, QVariant>& options, QString* errorMessage)
+        {
+            probed.ref();
+            return DbPluginStdFileBase::getInstance(name, path, options, errorMessage);
+        }
+
+        Db* getInstanceWithoutProbing(const QString& name, const QString& path, const QHash<QString, QVariant>& options, QString* errorMessage)
+        {
+            notProbed.ref();
+            return DbPluginStdFileBase::getInstanceWithoutProbing(name, path, options, errorMessage);
+        }
+
+        QString getLabel() const
+        {
+            return "Test";
+        }
+
+        QList<DbPluginOption> getOptionsList() const
+        {
+            return QList<DbPluginOption>();
+        }
+
+        bool checkIfDbServedByPlugin(Db* db) const
+        {
+            return dynamic_cast<DbSqlite3*>(db) != nullptr;
+        }
+
+        // Databases are probed in the thread pool
+        QAtomicInt probed;
+        QAtomicInt notProbed;
+
+    protected:
+        Db* newInstance(const QString& name, const QString& path, const QHash<QString, QVariant>& options)
+        {
+            return new DbSqlite3Mock(name, path, options);
+        }
+};
+
+class TestDbPluginType : public DefinedPluginType<DbPlugin>
+{
+    public:
+        TestDbPluginType() : DefinedPluginType<DbPlugin>("Database support", QString())
+        {
+        }
+};
+
+class ProbeCacheConfigMock : public ConfigMock
+{
+    public:
+        QList<CfgDbPtr> dbList()
+        {
+            return databases;
+        }
+
+        DbGroupPtr getDbGroup(const QString&)
+        {
+            return DbGroupPtr::create();
+        }
+
+        QString getDbProbeResult(const QString& path, qint64& modified, qint64& size)
+        {
+            checkThread();
+            ProbeEntry entry = probeResults.value(path, {-1, -1, QString()});
+            modified = entry.modified;
+            size = entry.size;
+            return entry.pluginName;
+        }
+
+        void storeDbProbeResult(const QString& path, qint64 modified, qint64 size, const QString& pluginName)
+        {
+            checkThread();
+            probeResults[path] = {modified, size, pluginName};
+            stored++;
+        }
+
+        // The configuration is not thread-safe, so it's used only by the main thread, even though databases are probed in the pool
+        void checkThread()
+        {
+            if (QThread::currentThread() != QCoreApplication::instance()->thread())
+                usedByOtherThread = true;
+        }
+
+        struct ProbeEntry
+        {
+            qint64 modified;
+            qint64 size;
+            QString pluginName;
+        };
+
+        QList<CfgDbPtr> databases;
+        QHash<QString, ProbeEntry> probeResults;
+        int stored = 0;
+        bool usedByOtherThread = false;
+};
+
+class ProbeCachePluginManagerMock : public PluginManagerMock
+{
+    public:
+        QList<PluginType*> getPluginTypes() const
+        {
+            return {type};
+        }
+
+        QList<Plugin*> getLoadedPlugins(PluginType*) const
+        {
+            return {plugin};
+        }
+
+        void emitLoaded()
+        {
+            emit loaded(plugin, type);
+        }
+
+        PluginType* type = nullptr;
+        Plugin* plugin = nullptr;
+};
+
+class DbManagerTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        DbManagerTest();
+
+    private:
+        void createDbFile(const QString& path);
+        void growDbFile(const QString& path);
+        void registerDb(const QString& name, const QString& path);
+        bool isLoaded(DbManagerImpl& manager, const QString& name);
+
+        QTemporaryDir* dir = nullptr;
+        QString dbPath;
+        TestDbPlugin* plugin = nullptr;
+        TestDbPluginType* pluginType = nullptr;
+        ProbeCacheConfigMock* config = nullptr;
+        ProbeCachePluginManagerMock* pluginManager = nullptr;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void init();
+        void cleanup();
+        void testProbeResultStored();
+        void testProbeCacheHit();
+        void testReprobeAfterFileChange();
+        void testRescanAfterPluginLoaded();
+};
+
+DbManagerTest::DbManagerTest()
+{
+}
+
+void DbManagerTest::createDbFile(const QString& path)
+{
+    DbSqlite3Mock fileDb("filedb", path);
+    QVERIFY(fileDb.open());
+    QVERIFY(!fileDb.exec("CREATE TABLE test (id int, val text);")->isError());
+    fileDb.close();
+}
+
+void DbManagerTest::growDbFile(const QString& path)
+{
+    DbSqlite3Mock fileDb("filedb", path);
+    QVERIFY(fileDb.open());
+    QVERIFY(!fileDb.exec("INSERT INTO test VALUES (1, ?);", QVariant(QString(10000, 'x')))->isError());
+    fileDb.close();
+}
+
+void DbManagerTest::registerDb(const QString& name, const QString& path)
+{
+    Config::CfgDbPtr cfgDb = Config::CfgDbPtr::create();
+    cfgDb->name = name;
+    cfgDb->path = path;
+    config->databases << cfgDb;
+}
+
+bool DbManagerTest::isLoaded(DbManagerImpl& manager, const QString& name)
+{
+    Db* db = manager.getByName(name);
+    return db && db->isValid();
+}
+
+void DbManagerTest::testProbeResultStored()
+{
+    DbManagerImpl manager;
+    QVERIFY(!isLoaded(manager, "testdb"));
+
+    manager.rescanInvalidDatabasesForPlugin(plugin);
+
+    QVERIFY(isLoaded(manager, "testdb"));
+    QVERIFY(plugin->probed.loadAcquire() == 1);
+    QVERIFY(plugin->notProbed.loadAcquire() == 0);
+    QVERIFY(config->stored == 1);
+    QVERIFY(!config->usedByOtherThread);
+    QVERIFY(config->probeResults.value(dbPath).pluginName == "TestDbPlugin");
+}
+
+void DbManagerTest::testProbeCacheHit()
+{
+    {
+        DbManagerImpl manager;
+        manager.rescanInvalidDatabasesForPlugin(plugin);
+        QVERIFY(isLoaded(manager, "testdb"));
+    }
+
+    // Same size and modification time, so the file is not opened for probing again
+    DbManagerImpl manager;
+    manager.rescanInvalidDatabasesForPlugin(plugin);
+
+    QVERIFY(isLoaded(manager, "testdb"));
+    QVERIFY(plugin->probed.loadAcquire() == 1);
+    QVERIFY(plugin->notProbed.loadAcquire() == 1);
+    QVERIFY(config->stored == 1);
+    QVERIFY(!config->usedByOtherThread);
+}
+
+void DbManagerTest::testReprobeAfterFileChange()
+{
+    {
+        DbManagerImpl manager;
+        manager.rescanInvalidDatabasesForPlugin(plugin);
+        QVERIFY(isLoaded(manager, "testdb"));
+    }
+
+    qint64 oldSize = config->probeResults.value(dbPath).size;
+    growDbFile(dbPath);
+    QVERIFY(QFileInfo(dbPath).size() != oldSize);
+
+    DbManagerImpl manager;
+    manager.rescanInvalidDatabasesForPlugin(plugin);
+
+    QVERIFY(isLoaded(manager, "testdb"));
+    QVERIFY(plugin->probed.loadAcquire() == 2);
+    QVERIFY(plugin->notProbed.loadAcquire() == 0);
+    QVERIFY(config->stored == 2);
+    QVERIFY(!config->usedByOtherThread);
+    QVERIFY(config->probeResults.value(dbPath).size == QFileInfo(dbPath).size());
+}
+
+void DbManagerTest::testRescanAfterPluginLoaded()
+{
+    registerDb("missingdb", dir->filePath("missing.db"));
+
+    DbManagerImpl manager;
+    QVERIFY(!isLoaded(manager, "testdb"));
+
+    // Loading the plugin rescans all invalid databases
+    pluginManager->emitLoaded();
+
+    QVERIFY(isLoaded(manager, "testdb"));
+    QVERIFY(!isLoaded(manager, "missingdb"));
+    QVERIFY(plugin->probed.loadAcquire() == 1);
+    QVERIFY(config->stored == 1);
+    QVERIFY(!config->usedByOtherThread);
+    QVERIFY(!config->probeResults.contains(dir->filePath("missing.db")));
+}
+
+void DbManagerTest::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+}
+
+void DbManagerTest::init()
+{
+    initMocks();
+
+    plugin = new TestDbPlugin();
+    pluginType = new TestDbPluginType();
+
+    config = new ProbeCacheConfigMock();
+    SQLITESTUDIO->setConfig(config);
+
+    pluginManager = new ProbeCachePluginManagerMock();
+    pluginManager->type = pluginType;
+    pluginManager->plugin = plugin;
+    SQLITESTUDIO->setPluginManager(pluginManager);
+
+    dir = new QTemporaryDir();
+    QVERIFY(dir->isValid());
+    dbPath = dir->filePath("test.db");
+    createDbFile(dbPath);
+    registerDb("testdb", dbPath);
+}
+
+void DbManagerTest::cleanup()
+{
+    delete dir;
+    dir = nullptr;
+    delete pluginType;
+    pluginType = nullptr;
+    delete plugin;
+    plugin = nullptr;
+}
+
+QTEST_GUILESS_MAIN(DbManagerTest)
+
+#include "tst_dbmanagertest.moc"
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# SQLite 3 connection tests
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_dbsqlite3test
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += \
+        tst_dbsqlite3test.cpp
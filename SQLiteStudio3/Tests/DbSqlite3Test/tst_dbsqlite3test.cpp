@@ -0,0 +1,211 @@
+#include "db/db.h"
+#include "db/sqlquery.h"
+#include "parser/keywords.h"
+#include "parser/lexer.h"
+#include "services/impl/functionmanagerimpl.h"
+#include "sqlitestudio.h"
+#include "dbsqlite3mock.h"
+#include "mocks.h"
+#include <QString>
+#include <QtTest>
+
+class DbSqlite3Test : public QObject
+{
+    Q_OBJECT
+
+    public:
+        DbSqlite3Test();
+
+    private:
+        void execAndDiscard(const QString& query);
+
+        Db* db = nullptr;
+
+        // Same as AbstractDb3::STMT_CACHE_SIZE
+        static const int stmtCacheSize = 64;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void init();
+        void cleanup();
+        void testStmtCacheHit();
+        void testStmtCacheEviction();
+        void testStmtCacheSchemaChange();
+        void testStmtCacheClearedOnClose();
+        void testNextBatchMatchesNext();
+        void testRegExpConstantAndPerRowPattern();
+};
+
+DbSqlite3Test::DbSqlite3Test()
+{
+}
+
+void DbSqlite3Test::execAndDiscard(const QString& query)
+{
+    // Statement goes back to the cache when the results are released
+    SqlQueryPtr results = db->exec(query);
+    QVERIFY(!results->isError());
+    while (results->hasNext())
+        results->next();
+}
+
+void DbSqlite3Test::testStmtCacheHit()
+{
+    execAndDiscard("SELECT * FROM test WHERE id = 1");
+    Db::StatementCacheStats before = db->getStatementCacheStats();
+
+    execAndDiscard("SELECT * FROM test WHERE id = 1");
+    Db::StatementCacheStats after = db->getStatementCacheStats();
+
+    QVERIFY(after.hits == before.hits + 1);
+    QVERIFY(after.misses == before.misses);
+    QVERIFY(after.size == before.size);
+}
+
+void DbSqlite3Test::testStmtCacheEviction()
+{
+    execAndDiscard("SELECT 0");
+    for (int i = 1; i <= stmtCacheSize; i++)
+        execAndDiscard(QString("SELECT %1").arg(i));
+
+    QVERIFY(db->getStatementCacheStats().size == stmtCacheSize);
+
+    // The least recently used one was dropped, the most recently used one is still there
+    Db::StatementCacheStats before = db->getStatementCacheStats();
+    execAndDiscard("SELECT 0");
+    Db::StatementCacheStats after = db->getStatementCacheStats();
+    QVERIFY(after.misses == before.misses + 1);
+    QVERIFY(after.size == stmtCacheSize);
+
+    before = after;
+    execAndDiscard(QString("SELECT %1").arg(stmtCacheSize));
+    after = db->getStatementCacheStats();
+    QVERIFY(after.hits == before.hits + 1);
+}
+
+void DbSqlite3Test::testStmtCacheSchemaChange()
+{
+    execAndDiscard("SELECT * FROM test");
+    execAndDiscard("ALTER TABLE test ADD COLUMN val2 text");
+
+    Db::StatementCacheStats before = db->getStatementCacheStats();
+    SqlQueryPtr results = db->exec("SELECT * FROM test");
+    QVERIFY(!results->isError());
+    QVERIFY(results->getColumnNames() == QStringList({"id", "val", "val2"}));
+    QVERIFY(results->hasNext());
+    SqlResultsRowPtr row = results->next();
+    QVERIFY(row->value("val2").isNull());
+    QVERIFY(row->value("val").toString() == "a");
+
+    // Statement was taken from the cache and recompiled by SQLite for the new schema
+    QVERIFY(db->getStatementCacheStats().hits == before.hits + 1);
+}
+
+void DbSqlite3Test::testStmtCacheClearedOnClose()
+{
+    execAndDiscard("SELECT 1");
+    QVERIFY(db->getStatementCacheStats().size > 0);
+
+    db->close();
+    QVERIFY(db->getStatementCacheStats().size == 0);
+
+    db->open();
+    Db::StatementCacheStats before = db->getStatementCacheStats();
+    execAndDiscard("SELECT 1");
+    QVERIFY(db->getStatementCacheStats().misses == before.misses + 1);
+}
+
+void DbSqlite3Test::testNextBatchMatchesNext()
+{
+    for (int i = 2; i <= 10; i++)
+        db->exec(QString("INSERT INTO test VALUES (%1, 'v%1');").arg(i));
+
+    QList<QList<QVariant>> expected;
+    SqlQueryPtr results = db->exec("SELECT * FROM test ORDER BY id");
+    QVERIFY(!results->isError());
+    while (results->hasNext())
+        expected << results->next()->valueList();
+
+    QVERIFY(expected.size() == 10);
+
+    // 10 rows in batches of 4 gives 4, 4 and the last partial batch of 2
+    QList<int> batchSizes;
+    QList<QList<QVariant>> actual;
+    SqlResultsBlock block;
+    results = db->exec("SELECT * FROM test ORDER BY id");
+    QVERIFY(!results->isError());
+    while (results->nextBatch(4, block) > 0)
+    {
+        QVERIFY(block.columnCount() == 2);
+        QVERIFY(block.getColumns()->getNames() == QStringList({"id", "val"}));
+        batchSizes << block.rowCount();
+        for (int row = 0; row < block.rowCount(); row++)
+            actual << block.rowValues(row);
+    }
+
+    QVERIFY(!results->isError());
+    QVERIFY(block.isEmpty());
+    QVERIFY(batchSizes == QList<int>({4, 4, 2}));
+    QVERIFY(actual == expected);
+}
+
+void DbSqlite3Test::testRegExpConstantAndPerRowPattern()
+{
+    // Mocked function manager has no native functions, so the real one is needed for REGEXP
+    db->close();
+    SQLITESTUDIO->setFunctionManager(new FunctionManagerImpl());
+    QVERIFY(db->open());
+
+    static const QStringList values = {"a1", "b2", "a3", "b4", "c5", "xx"};
+    static const QStringList patterns = {"^a", "^a", "^b", "^b", "[0-9]$", "[0-9]$"};
+    QVERIFY(!db->exec("CREATE TABLE re (val text, pattern text);")->isError());
+    for (int i = 0; i < 100; i++)
+    {
+        for (int j = 0; j < values.size(); j++)
+            db->exec("INSERT INTO re VALUES (?, ?);", {values[j], patterns[j]});
+    }
+
+    // Constant pattern is compiled once and reused for all rows
+    SqlQueryPtr results = db->exec("SELECT count(*) FROM re WHERE val REGEXP '^a';");
+    QVERIFY(!results->isError());
+    QCOMPARE(results->getSingleCell().toInt(), 200);
+
+    // Pattern changing from row to row must not be served from the cache of a previous row
+    results = db->exec("SELECT count(*) FROM re WHERE val REGEXP pattern;");
+    QVERIFY(!results->isError());
+    QCOMPARE(results->getSingleCell().toInt(), 300);
+
+    results = db->exec("SELECT count(*) FROM re WHERE val REGEXP '^b';");
+    QVERIFY(!results->isError());
+    QCOMPARE(results->getSingleCell().toInt(), 200);
+
+    results = db->exec("SELECT 'a' REGEXP '(';");
+    QVERIFY(results->isError());
+}
+
+void DbSqlite3Test::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+}
+
+void DbSqlite3Test::init()
+{
+    initMocks();
+
+    db = new DbSqlite3Mock("testdb");
+    db->open();
+    db->exec("CREATE TABLE test (id int, val text);");
+    db->exec("INSERT INTO test VALUES (1, 'a');");
+}
+
+void DbSqlite3Test::cleanup()
+{
+    db->close();
+    delete db;
+    db = nullptr;
+}
+
+QTEST_APPLESS_MAIN(DbSqlite3Test)
+
+#include "tst_dbsqlite3test.moc"
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Database tree model tests
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib widgets
+
+LIBS += -lguiSQLiteStudio
+
+TARGET = tst_dbtreemodeltest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += \
+        tst_dbtreemodeltest.cpp
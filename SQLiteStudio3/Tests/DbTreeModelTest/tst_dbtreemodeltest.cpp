@@ -0,0 +1,192 @@
+#include "dbtree/dbtreemodel.h"
+#include "dbtree/dbtreeview.h"
+#include "dbtree/dbtreeitem.h"
+#include "db/db.h"
+#include "parser/keywords.h"
+#include "parser/lexer.h"
+#include "sqlitestudio.h"
+#include "dbsqlite3mock.h"
+#include "dbmanagermock.h"
+#include "mocks.h"
+#include <QString>
+#include <QtTest>
+#include <QSignalSpy>
+
+class TreeDbManagerMock : public DbManagerMock
+{
+    public:
+        QList<Db*> getDbList()
+        {
+            return dbList;
+        }
+
+        Db* getByName(const QString& name, Qt::CaseSensitivity cs)
+        {
+            for (Db* db : dbList)
+            {
+                if (db->getName().compare(name, cs) == 0)
+                    return db;
+            }
+            return nullptr;
+        }
+
+        QList<Db*> dbList;
+};
+
+class DbTreeModelTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        DbTreeModelTest();
+
+    private:
+        bool loadSchema();
+
+        Db* db = nullptr;
+        TreeDbManagerMock* dbManager = nullptr;
+        DbTreeModel* model = nullptr;
+        DbTreeView* view = nullptr;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void init();
+        void cleanup();
+        void testChildItemsCreatedOnFetch();
+        void testSchemaDiffApplied();
+        void testFilterWithoutChildItems();
+};
+
+DbTreeModelTest::DbTreeModelTest()
+{
+}
+
+bool DbTreeModelTest::loadSchema()
+{
+    // Schema is read in the background and applied to the tree afterwards
+    QSignalSpy appliedSpy(model, SIGNAL(schemaApplied(Db*)));
+    model->refreshSchema(db);
+    return appliedSpy.wait(5000) && appliedSpy.first().first().value<Db*>() == db;
+}
+
+void DbTreeModelTest::testChildItemsCreatedOnFetch()
+{
+    QVERIFY(loadSchema());
+
+    DbTreeItem* table = model->findItem(DbTreeItem::Type::TABLE, "t1");
+    QVERIFY(table);
+    QCOMPARE(table->rowCount(), 0);
+    QVERIFY(model->hasChildren(table->index()));
+    QVERIFY(model->canFetchMore(table->index()));
+
+    // Looking up items doesn't create child items
+    QVERIFY(!model->findItem(DbTreeItem::Type::INDEX, "idx_t1"));
+    QCOMPARE(table->rowCount(), 0);
+    QCOMPARE(model->findOwnerItem(DbTreeItem::Type::INDEX, "idx_t1"), table);
+    QCOMPARE(model->findOwnerItem(DbTreeItem::Type::TRIGGER, "trg_t1"), table);
+    QCOMPARE(model->getChildObjectNames(table, DbTreeItem::Type::COLUMN), QStringList({"a", "b", "c"}));
+
+    model->fetchMore(table->index());
+    QVERIFY(!model->canFetchMore(table->index()));
+    QCOMPARE(table->rowCount(), 3); // columns, indexes and triggers
+    QVERIFY(model->findItem(DbTreeItem::Type::COLUMN, "b"));
+    QVERIFY(model->findItem(DbTreeItem::Type::INDEX, "idx_t1"));
+    QVERIFY(model->findItem(DbTreeItem::Type::TRIGGER, "trg_t1"));
+
+    // Views have triggers only
+    DbTreeItem* viewItem = model->findItem(DbTreeItem::Type::VIEW, "v1");
+    QVERIFY(viewItem);
+    QVERIFY(model->canFetchMore(viewItem->index()));
+    model->fetchMore(viewItem->index());
+    QCOMPARE(viewItem->rowCount(), 1);
+}
+
+void DbTreeModelTest::testSchemaDiffApplied()
+{
+    QVERIFY(loadSchema());
+
+    DbTreeItem* table = model->findItem(DbTreeItem::Type::TABLE, "t1");
+    QVERIFY(table);
+    model->fetchMore(table->index());
+    QVERIFY(model->findItem(DbTreeItem::Type::TABLE, "t2"));
+
+    QVERIFY(!db->exec("DROP TABLE t2;")->isError());
+    QVERIFY(!db->exec("CREATE TABLE t3 (y);")->isError());
+    QVERIFY(!db->exec("CREATE INDEX idx2_t1 ON t1 (b);")->isError());
+    QVERIFY(loadSchema());
+
+    // Items of objects that still exist are kept, together with their child items
+    QCOMPARE(model->findItem(DbTreeItem::Type::TABLE, "t1"), table);
+    QVERIFY(!model->canFetchMore(table->index()));
+    QVERIFY(model->findItem(DbTreeItem::Type::INDEX, "idx_t1"));
+    QVERIFY(model->findItem(DbTreeItem::Type::INDEX, "idx2_t1"));
+
+    QVERIFY(!model->findItem(DbTreeItem::Type::TABLE, "t2"));
+    DbTreeItem* newTable = model->findItem(DbTreeItem::Type::TABLE, "t3");
+    QVERIFY(newTable);
+    QVERIFY(model->canFetchMore(newTable->index()));
+}
+
+void DbTreeModelTest::testFilterWithoutChildItems()
+{
+    QVERIFY(loadSchema());
+
+    DbTreeItem* t1 = model->findItem(DbTreeItem::Type::TABLE, "t1");
+    DbTreeItem* t2 = model->findItem(DbTreeItem::Type::TABLE, "t2");
+    QVERIFY(t1);
+    QVERIFY(t2);
+
+    // Table matches by name of its index, which is checked in the schema
+    model->applyFilter("idx_t1");
+    QVERIFY(!view->isRowHidden(t1->row(), t1->index().parent()));
+    QVERIFY(view->isRowHidden(t2->row(), t2->index().parent()));
+    QCOMPARE(t1->rowCount(), 0);
+
+    model->applyFilter(QString());
+    QVERIFY(!view->isRowHidden(t2->row(), t2->index().parent()));
+}
+
+void DbTreeModelTest::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+}
+
+void DbTreeModelTest::init()
+{
+    initMocks();
+    dbManager = new TreeDbManagerMock();
+    SQLITESTUDIO->setDbManager(dbManager);
+
+    db = new DbSqlite3Mock("testdb");
+    db->open();
+    db->exec("CREATE TABLE t1 (a, b, c);");
+    db->exec("CREATE INDEX idx_t1 ON t1 (a);");
+    db->exec("CREATE TRIGGER trg_t1 AFTER INSERT ON t1 BEGIN SELECT 1; END;");
+    db->exec("CREATE TABLE t2 (x);");
+    db->exec("CREATE VIEW v1 AS SELECT * FROM t1;");
+    dbManager->dbList << db;
+
+    model = new DbTreeModel();
+    view = new DbTreeView();
+    model->setTreeView(view);
+    view->setModel(model);
+    emit dbManager->dbAdded(db);
+}
+
+void DbTreeModelTest::cleanup()
+{
+    delete view;
+    view = nullptr;
+    delete model;
+    model = nullptr;
+
+    dbManager->dbList.clear();
+    db->close();
+    delete db;
+    db = nullptr;
+}
+
+QTEST_MAIN(DbTreeModelTest)
+
+#include "tst_dbtreemodeltest.moc"
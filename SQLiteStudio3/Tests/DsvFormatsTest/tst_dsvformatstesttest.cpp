@@ -28,6 +28,7 @@ private:
         void testTsv2();
         void testCsv1();
         void testCsvPerformance();
+        void testCsvReader();
 };
 
 DsvFormatsTestTest::DsvFormatsTestTest()
@@ -130,6 +131,25 @@ void DsvFormatsTestTest::testCsvPerformance()
     qDebug() << "Deserialization time:" << time;
 }
 
+void DsvFormatsTestTest::testCsvReader()
+{
+    QString input = "a,b\r\n\"c\nd\",\"e\"\"\"\nf";
+    QTextStream stream(&input, QIODevice::ReadOnly);
+    CsvReader reader(&stream, CsvFormat::DEFAULT);
+
+    QStringList entry = reader.readEntry();
+    QVERIFY2(entry == QStringList({"a", "b"}), entry.join("|").toLocal8Bit().data());
+
+    entry = reader.readEntry();
+    QVERIFY2(entry == QStringList({"c\nd", "e\""}), entry.join("|").toLocal8Bit().data());
+
+    entry = reader.readEntry();
+    QVERIFY2(entry == QStringList({"f"}), entry.join("|").toLocal8Bit().data());
+
+    QVERIFY(reader.atEnd());
+    QVERIFY(reader.readEntry().isEmpty());
+}
+
 QTEST_APPLESS_MAIN(DsvFormatsTestTest)
 
 #include "tst_dsvformatstesttest.moc"
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Export output writer tests
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_exportoutputwritertest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += \
+        tst_exportoutputwritertest.cpp
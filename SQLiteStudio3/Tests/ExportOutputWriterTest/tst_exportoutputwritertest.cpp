@@ -0,0 +1,145 @@
+#include "exportoutputwriter.h"
+#include <QString>
+#include <QtTest>
+#include <QBuffer>
+#include <QTextCodec>
+
+class ExportOutputWriterTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        ExportOutputWriterTest();
+
+    private:
+        QByteArray writeAll(const QStringList& strings);
+
+        // Same as ExportOutputWriter::BUFFER_SIZE
+        static const int writerBufferSize = 256 * 1024;
+
+        QTextCodec* utf8 = nullptr;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void testBmp();
+        void testSurrogatePairs();
+        void testLoneHighSurrogate();
+        void testLoneLowSurrogate();
+        void testWriteln();
+        void testSplitAcrossFlush();
+        void testSurrogatePairSplitAcrossFlush();
+};
+
+ExportOutputWriterTest::ExportOutputWriterTest()
+{
+}
+
+QByteArray ExportOutputWriterTest::writeAll(const QStringList& strings)
+{
+    QBuffer output;
+    output.open(QIODevice::WriteOnly);
+
+    ExportOutputWriter writer(&output, utf8);
+    for (const QString& str : strings)
+        writer.write(str);
+
+    writer.flush();
+    return output.data();
+}
+
+void ExportOutputWriterTest::testBmp()
+{
+    QString str = QString::fromUtf8("ASCII, Zażółć gęślą jaźń, Ελληνικά, 日本語, €, \xef\xbf\xbd");
+    QCOMPARE(writeAll({str}), str.toUtf8());
+}
+
+void ExportOutputWriterTest::testSurrogatePairs()
+{
+    QString str = QString("a") + QChar(0xd83d) + QChar(0xde00) + "b" + QChar(0xd800) + QChar(0xdc00) + QChar(0xdbff) + QChar(0xdfff);
+    QCOMPARE(writeAll({str}), str.toUtf8());
+}
+
+void ExportOutputWriterTest::testLoneHighSurrogate()
+{
+    QString inside = QString("a") + QChar(0xd83d) + "b";
+    QCOMPARE(writeAll({inside}), inside.toUtf8());
+
+    QString beforeHigh = QString("a") + QChar(0xd83d) + QChar(0xd83d) + QChar(0xde00);
+    QCOMPARE(writeAll({beforeHigh}), beforeHigh.toUtf8());
+
+    QString atEnd = QString("a") + QChar(0xd83d);
+    QCOMPARE(writeAll({atEnd}), atEnd.toUtf8());
+}
+
+void ExportOutputWriterTest::testLoneLowSurrogate()
+{
+    QString inside = QString("a") + QChar(0xde00) + "b";
+    QCOMPARE(writeAll({inside}), inside.toUtf8());
+
+    QString atStart = QString(QChar(0xde00)) + "a";
+    QCOMPARE(writeAll({atStart}), atStart.toUtf8());
+
+    QString reversedPair = QString("a") + QChar(0xde00) + QChar(0xd83d);
+    QCOMPARE(writeAll({reversedPair}), reversedPair.toUtf8());
+}
+
+void ExportOutputWriterTest::testWriteln()
+{
+    QBuffer output;
+    output.open(QIODevice::WriteOnly);
+
+    // High surrogate at the end of the line is not paired with anything from the next line
+    QString line = QString::fromUtf8("żółw") + QChar(0xd83d);
+    QString nextLine = QString(QChar(0xde00)) + "x";
+
+    ExportOutputWriter writer(&output, utf8);
+    writer.writeln(line);
+    writer.writeln(nextLine);
+    writer.flush();
+
+    QCOMPARE(output.data(), (line + "\n" + nextLine + "\n").toUtf8());
+}
+
+void ExportOutputWriterTest::testSplitAcrossFlush()
+{
+    QString part = QString::fromUtf8("zażółć ") + QChar(0xd83d) + QChar(0xde00) + QString::fromUtf8(" 日本 ");
+    QStringList strings;
+    QString all;
+    int bytes = 0;
+    while (bytes < writerBufferSize * 3)
+    {
+        strings << part;
+        all += part;
+        bytes += part.toUtf8().size();
+    }
+
+    QCOMPARE(writeAll(strings), all.toUtf8());
+}
+
+void ExportOutputWriterTest::testSurrogatePairSplitAcrossFlush()
+{
+    // First string fills the buffer, so it's written to the device before the low surrogate comes with the second string
+    QString first = QString(writerBufferSize, 'a') + QChar(0xd83d);
+    QString second = QString(QChar(0xde00)) + "b";
+
+    QBuffer output;
+    output.open(QIODevice::WriteOnly);
+
+    ExportOutputWriter writer(&output, utf8);
+    writer.write(first);
+    QVERIFY(output.size() > 0);
+
+    writer.write(second);
+    writer.flush();
+
+    QCOMPARE(output.data(), (first + second).toUtf8());
+}
+
+void ExportOutputWriterTest::initTestCase()
+{
+    utf8 = QTextCodec::codecForName("UTF-8");
+}
+
+QTEST_APPLESS_MAIN(ExportOutputWriterTest)
+
+#include "tst_exportoutputwritertest.moc"
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Data import tests
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_importtest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += \
+        tst_importtest.cpp
@@ -0,0 +1,265 @@
+#include "importworker.h"
+#include "plugins/importplugin.h"
+#include "plugins/genericplugin.h"
+#include "db/db.h"
+#include "parser/keywords.h"
+#include "parser/lexer.h"
+#include "dbsqlite3mock.h"
+#include "mocks.h"
+#include <QString>
+#include <QtTest>
+#include <QSignalSpy>
+#include <QThread>
+
+class TestImportPlugin : public GenericPlugin, public ImportPlugin
+{
+    public:
+        QString getDataSourceTypeName() const
+        {
+            return "Test";
+        }
+
+        ImportManager::StandardConfigFlags standardOptionsToEnable() const
+        {
+            return ImportManager::StandardConfigFlags();
+        }
+
+        QString getFileFilter() const
+        {
+            return QString();
+        }
+
+        bool beforeImport(const ImportManager::StandardImportConfig&)
+        {
+            currentRow = 0;
+            readBytes = 0;
+            readingThread = nullptr;
+            afterImportCalled = false;
+            readAfterImport = false;
+            return true;
+        }
+
+        void afterImport()
+        {
+            afterImportCalled = true;
+        }
+
+        QList<ColumnDefinition> getColumns() const
+        {
+            return {{"id", "INTEGER"}, {"val", "TEXT"}};
+        }
+
+        QList<QVariant> next()
+        {
+            readingThread = QThread::currentThread();
+            if (afterImportCalled)
+                readAfterImport = true;
+
+            if (currentRow >= rows)
+                return QList<QVariant>();
+
+            currentRow++;
+            if (currentRow == interruptAtRow && worker)
+                worker->interrupt();
+
+            QString val = (currentRow == invalidRow) ? QString() : QString("v%1").arg(currentRow);
+            readBytes += val.size() + 8;
+            return {currentRow, val};
+        }
+
+        qint64 getReadBytes() const
+        {
+            return readBytes;
+        }
+
+        CfgMain* getConfig()
+        {
+            return nullptr;
+        }
+
+        QString getImportConfigFormName() const
+        {
+            return QString();
+        }
+
+        bool validateOptions()
+        {
+            return true;
+        }
+
+        int rows = 0;
+        int invalidRow = -1;
+        int interruptAtRow = -1;
+        int currentRow = 0;
+        qint64 readBytes = 0;
+        ImportWorker* worker = nullptr;
+        QThread* readingThread = nullptr;
+        bool afterImportCalled = false;
+        bool readAfterImport = false;
+};
+
+class ImportTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        ImportTest();
+
+    private:
+        bool import(const QString& table);
+        int count(const QString& query);
+
+        static const int ROWS = 2500;
+
+        Db* db = nullptr;
+        TestImportPlugin* plugin = nullptr;
+        ImportManager::StandardImportConfig config;
+        QList<QPair<qint64, qint64>> progress;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void init();
+        void cleanup();
+        void testImportIntoNewTable();
+        void testInvalidRowSkipped();
+        void testInvalidRowFailsImport();
+        void testCommitInterval();
+        void testRowsReadInSeparateThread();
+        void testInterruptWhileReading();
+};
+
+ImportTest::ImportTest()
+{
+}
+
+bool ImportTest::import(const QString& table)
+{
+    ImportWorker worker(plugin, &config, db, table);
+    worker.setAutoDelete(false);
+    plugin->worker = &worker;
+
+    QSignalSpy finishedSpy(&worker, SIGNAL(finished(bool)));
+    QSignalSpy progressSpy(&worker, SIGNAL(progress(qint64,qint64)));
+    worker.run();
+    plugin->worker = nullptr;
+
+    progress.clear();
+    for (const QList<QVariant>& args : progressSpy)
+        progress << QPair<qint64, qint64>(args[0].toLongLong(), args[1].toLongLong());
+
+    return finishedSpy.size() == 1 && finishedSpy.first().first().toBool();
+}
+
+int ImportTest::count(const QString& query)
+{
+    return db->exec(query)->getSingleCell().toInt();
+}
+
+void ImportTest::testImportIntoNewTable()
+{
+    QVERIFY(import("test"));
+
+    // Many rows are inserted with a single statement, so each row has to get to the right place
+    QCOMPARE(count("SELECT count(*) FROM test;"), ROWS);
+    QCOMPARE(count("SELECT count(*) FROM test WHERE val = 'v' || id;"), ROWS);
+    QCOMPARE(count("SELECT min(id) FROM test;"), 1);
+    QCOMPARE(count("SELECT max(id) FROM test;"), ROWS);
+
+    // Final progress reports all rows and all bytes read by the plugin
+    QVERIFY(!progress.isEmpty());
+    QCOMPARE(progress.last().first, static_cast<qint64>(ROWS));
+    QCOMPARE(progress.last().second, plugin->readBytes);
+}
+
+void ImportTest::testInvalidRowSkipped()
+{
+    QVERIFY(!db->exec("CREATE TABLE test (id INTEGER PRIMARY KEY, val TEXT NOT NULL);")->isError());
+    plugin->invalidRow = 1234;
+    config.ignoreErrors = true;
+
+    // The statement with the invalid row fails as a whole, then its rows are inserted one by one
+    QVERIFY(import("test"));
+    QCOMPARE(count("SELECT count(*) FROM test;"), ROWS - 1);
+    QCOMPARE(count("SELECT count(*) FROM test WHERE id = 1234;"), 0);
+    QCOMPARE(count("SELECT count(*) FROM test WHERE id IN (1233, 1235);"), 2);
+    QCOMPARE(progress.last().first, static_cast<qint64>(ROWS - 1));
+}
+
+void ImportTest::testInvalidRowFailsImport()
+{
+    QVERIFY(!db->exec("CREATE TABLE test (id INTEGER PRIMARY KEY, val TEXT NOT NULL);")->isError());
+    plugin->invalidRow = 1234;
+
+    QVERIFY(!import("test"));
+    QCOMPARE(count("SELECT count(*) FROM test;"), 0);
+}
+
+void ImportTest::testCommitInterval()
+{
+    QVERIFY(!db->exec("CREATE TABLE test (id INTEGER PRIMARY KEY, val TEXT NOT NULL);")->isError());
+    plugin->invalidRow = 2400;
+    config.commitInterval = 1000;
+
+    // Rows committed before the failure stay in the table
+    QVERIFY(!import("test"));
+    int imported = count("SELECT count(*) FROM test;");
+    QVERIFY(imported >= 1000);
+    QVERIFY(imported < 2400);
+    QCOMPARE(count("SELECT max(id) FROM test;"), imported);
+}
+
+void ImportTest::testRowsReadInSeparateThread()
+{
+    QVERIFY(import("test"));
+    QCOMPARE(count("SELECT count(*) FROM test;"), ROWS);
+
+    QVERIFY(plugin->readingThread);
+    QVERIFY(plugin->readingThread != QThread::currentThread());
+    QVERIFY(plugin->afterImportCalled);
+    QVERIFY(!plugin->readAfterImport);
+}
+
+void ImportTest::testInterruptWhileReading()
+{
+    QVERIFY(!db->exec("CREATE TABLE test (id INTEGER PRIMARY KEY, val TEXT);")->isError());
+    plugin->rows = 1000000;
+    plugin->interruptAtRow = 5000;
+
+    // Reader is stopped by the interruption, well before reading all rows, and before the plugin is finalized
+    QVERIFY(!import("test"));
+    QVERIFY(plugin->currentRow < plugin->rows);
+    QVERIFY(plugin->afterImportCalled);
+    QVERIFY(!plugin->readAfterImport);
+    QCOMPARE(count("SELECT count(*) FROM test;"), 0);
+}
+
+void ImportTest::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+}
+
+void ImportTest::init()
+{
+    initMocks();
+
+    db = new DbSqlite3Mock("testdb");
+    db->open();
+
+    config = ImportManager::StandardImportConfig();
+    plugin = new TestImportPlugin();
+    plugin->rows = ROWS;
+}
+
+void ImportTest::cleanup()
+{
+    delete plugin;
+    plugin = nullptr;
+    db->close();
+    delete db;
+    db = nullptr;
+}
+
+QTEST_GUILESS_MAIN(ImportTest)
+
+#include "tst_importtest.moc"
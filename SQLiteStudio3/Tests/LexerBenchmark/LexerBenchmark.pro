@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Lexer and keyword lookup benchmarks
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_lexerbenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += \
+        tst_lexerbenchmark.cpp
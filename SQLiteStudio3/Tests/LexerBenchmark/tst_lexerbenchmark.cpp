@@ -0,0 +1,92 @@
+#include "parser/lexer.h"
+#include "parser/keywords.h"
+#include "parser/sqlite3_parse.h"
+#include <QString>
+#include <QStringList>
+#include <QtTest>
+
+class LexerBenchmark : public QObject
+{
+    Q_OBJECT
+
+    public:
+        LexerBenchmark();
+
+    private:
+        QString sql;
+        QStringList words;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void benchmarkKeywordLookup();
+        void benchmarkTokenize();
+        void benchmarkTokenizeTolerant();
+};
+
+LexerBenchmark::LexerBenchmark()
+{
+}
+
+void LexerBenchmark::initTestCase()
+{
+    static const QString statements = QStringLiteral(
+        "CREATE TABLE IF NOT EXISTS customers (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT NOT NULL, email TEXT UNIQUE, created_at DEFAULT CURRENT_TIMESTAMP);\n"
+        "INSERT INTO customers (name, email) VALUES ('John', 'john@example.com'), ('Jane', 'jane@example.com');\n"
+        "SELECT c.id, c.name, count(o.id) AS orders FROM customers c LEFT OUTER JOIN orders o ON o.customer_id = c.id "
+        "WHERE c.email LIKE '%@example.com' GROUP BY c.id HAVING orders > 1 ORDER BY orders DESC LIMIT 10 OFFSET 5;\n"
+        "UPDATE orders SET status = 'shipped' WHERE id IN (SELECT id FROM orders WHERE created_at < date('now', '-1 day'));\n"
+        "-- comment line\n"
+        "DELETE FROM orders WHERE status IS NULL; /* block comment */\n"
+    );
+
+    for (int i = 0; i < 200; i++)
+        sql += statements;
+
+    Lexer lex(Dialect::Sqlite3);
+    for (const TokenPtr& token : lex.tokenize(statements))
+    {
+        if (token->type == Token::KEYWORD || token->type == Token::OTHER)
+            words << token->value;
+    }
+}
+
+void LexerBenchmark::benchmarkKeywordLookup()
+{
+    int keywords = 0;
+    QBENCHMARK
+    {
+        for (const QString& word : words)
+        {
+            if (getKeywordId3(word.constData(), word.size()) != TK3_ID)
+                keywords++;
+        }
+    }
+    QVERIFY(keywords > 0);
+}
+
+void LexerBenchmark::benchmarkTokenize()
+{
+    Lexer lex(Dialect::Sqlite3);
+    TokenList tokens;
+    QBENCHMARK
+    {
+        tokens = lex.tokenize(sql);
+    }
+    QVERIFY(tokens.size() > 0);
+}
+
+void LexerBenchmark::benchmarkTokenizeTolerant()
+{
+    Lexer lex(Dialect::Sqlite3);
+    lex.setTolerantMode(true);
+    TokenList tokens;
+    QBENCHMARK
+    {
+        tokens = lex.tokenize(sql);
+    }
+    QVERIFY(tokens.size() > 0);
+}
+
+QTEST_APPLESS_MAIN(LexerBenchmark)
+
+#include "tst_lexerbenchmark.moc"
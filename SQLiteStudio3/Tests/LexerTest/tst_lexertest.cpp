@@ -1,4 +1,7 @@
 #include "parser/lexer.h"
+#include "parser/keywords.h"
+#include "parser/sqlite3_parse.h"
+#include "parser/sqlite2_parse.h"
 #include <QString>
 #include <QtTest>
 
@@ -15,6 +18,10 @@ class LexerTest : public QObject
         void testHex1();
         void testHex2();
         void testBindParam1();
+        void testTokenPositions();
+        void testGetTokenMatchesTokenize();
+        void testKeywordLookup();
+        void testContinuedTokens();
 };
 
 LexerTest::LexerTest()
@@ -77,6 +84,115 @@ void LexerTest::testBindParam1()
     QVERIFY(bindTokens[4]->value == "@id");
 }
 
+void LexerTest::testTokenPositions()
+{
+    QString sql = "SELECT 'abc', [x y] FROM t; -- end";
+
+    Lexer lex(Dialect::Sqlite3);
+    TokenList tokens = lex.tokenize(sql);
+    QVERIFY(tokens.size() == 13);
+
+    qint64 pos = 0;
+    for (const TokenPtr& token : tokens)
+    {
+        QVERIFY(token->start == pos);
+        QVERIFY(token->value == sql.mid(token->start, token->end - token->start + 1));
+        pos = token->end + 1;
+    }
+    QVERIFY(pos == sql.size());
+    QVERIFY(tokens.last()->type == Token::COMMENT);
+}
+
+void LexerTest::testGetTokenMatchesTokenize()
+{
+    QString sql = "CREATE TABLE t (a, b); INSERT INTO t VALUES (1, 'x''y'); /* unfinished";
+
+    Lexer lex(Dialect::Sqlite3);
+    lex.setTolerantMode(true);
+    TokenList tokens = lex.tokenize(sql);
+
+    lex.prepare(sql);
+    TokenList incrementalTokens;
+    TokenPtr token;
+    while ((token = lex.getToken()))
+        incrementalTokens << token;
+
+    QVERIFY(lex.isEnd());
+    QVERIFY(tokens.size() == incrementalTokens.size());
+    for (int i = 0; i < tokens.size(); i++)
+    {
+        QVERIFY(tokens[i]->value == incrementalTokens[i]->value);
+        QVERIFY(tokens[i]->type == incrementalTokens[i]->type);
+        QVERIFY(tokens[i]->start == incrementalTokens[i]->start);
+    }
+}
+
+void LexerTest::testKeywordLookup()
+{
+    QHashIterator<QString,int> it3(getKeywords3());
+    while (it3.hasNext())
+    {
+        it3.next();
+        QVERIFY(getKeywordId3(it3.key()) == it3.value());
+        QVERIFY(getKeywordId3(it3.key().toLower()) == it3.value());
+    }
+
+    QHashIterator<QString,int> it2(getKeywords2());
+    while (it2.hasNext())
+    {
+        it2.next();
+        QVERIFY(getKeywordId2(it2.key()) == it2.value());
+    }
+
+    QVERIFY(getKeywordId3("SeLeCt") == TK3_SELECT);
+    QVERIFY(getKeywordId3("current_timestamp") == TK3_CTIME_KW);
+    QVERIFY(getKeywordId3("SELEC") == TK3_ID);
+    QVERIFY(getKeywordId3("SELECTS") == TK3_ID);
+    QVERIFY(getKeywordId3("CURRENT_TIMESTAMPS") == TK3_ID);
+    QVERIFY(getKeywordId3(QString("S") + QChar(0x00C9) + "LECT") == TK3_ID);
+    QVERIFY(getKeywordId3("") == TK3_ID);
+    QVERIFY(getKeywordId2("RECURSIVE") == TK2_ID);
+
+    QString sql = "xSELECTx";
+    QVERIFY(getKeywordId3(sql.constData() + 1, 6) == TK3_SELECT);
+}
+
+void LexerTest::testContinuedTokens()
+{
+    QStringList lines = {"SELECT 'multi", "line''s', [id", "x] /* comment *", "", "/ end */ \"a", "b\" FROM x'0g';"};
+    QList<Lexer::OpenToken> openTokens = {Lexer::OpenToken::STRING, Lexer::OpenToken::ID_BRACKET, Lexer::OpenToken::COMMENT,
+                                          Lexer::OpenToken::COMMENT, Lexer::OpenToken::ID_DOUBLE_QUOTE, Lexer::OpenToken::NONE};
+    QStringList firstTokens = {"SELECT", "line''s'", "x]", QString(), "/ end */", "b\""};
+    QList<Token::Type> firstTokenTypes = {Token::KEYWORD, Token::STRING, Token::OTHER, Token::INVALID, Token::COMMENT, Token::OTHER};
+
+    Lexer lex(Dialect::Sqlite3);
+    lex.setTolerantMode(true);
+    Lexer::OpenToken openToken = Lexer::OpenToken::NONE;
+    TokenPtr token;
+    for (int i = 0; i < lines.size(); i++)
+    {
+        lex.prepare(lines[i], openToken);
+        token = lex.getToken();
+        if (firstTokens[i].isNull())
+        {
+            QVERIFY(!token);
+        }
+        else
+        {
+            QVERIFY(token);
+            QVERIFY(token->value == firstTokens[i]);
+            QVERIFY(token->type == firstTokenTypes[i]);
+            QVERIFY(token->start == 0);
+        }
+
+        while (token)
+            token = lex.getToken();
+
+        openToken = lex.getOpenToken();
+        QVERIFY(openToken == openTokens[i]);
+    }
+}
+
 QTEST_APPLESS_MAIN(LexerTest)
 
 #include "tst_lexertest.moc"
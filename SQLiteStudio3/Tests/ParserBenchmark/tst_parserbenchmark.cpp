@@ -0,0 +1,297 @@
+#include "parser/parser.h"
+#include "parser/lexer.h"
+#include "parser/keywords.h"
+#include "parser/ast/sqlitecreatetable.h"
+#include "parser/ast/sqlitecolumntype.h"
+#include "parser/ast/sqliteexpr.h"
+#include "common/utils_sql.h"
+#include "common/global.h"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QtTest>
+#include <new>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+class ParserBenchmark : public QObject
+{
+    Q_OBJECT
+
+    public:
+        ParserBenchmark();
+
+    private:
+        static void storeTokens(const char* fieldName, const QStringList& noTokenInheritanceFields, QHash<QString, TokenList>& tokensMap);
+        static void storeTokens(const QString& fieldName, const QStringList& noTokenInheritanceFields, QHash<QString, TokenList>& tokensMap);
+        static QList<SqliteStatement*> createColumnNodes(bool pooled);
+        static void deleteColumnNodes(const QList<SqliteStatement*>& nodes, bool pooled);
+        static qint64 heapBytesInUse();
+
+        template <class T>
+        static T* createNode(bool pooled);
+
+        static const int TABLES = 300;
+        static const int COLUMNS_PER_TABLE = 20;
+        static const int REDUCTIONS = 100000;
+        static const int COLUMN_NODES = 20000;
+
+        QString schema;
+        QStringList ddlList;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void benchmarkNodeMemory_data();
+        void benchmarkNodeMemory();
+        void benchmarkNodeAllocation_data();
+        void benchmarkNodeAllocation();
+        void benchmarkParseSchema();
+        void benchmarkParseObjectDdl();
+        void benchmarkReductionBookkeeping_data();
+        void benchmarkReductionBookkeeping();
+};
+
+ParserBenchmark::ParserBenchmark()
+{
+}
+
+void ParserBenchmark::storeTokens(const char* fieldName, const QStringList& noTokenInheritanceFields, QHash<QString, TokenList>& tokensMap)
+{
+    // Each use of the field name converts it to QString
+    if (!noTokenInheritanceFields.contains(fieldName))
+    {
+        QString keyForTokensMap = fieldName;
+        int tokensMapKeyCnt = 2;
+        while (tokensMap.contains(keyForTokensMap))
+            keyForTokensMap = fieldName + QString::number(tokensMapKeyCnt++);
+
+        tokensMap[keyForTokensMap] = TokenList();
+    }
+}
+
+void ParserBenchmark::storeTokens(const QString& fieldName, const QStringList& noTokenInheritanceFields, QHash<QString, TokenList>& tokensMap)
+{
+    if (noTokenInheritanceFields.isEmpty() || !noTokenInheritanceFields.contains(fieldName))
+    {
+        QString keyForTokensMap = fieldName;
+        int tokensMapKeyCnt = 2;
+        while (tokensMap.contains(keyForTokensMap))
+            keyForTokensMap = fieldName + QString::number(tokensMapKeyCnt++);
+
+        tokensMap[keyForTokensMap] = TokenList();
+    }
+}
+
+template <class T>
+T* ParserBenchmark::createNode(bool pooled)
+{
+    if (pooled)
+        return new T();
+
+    // Bypasses the pool, the way statements were allocated before
+    return ::new (::operator new(sizeof(T))) T();
+}
+
+QList<SqliteStatement*> ParserBenchmark::createColumnNodes(bool pooled)
+{
+    // Statements the parser creates for a column definition like: col1 INTEGER NOT NULL DEFAULT 0 CHECK (col1 > 0)
+    QList<SqliteStatement*> nodes;
+    nodes.reserve(COLUMN_NODES * 8);
+    for (int i = 0; i < COLUMN_NODES; i++)
+    {
+        nodes << createNode<SqliteCreateTable::Column>(pooled);
+        nodes << createNode<SqliteColumnType>(pooled);
+        nodes << createNode<SqliteCreateTable::Column::Constraint>(pooled);
+        nodes << createNode<SqliteCreateTable::Column::Constraint>(pooled);
+        nodes << createNode<SqliteCreateTable::Column::Constraint>(pooled);
+        nodes << createNode<SqliteExpr>(pooled);
+        nodes << createNode<SqliteExpr>(pooled);
+        nodes << createNode<SqliteExpr>(pooled);
+    }
+    return nodes;
+}
+
+void ParserBenchmark::deleteColumnNodes(const QList<SqliteStatement*>& nodes, bool pooled)
+{
+    for (SqliteStatement* node : nodes)
+    {
+        if (pooled)
+        {
+            delete node;
+            continue;
+        }
+
+        node->~SqliteStatement();
+        ::operator delete(node);
+    }
+}
+
+qint64 ParserBenchmark::heapBytesInUse()
+{
+#ifdef __GLIBC__
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = mallinfo2();
+#else
+    struct mallinfo info = mallinfo();
+#endif
+    return static_cast<qint64>(info.uordblks) + static_cast<qint64>(info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+void ParserBenchmark::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+    initUtilsSql();
+
+    static_qstring(columnTpl, "col%1 %2 NOT NULL DEFAULT %3 CHECK (col%1 IS NOT NULL AND length(col%1) < 100)");
+    static_qstring(tableTpl, "CREATE TABLE IF NOT EXISTS table%1 (id INTEGER PRIMARY KEY AUTOINCREMENT, %2, "
+                             "parent_id INTEGER REFERENCES table%3 (id) ON DELETE CASCADE ON UPDATE NO ACTION, "
+                             "UNIQUE (col1, col2) ON CONFLICT REPLACE);");
+    static_qstring(indexTpl, "CREATE UNIQUE INDEX IF NOT EXISTS idx_table%1 ON table%1 (col3 COLLATE NOCASE DESC, col4) WHERE col5 > 0;");
+    static_qstring(triggerTpl, "CREATE TRIGGER IF NOT EXISTS trg_table%1 AFTER UPDATE OF col1, col2 ON table%1 FOR EACH ROW "
+                               "WHEN new.col1 <> old.col1 BEGIN "
+                               "UPDATE table%1 SET col3 = coalesce(new.col3, 'x') || '-' || old.col3 WHERE id = new.id; "
+                               "INSERT INTO table%1 (col1, col2) SELECT col1, col2 FROM table%1 WHERE id = old.id; "
+                               "END;");
+    static_qstring(viewTpl, "CREATE VIEW IF NOT EXISTS view%1 AS SELECT t.id, t.col1, count(p.id) AS children "
+                            "FROM table%1 t LEFT JOIN table%2 p ON p.parent_id = t.id "
+                            "WHERE t.col2 BETWEEN 1 AND 10 GROUP BY t.id HAVING children > 0 ORDER BY t.col1;");
+
+    static const QStringList types = {"INTEGER", "TEXT", "REAL", "BLOB", "VARCHAR(255)", "NUMERIC(10, 2)"};
+    static const QStringList defaults = {"0", "'abc'", "1.5", "NULL", "CURRENT_TIMESTAMP", "(1 + 2)"};
+
+    QStringList columns;
+    for (int t = 0; t < TABLES; t++)
+    {
+        columns.clear();
+        for (int c = 1; c <= COLUMNS_PER_TABLE; c++)
+            columns << columnTpl.arg(QString::number(c), types[c % types.size()], defaults[c % defaults.size()]);
+
+        ddlList << tableTpl.arg(QString::number(t), columns.join(", "), QString::number(qMax(0, t - 1)));
+        ddlList << indexTpl.arg(t);
+        ddlList << triggerTpl.arg(t);
+        if (t % 10 == 0)
+            ddlList << viewTpl.arg(t).arg(qMax(0, t - 1));
+    }
+    schema = ddlList.join("\n");
+}
+
+void ParserBenchmark::benchmarkNodeMemory_data()
+{
+    QTest::addColumn<bool>("pooled");
+    QTest::newRow("statements allocated one by one") << false;
+    QTest::newRow("statements allocated from pool") << true;
+}
+
+void ParserBenchmark::benchmarkNodeMemory()
+{
+    // Runs before anything else creates statements, so the pool starts without free blocks
+    // and chunks it allocates are counted as well.
+    QFETCH(bool, pooled);
+    if (heapBytesInUse() < 0)
+        QSKIP("Heap usage can be read only with glibc.");
+
+    qint64 bytesBefore = heapBytesInUse();
+    QList<SqliteStatement*> nodes = createColumnNodes(pooled);
+    qint64 bytesUsed = heapBytesInUse() - bytesBefore;
+    deleteColumnNodes(nodes, pooled);
+
+    QTest::setBenchmarkResult(bytesUsed, QTest::BytesAllocated);
+}
+
+void ParserBenchmark::benchmarkNodeAllocation_data()
+{
+    QTest::addColumn<bool>("pooled");
+    QTest::newRow("statements allocated one by one") << false;
+    QTest::newRow("statements allocated from pool") << true;
+}
+
+void ParserBenchmark::benchmarkNodeAllocation()
+{
+    QFETCH(bool, pooled);
+    QBENCHMARK
+    {
+        deleteColumnNodes(createColumnNodes(pooled), pooled);
+    }
+}
+
+void ParserBenchmark::benchmarkParseSchema()
+{
+    Parser parser(Dialect::Sqlite3);
+    bool parsed = false;
+    QBENCHMARK
+    {
+        parsed = parser.parse(schema);
+    }
+    QVERIFY2(parsed, parser.getErrorString().toUtf8().constData());
+    QCOMPARE(parser.getQueries().size(), ddlList.size());
+}
+
+void ParserBenchmark::benchmarkParseObjectDdl()
+{
+    // This is how the SchemaResolver parses the schema - one object at the time
+    Parser parser(Dialect::Sqlite3);
+    int parsed = 0;
+    QBENCHMARK
+    {
+        parsed = 0;
+        for (const QString& ddl : ddlList)
+        {
+            if (parser.parse(ddl))
+                parsed++;
+        }
+    }
+    QCOMPARE(parsed, ddlList.size());
+}
+
+void ParserBenchmark::benchmarkReductionBookkeeping_data()
+{
+    QTest::addColumn<bool>("cachedNames");
+    QTest::newRow("names converted on every use") << false;
+    QTest::newRow("names converted once") << true;
+}
+
+void ParserBenchmark::benchmarkReductionBookkeeping()
+{
+    // Mimics what the parser does with right-hand-side symbols on every reduction, which differs only by the type of symbol names
+    static const char* const symbolNames[] = {
+        "CREATE", "temp", "TABLE", "ifnotexists", "fullname", "LP", "columnlist", "conslist_opt", "RP", "table_options",
+        "column", "columnid", "type", "carglist", "ccons", "expr", "nm", "typetoken", "idxlist_opt", "where_opt"
+    };
+    static const int symbolCount = static_cast<int>(sizeof(symbolNames) / sizeof(symbolNames[0]));
+
+    QFETCH(bool, cachedNames);
+
+    QStringList symbolNameStrings;
+    for (int i = 0; i < symbolCount; i++)
+        symbolNameStrings << QString::fromLatin1(symbolNames[i]);
+
+    QStringList noTokenInheritanceFields;
+    QHash<QString, TokenList> tokensMap;
+    int major;
+    QBENCHMARK
+    {
+        for (int r = 0; r < REDUCTIONS; r++)
+        {
+            tokensMap.clear();
+            for (int i = 0; i < 3; i++)
+            {
+                major = (r + i) % symbolCount;
+                if (cachedNames)
+                    storeTokens(symbolNameStrings[major], noTokenInheritanceFields, tokensMap);
+                else
+                    storeTokens(symbolNames[major], noTokenInheritanceFields, tokensMap);
+            }
+        }
+    }
+    QCOMPARE(tokensMap.size(), 3);
+}
+
+QTEST_APPLESS_MAIN(ParserBenchmark)
+
+#include "tst_parserbenchmark.moc"
@@ -0,0 +1,151 @@
+#include "populateworker.h"
+#include "plugins/populaterandom.h"
+#include "plugins/populaterandomtext.h"
+#include "plugins/populatesequence.h"
+#include "services/config.h"
+#include "db/db.h"
+#include "parser/keywords.h"
+#include "parser/lexer.h"
+#include "dbsqlite3mock.h"
+#include "mocks.h"
+#include <QString>
+#include <QtTest>
+#include <QSignalSpy>
+
+class PopulateTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        PopulateTest();
+
+    private:
+        template <class E>
+        QList<QVariant> generate(uint seed, int count);
+
+        bool populate(const QString& table, const QStringList& columns, const QList<PopulateEngine*>& engines, qint64 rows);
+        int count(const QString& query);
+
+        Db* db = nullptr;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void init();
+        void cleanup();
+        void testRandomReproducible();
+        void testRandomTextReproducible();
+        void testInsertedRowCount();
+        void testReproducibleWithBaseSeed();
+};
+
+PopulateTest::PopulateTest()
+{
+}
+
+template <class E>
+QList<QVariant> PopulateTest::generate(uint seed, int count)
+{
+    E engine;
+    engine.setRandomSeed(seed);
+    if (!engine.beforePopulating(db, "test"))
+        return QList<QVariant>();
+
+    QList<QVariant> values;
+    bool error = false;
+    engine.nextValues(count, values, error);
+    engine.afterPopulating();
+    return error ? QList<QVariant>() : values;
+}
+
+bool PopulateTest::populate(const QString& table, const QStringList& columns, const QList<PopulateEngine*>& engines, qint64 rows)
+{
+    PopulateWorker worker(db, table, columns, engines, rows);
+    worker.setAutoDelete(false);
+
+    QSignalSpy finishedSpy(&worker, SIGNAL(finished(bool)));
+    worker.run();
+    return finishedSpy.size() == 1 && finishedSpy.first().first().toBool();
+}
+
+int PopulateTest::count(const QString& query)
+{
+    return db->exec(query)->getSingleCell().toInt();
+}
+
+void PopulateTest::testRandomReproducible()
+{
+    QList<QVariant> values = generate<PopulateRandomEngine>(1234, 1000);
+    QCOMPARE(values.size(), 1000);
+    QCOMPARE(generate<PopulateRandomEngine>(1234, 1000), values);
+    QVERIFY(generate<PopulateRandomEngine>(4321, 1000) != values);
+}
+
+void PopulateTest::testRandomTextReproducible()
+{
+    QList<QVariant> values = generate<PopulateRandomTextEngine>(1234, 1000);
+    QCOMPARE(values.size(), 1000);
+    QCOMPARE(generate<PopulateRandomTextEngine>(1234, 1000), values);
+    QVERIFY(generate<PopulateRandomTextEngine>(4321, 1000) != values);
+}
+
+void PopulateTest::testInsertedRowCount()
+{
+    QVERIFY(!db->exec("CREATE TABLE test (a, b);")->isError());
+
+    // More rows than in one generated block, ending with a multi-row INSERT shorter than the others
+    PopulateSequenceEngine sequence;
+    PopulateRandomTextEngine text;
+    QVERIFY(populate("test", {"a", "b"}, {&sequence, &text}, 12345));
+
+    QCOMPARE(count("SELECT count(*) FROM test;"), 12345);
+    QCOMPARE(count("SELECT count(DISTINCT a) FROM test;"), 12345);
+    QCOMPARE(count("SELECT min(a) FROM test;"), 1);
+    QCOMPARE(count("SELECT max(a) FROM test;"), 12345);
+    QCOMPARE(count("SELECT count(*) FROM test WHERE b IS NULL;"), 0);
+}
+
+void PopulateTest::testReproducibleWithBaseSeed()
+{
+    CFG_CORE.General.PopulateRandomSeed.set(777);
+    for (const QString& table : {"first", "second"})
+    {
+        QVERIFY(!db->exec(QString("CREATE TABLE %1 (a, b, c);").arg(table))->isError());
+
+        PopulateRandomEngine a;
+        PopulateRandomTextEngine b;
+        PopulateRandomEngine c;
+        QVERIFY(populate(table, {"a", "b", "c"}, {&a, &b, &c}, 1000));
+    }
+
+    QCOMPARE(count("SELECT count(*) FROM first;"), 1000);
+    QCOMPARE(count("SELECT count(*) FROM (SELECT rowid, a, b, c FROM first EXCEPT SELECT rowid, a, b, c FROM second);"), 0);
+
+    // Columns configured the same way still get different seeds
+    QVERIFY(count("SELECT count(*) FROM first WHERE a = c;") < 1000);
+}
+
+void PopulateTest::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+}
+
+void PopulateTest::init()
+{
+    initMocks();
+
+    db = new DbSqlite3Mock("testdb");
+    db->open();
+}
+
+void PopulateTest::cleanup()
+{
+    CFG_CORE.General.PopulateRandomSeed.set(0);
+    db->close();
+    delete db;
+    db = nullptr;
+}
+
+QTEST_GUILESS_MAIN(PopulateTest)
+
+#include "tst_populatetest.moc"
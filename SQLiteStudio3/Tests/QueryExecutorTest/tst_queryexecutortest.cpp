@@ -0,0 +1,196 @@
+#include "db/queryexecutor.h"
+#include "db/queryexecutorsteps/queryexecutorstep.h"
+#include "db/db.h"
+#include "parser/keywords.h"
+#include "parser/lexer.h"
+#include "dbsqlite3mock.h"
+#include "mocks.h"
+#include <QString>
+#include <QtTest>
+
+class LimitCheckStep : public QueryExecutorStep
+{
+        Q_OBJECT
+
+    public:
+        bool exec()
+        {
+            SqliteSelectPtr select = getSelect();
+            limitParsed = select && select->coreSelects.last()->limit;
+            upToDate = context->lastParsedQuery == context->processedQuery;
+            return true;
+        }
+
+        bool limitParsed = false;
+        bool upToDate = false;
+};
+
+class QueryExecutorTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        QueryExecutorTest();
+
+    private:
+        QList<QVariant> execPage(QueryExecutor& executor, int page, QVariant* lastKey = nullptr);
+        QList<QVariant> plainQuery(const QString& query);
+
+        Db* db = nullptr;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void init();
+        void cleanup();
+        void testPagesMatchPlainQuery();
+        void testAdditionalStepGetsParsedLimit();
+        void testKeysetPagesMatchOffsetPages();
+};
+
+QueryExecutorTest::QueryExecutorTest()
+{
+}
+
+QList<QVariant> QueryExecutorTest::execPage(QueryExecutor& executor, int page, QVariant* lastKey)
+{
+    executor.setPage(page);
+    executor.exec();
+
+    QList<QVariant> values;
+    SqlQueryPtr results = executor.getResults();
+    if (!results || results->isError())
+        return values;
+
+    if (executor.getEditionForbiddenGlobalReasons().contains(QueryExecutor::EditionForbiddenReason::SMART_EXECUTION_FAILED))
+        return values;
+
+    int metaColumns = executor.getMetaColumnCount();
+    SqlResultsRowPtr row;
+    while (results->hasNext())
+    {
+        row = results->next();
+        values += row->valueList().mid(metaColumns);
+    }
+
+    // Same as what the data grid does after loading a page
+    if (lastKey && row)
+        *lastKey = row->value(executor.getKeysetColumnAlias());
+
+    return values;
+}
+
+QList<QVariant> QueryExecutorTest::plainQuery(const QString& query)
+{
+    QList<QVariant> values;
+    SqlQueryPtr results = db->exec(query);
+    while (results->hasNext())
+        values += results->next()->valueList();
+
+    return values;
+}
+
+void QueryExecutorTest::testPagesMatchPlainQuery()
+{
+    QList<QVariant> expected = plainQuery("SELECT val FROM test ORDER BY id;");
+    QCOMPARE(expected.size(), 95);
+
+    QueryExecutor executor(db, "SELECT val FROM test");
+    executor.setAsyncMode(false);
+    executor.setSkipRowCounting(true);
+    executor.setResultsPerPage(10);
+
+    QList<QVariant> paged;
+    QList<QVariant> pageValues;
+    for (int page = 0; page < 10; page++)
+    {
+        pageValues = execPage(executor, page);
+        QCOMPARE(pageValues.size(), page < 9 ? 10 : 5);
+        paged += pageValues;
+    }
+    QCOMPARE(paged, expected);
+}
+
+void QueryExecutorTest::testAdditionalStepGetsParsedLimit()
+{
+    // The LIMIT is added to tokens only and parsed again just for additional steps that come after it
+    LimitCheckStep step;
+    QueryExecutor::registerStep(QueryExecutor::AFTER_ROW_LIMIT_AND_OFFSET, &step);
+
+    QueryExecutor executor(db, "SELECT val FROM test");
+    executor.setAsyncMode(false);
+    executor.setSkipRowCounting(true);
+    executor.setResultsPerPage(10);
+    QList<QVariant> values = execPage(executor, 1);
+
+    QueryExecutor::deregisterStep(QueryExecutor::AFTER_ROW_LIMIT_AND_OFFSET, &step);
+
+    QVERIFY(step.limitParsed);
+    QVERIFY(step.upToDate);
+    QCOMPARE(values, plainQuery("SELECT val FROM test ORDER BY id LIMIT 10 OFFSET 10;"));
+}
+
+void QueryExecutorTest::testKeysetPagesMatchOffsetPages()
+{
+    QueryExecutor executor(db, "SELECT val FROM test");
+    executor.setAsyncMode(false);
+    executor.setSkipRowCounting(true);
+    executor.setResultsPerPage(10);
+
+    QList<QList<QVariant>> offsetPages;
+    for (int page = 0; page < 10; page++)
+        offsetPages << execPage(executor, page);
+
+    QVERIFY(executor.getKeysetColumnAlias().isNull());
+
+    executor.setKeysetPaging(true);
+    QVariant key;
+    for (int page = 0; page < 3; page++)
+    {
+        QCOMPARE(execPage(executor, page, &key), offsetPages[page]);
+        QVERIFY(!executor.getKeysetColumnAlias().isNull());
+        executor.setPageSeekKey(page + 1, key);
+    }
+
+    // Jump ahead seeks from the last known key and skips the rest with OFFSET
+    QCOMPARE(execPage(executor, 8), offsetPages[8]);
+    QCOMPARE(execPage(executor, 3), offsetPages[3]);
+    QCOMPARE(execPage(executor, 1), offsetPages[1]);
+    QCOMPARE(execPage(executor, 9), offsetPages[9]);
+
+    // Defined sort order falls back to OFFSET
+    executor.setSortOrder({QueryExecutor::Sort(QueryExecutor::Sort::DESC, 0)});
+    QList<QVariant> values = execPage(executor, 2);
+    QVERIFY(executor.getKeysetColumnAlias().isNull());
+    QCOMPARE(values, plainQuery("SELECT val FROM test ORDER BY val DESC LIMIT 10 OFFSET 20;"));
+}
+
+void QueryExecutorTest::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+}
+
+void QueryExecutorTest::init()
+{
+    initMocks();
+
+    db = new DbSqlite3Mock("testdb");
+    db->open();
+    db->exec("CREATE TABLE test (id INTEGER PRIMARY KEY, val TEXT);");
+    db->exec("WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM cnt WHERE x < 100) "
+             "INSERT INTO test SELECT x * 3, 'v' || x FROM cnt;");
+
+    // Gaps in keys, so that a key doesn't tell the row's position
+    db->exec("DELETE FROM test WHERE id % 20 = 0;");
+}
+
+void QueryExecutorTest::cleanup()
+{
+    db->close();
+    delete db;
+    db = nullptr;
+}
+
+QTEST_APPLESS_MAIN(QueryExecutorTest)
+
+#include "tst_queryexecutortest.moc"
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Schema catalog tests
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_schemacatalogtest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += \
+        tst_schemacatalogtest.cpp
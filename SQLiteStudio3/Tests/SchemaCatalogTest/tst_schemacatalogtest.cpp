@@ -0,0 +1,193 @@
+#include "schemacatalog.h"
+#include "schemaresolver.h"
+#include "db/db.h"
+#include "parser/parser.h"
+#include "parser/token.h"
+#include "parser/keywords.h"
+#include "parser/lexer.h"
+#include "dbsqlite3mock.h"
+#include "mocks.h"
+#include <QString>
+#include <QtTest>
+#include <QTemporaryDir>
+
+class SchemaCatalogTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        SchemaCatalogTest();
+
+    private:
+        void createDbFile(const QString& path, const QString& ddl);
+
+        Db* db = nullptr;
+        SchemaCatalog* catalog = nullptr;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void init();
+        void cleanup();
+        void testHit();
+        void testMiss();
+        void testVersionBump();
+        void testReattach();
+        void testResolverReattach();
+        void testDatabaseList();
+        void testCopyKeepsTokenType();
+};
+
+SchemaCatalogTest::SchemaCatalogTest()
+{
+}
+
+void SchemaCatalogTest::createDbFile(const QString& path, const QString& ddl)
+{
+    DbSqlite3Mock fileDb("filedb", path);
+    QVERIFY(fileDb.open());
+    QVERIFY(!fileDb.exec(ddl)->isError());
+    fileDb.close();
+}
+
+void SchemaCatalogTest::testHit()
+{
+    SchemaCatalog::SchemaState state(1, "/tmp/test.db");
+    catalog->putDdl(db, "main", state, "table.t", "CREATE TABLE t (a);");
+    catalog->putTableColumns(db, "main", state, "t", {"a"});
+
+    QVERIFY(catalog->getDdl(db, "main", state, "table.t") == "CREATE TABLE t (a);");
+    QVERIFY(catalog->getDdl(db, "MAIN", state, "table.t") == "CREATE TABLE t (a);");
+
+    QStringList columns;
+    QVERIFY(catalog->getTableColumns(db, "main", state, "t", columns));
+    QVERIFY(columns == QStringList({"a"}));
+}
+
+void SchemaCatalogTest::testMiss()
+{
+    SchemaCatalog::SchemaState state(1, "/tmp/test.db");
+    catalog->putDdl(db, "main", state, "table.t", "CREATE TABLE t (a);");
+
+    QVERIFY(catalog->getDdl(db, "main", state, "table.other").isNull());
+    QVERIFY(catalog->getDdl(db, "temp", state, "table.t").isNull());
+
+    QStringList columns;
+    QVERIFY(!catalog->getTableColumns(db, "main", state, "t", columns));
+    QVERIFY(columns.isEmpty());
+}
+
+void SchemaCatalogTest::testVersionBump()
+{
+    SchemaCatalog::SchemaState state(1, "/tmp/test.db");
+    catalog->putDdl(db, "main", state, "table.t", "CREATE TABLE t (a);");
+
+    SchemaCatalog::SchemaState bumpedState(2, "/tmp/test.db");
+    QVERIFY(catalog->getDdl(db, "main", bumpedState, "table.t").isNull());
+
+    // Entries of the old version were dropped, not just hidden
+    QVERIFY(catalog->getDdl(db, "main", state, "table.t").isNull());
+}
+
+void SchemaCatalogTest::testReattach()
+{
+    SchemaCatalog::SchemaState state(1, "/tmp/first.db");
+    catalog->putDdl(db, "att", state, "table.t", "CREATE TABLE t (a);");
+
+    // Same attach name and the same schema version, but another file
+    SchemaCatalog::SchemaState otherFileState(1, "/tmp/second.db");
+    QVERIFY(catalog->getDdl(db, "att", otherFileState, "table.t").isNull());
+}
+
+void SchemaCatalogTest::testResolverReattach()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString firstFile = dir.filePath("first.db");
+    QString secondFile = dir.filePath("second.db");
+    createDbFile(firstFile, "CREATE TABLE t (a int);");
+    createDbFile(secondFile, "CREATE TABLE t (b int);");
+
+    QVERIFY(!db->exec(QString("ATTACH '%1' AS att;").arg(firstFile))->isError());
+    int firstVersion = db->exec("PRAGMA att.schema_version;")->getSingleCell().toInt();
+
+    SchemaResolver resolver(db);
+    QVERIFY(resolver.getTableColumns("att", "t") == QStringList({"a"}));
+    QVERIFY(resolver.getTableColumns("att", "t") == QStringList({"a"}));
+
+    // Plain DETACH and ATTACH statements, not going through Db::detach()
+    QVERIFY(!db->exec("DETACH att;")->isError());
+    QVERIFY(!db->exec(QString("ATTACH '%1' AS att;").arg(secondFile))->isError());
+    QVERIFY(db->exec("PRAGMA att.schema_version;")->getSingleCell().toInt() == firstVersion);
+
+    QVERIFY(resolver.getTableColumns("att", "t") == QStringList({"b"}));
+
+    QVERIFY(!db->exec("DETACH att;")->isError());
+}
+
+void SchemaCatalogTest::testDatabaseList()
+{
+    QString file;
+    QVERIFY(!catalog->getSchemaFile(db, "main", file));
+
+    catalog->putSchemaFiles(db, {{"main", "/tmp/test.db"}, {"temp", ""}, {"att", "/tmp/first.db"}});
+    QVERIFY(catalog->getSchemaFile(db, "MAIN", file));
+    QVERIFY(file == "/tmp/test.db");
+    QVERIFY(catalog->getSchemaFile(db, "att", file));
+    QVERIFY(file == "/tmp/first.db");
+
+    // Detaching any schema changes the list
+    catalog->invalidate(db, "att");
+    QVERIFY(!catalog->getSchemaFile(db, "main", file));
+
+    catalog->putSchemaFiles(db, {{"main", "/tmp/test.db"}});
+    catalog->invalidateSchemaFiles(db);
+    QVERIFY(!catalog->getSchemaFile(db, "main", file));
+}
+
+void SchemaCatalogTest::testCopyKeepsTokenType()
+{
+    Parser parser(Dialect::Sqlite3);
+    QVERIFY(parser.parse("SELECT 1;"));
+    SqliteQueryPtr query = parser.getQueries().first();
+
+    TolerantTokenPtr token = TolerantTokenPtr::create();
+    token->type = Token::COMMENT;
+    token->value = "/* unfinished";
+    token->invalid = true;
+    query->tokens << token;
+
+    SqliteQueryPtr copy = SchemaCatalog::copyOf(query);
+    TolerantToken* copiedToken = dynamic_cast<TolerantToken*>(copy->tokens.last().data());
+    QVERIFY(copiedToken != nullptr);
+    QVERIFY(copiedToken != token.data());
+    QVERIFY(copiedToken->invalid);
+    QVERIFY(copiedToken->value == "/* unfinished");
+}
+
+void SchemaCatalogTest::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+}
+
+void SchemaCatalogTest::init()
+{
+    initMocks();
+
+    db = new DbSqlite3Mock("testdb", ":memory:", {{SchemaResolver::USE_SCHEMA_CACHING, true}});
+    db->open();
+    catalog = new SchemaCatalog();
+}
+
+void SchemaCatalogTest::cleanup()
+{
+    delete catalog;
+    catalog = nullptr;
+    db->close();
+    delete db;
+    db = nullptr;
+}
+
+QTEST_APPLESS_MAIN(SchemaCatalogTest)
+
+#include "tst_schemacatalogtest.moc"
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# QtScript scripting plugin tests
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib script
+
+QT       -= gui
+
+TARGET = tst_scriptingqttest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += \
+        tst_scriptingqttest.cpp
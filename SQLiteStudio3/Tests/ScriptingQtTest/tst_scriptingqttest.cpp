@@ -0,0 +1,115 @@
+#include "plugins/scriptingqt.h"
+#include "common/global.h"
+#include <QString>
+#include <QThread>
+#include <QSemaphore>
+#include <QtTest>
+
+class EvalThread : public QThread
+{
+    public:
+        EvalThread(ScriptingQt* plugin, int increment, QSemaphore* ready, QSemaphore* go) :
+            plugin(plugin), increment(increment), ready(ready), go(go)
+        {
+        }
+
+        static const int EVALUATIONS = 2000;
+
+        QVariant result;
+        QString error;
+
+    protected:
+        void run()
+        {
+            static_qstring(code, "if (typeof counter == 'undefined') counter = 0; counter += arguments[0]; return counter;");
+
+            // Both threads start evaluating at the same time
+            ready->release();
+            go->acquire();
+
+            for (int i = 0; i < EVALUATIONS && error.isEmpty(); i++)
+                result = plugin->evaluate(code, {increment}, nullptr, false, &error);
+        }
+
+    private:
+        ScriptingQt* plugin = nullptr;
+        int increment = 0;
+        QSemaphore* ready = nullptr;
+        QSemaphore* go = nullptr;
+};
+
+class ScriptingQtTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        ScriptingQtTest();
+
+    private:
+        ScriptingQt* plugin = nullptr;
+
+    private Q_SLOTS:
+        void init();
+        void cleanup();
+        void testEvaluate();
+        void testParallelEvaluationsHavePerThreadGlobals();
+};
+
+ScriptingQtTest::ScriptingQtTest()
+{
+}
+
+void ScriptingQtTest::init()
+{
+    plugin = new ScriptingQt();
+    QVERIFY(plugin->init());
+}
+
+void ScriptingQtTest::cleanup()
+{
+    plugin->deinit();
+    delete plugin;
+    plugin = nullptr;
+}
+
+void ScriptingQtTest::testEvaluate()
+{
+    QString error;
+    QVariant result = plugin->evaluate("return arguments[0] + arguments[1];", {2, 3}, nullptr, false, &error);
+    QVERIFY2(error.isEmpty(), error.toUtf8().constData());
+    QCOMPARE(result.toInt(), 5);
+
+    plugin->evaluate("return undefinedFunction();", {}, nullptr, false, &error);
+    QVERIFY(!error.isEmpty());
+}
+
+void ScriptingQtTest::testParallelEvaluationsHavePerThreadGlobals()
+{
+    QSemaphore ready;
+    QSemaphore go;
+    EvalThread first(plugin, 1, &ready, &go);
+    EvalThread second(plugin, 1000, &ready, &go);
+    first.start();
+    second.start();
+
+    ready.acquire(2);
+    go.release(2);
+
+    QVERIFY(first.wait(60000));
+    QVERIFY(second.wait(60000));
+    QVERIFY2(first.error.isEmpty(), first.error.toUtf8().constData());
+    QVERIFY2(second.error.isEmpty(), second.error.toUtf8().constData());
+
+    // Each thread sees only its own global variable
+    QCOMPARE(first.result.toInt(), EvalThread::EVALUATIONS);
+    QCOMPARE(second.result.toInt(), EvalThread::EVALUATIONS * 1000);
+
+    // ...and the thread that did not evaluate anything has none
+    QString error;
+    QCOMPARE(plugin->evaluate("return typeof counter;", {}, nullptr, false, &error).toString(), QString("undefined"));
+    QVERIFY2(error.isEmpty(), error.toUtf8().constData());
+}
+
+QTEST_GUILESS_MAIN(ScriptingQtTest)
+
+#include "tst_scriptingqttest.moc"
@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# SQL export plugin tests
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib
+
+QT       -= gui
+
+TARGET = tst_sqlexporttest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+# The plugin is compiled into the test, so its private parts work exactly as in the plugin library
+SQLEXPORT_DIR = $$PWD/../../../Plugins/SqlExport
+INCLUDEPATH += $$SQLEXPORT_DIR
+DEFINES += SQLEXPORT_LIBRARY
+
+SOURCES += \
+        tst_sqlexporttest.cpp \
+        $$SQLEXPORT_DIR/sqlexport.cpp
+
+HEADERS += \
+        $$SQLEXPORT_DIR/sqlexport.h
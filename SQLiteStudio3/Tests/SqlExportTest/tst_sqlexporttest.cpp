@@ -0,0 +1,460 @@
+#include "sqlexport.h"
+#include "exportworker.h"
+#include "db/db.h"
+#include "db/dbsqlite3.h"
+#include "db/sqlresultsrow.h"
+#include "plugins/dbpluginstdfilebase.h"
+#include "plugins/genericplugin.h"
+#include "plugins/plugintype.h"
+#include "common/global.h"
+#include "config_builder/cfgmain.h"
+#include "config_builder/cfgcategory.h"
+#include "config_builder/cfgentry.h"
+#include "parser/keywords.h"
+#include "parser/lexer.h"
+#include "sqlitestudio.h"
+#include "dbsqlite3mock.h"
+#include "pluginmanagermock.h"
+#include "mocks.h"
+#include <QString>
+#include <QtTest>
+#include <QBuffer>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+class TestDbPlugin : public GenericPlugin, public DbPluginStdFileBase
+{
+    public:
+        QString getName() const
+        {
+            return "TestDbPlugin";
+        }
+
+        Db* getInstanceWithoutProbing(const QString& name, const QString& path, const QHash<QString, QVariant>& options, QString* errorMessage)
+        {
+            instances++;
+            return DbPluginStdFileBase::getInstanceWithoutProbing(name, path, options, errorMessage);
+        }
+
+        QString getLabel() const
+        {
+            return "Test";
+        }
+
+        QList<DbPluginOption> getOptionsList() const
+        {
+            return QList<DbPluginOption>();
+        }
+
+        bool checkIfDbServedByPlugin(Db* db) const
+        {
+            return dynamic_cast<DbSqlite3*>(db) != nullptr;
+        }
+
+        // Additional connections are opened by the export worker thread
+        int instances = 0;
+
+    protected:
+        Db* newInstance(const QString& name, const QString& path, const QHash<QString, QVariant>& options)
+        {
+            return new DbSqlite3Mock(name, path, options);
+        }
+};
+
+class TestDbPluginType : public DefinedPluginType<DbPlugin>
+{
+    public:
+        TestDbPluginType() : DefinedPluginType<DbPlugin>("Database support", QString())
+        {
+        }
+};
+
+class ExportPluginManagerMock : public PluginManagerMock
+{
+    public:
+        QList<PluginType*> getPluginTypes() const
+        {
+            return {type};
+        }
+
+        QList<Plugin*> getLoadedPlugins(PluginType*) const
+        {
+            return {plugin};
+        }
+
+        PluginType* type = nullptr;
+        Plugin* plugin = nullptr;
+};
+
+class StatsSqlExport : public SqlExport
+{
+    public:
+        ExportManager::ExportProviderFlags getProviderFlags() const
+        {
+            return ExportManager::ROW_COUNT | ExportManager::DATA_LENGTHS;
+        }
+
+        bool exportTable(const QString& database, const QString& table, const QStringList& columnNames, const QString& ddl, SqliteCreateTablePtr createTable,
+                         const QHash<ExportManager::ExportProviderFlag, QVariant> providedData)
+        {
+            rowCounts[table] = providedData[ExportManager::ROW_COUNT].toInt();
+            dataLengths[table] = providedData[ExportManager::DATA_LENGTHS].value<QList<int>>();
+            return SqlExport::exportTable(database, table, columnNames, ddl, createTable, providedData);
+        }
+
+        QHash<QString, int> rowCounts;
+        QHash<QString, QList<int>> dataLengths;
+};
+
+class WritingSqlExport : public SqlExport
+{
+    public:
+        bool exportTableRow(SqlResultsRowPtr data)
+        {
+            // Another connection modifies the database in the middle of the export
+            if (writer)
+            {
+                written = !writer->exec("INSERT INTO t0 (id, val) VALUES (0, 'new');")->isError() &&
+                          !writer->exec("UPDATE t0 SET val = 'changed';")->isError() &&
+                          !writer->exec("CREATE INDEX idx_new ON t0 (id);")->isError();
+                writer = nullptr;
+            }
+            return SqlExport::exportTableRow(data);
+        }
+
+        Db* writer = nullptr;
+        bool written = false;
+};
+
+class SqlExportTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        SqlExportTest();
+
+    private:
+        void setRowsPerInsert(int rows);
+        void beginTable(const QString& table);
+        void exportRows(int firstId, int lastId);
+        QStringList finishExport();
+        QStringList createTables(Db* fileDb);
+        QString exportDatabase(Db* fileDb, const QStringList& objects, SqlExport* exportPlugin);
+        QString exportTable(Db* fileDb, const QString& table, SqlExport* exportPlugin);
+        QString runExport(ExportWorker* worker, QBuffer* workerOutput);
+
+        static const int TABLES = 4;
+        static const int ROWS_PER_TABLE = 2500;
+
+        Db* db = nullptr;
+        SqlExport* plugin = nullptr;
+        QBuffer* output = nullptr;
+        ExportManager::StandardExportConfig config;
+        TestDbPlugin* dbPlugin = nullptr;
+        TestDbPluginType* dbPluginType = nullptr;
+
+    private Q_SLOTS:
+        void initTestCase();
+        void init();
+        void cleanup();
+        void testSingleRowInserts();
+        void testRowsGroupedInInsert();
+        void testPartialInsertFlushedAfterTable();
+        void testNoEmptyInsertAfterFullGroup();
+        void testParallelReadingSameAsSequential();
+        void testSnapshotNotAffectedByWrites();
+};
+
+SqlExportTest::SqlExportTest()
+{
+}
+
+void SqlExportTest::setRowsPerInsert(int rows)
+{
+    plugin->getConfig()->getCategories()["SqlExport"]->getEntryByName("RowsPerInsert")->set(rows);
+}
+
+void SqlExportTest::beginTable(const QString& table)
+{
+    QVERIFY(plugin->exportTable("main", table, {"id", "val"}, QString("CREATE TABLE %1 (id int, val text);").arg(table),
+                                SqliteCreateTablePtr(), QHash<ExportManager::ExportProviderFlag,QVariant>()));
+}
+
+void SqlExportTest::exportRows(int firstId, int lastId)
+{
+    SqlResultsBlock block;
+    block.reset(SqlResultsColumnsPtr(new SqlResultsColumns({"id", "val"})));
+    for (int id = firstId; id <= lastId; id++)
+        block.appendRow({id, QString("v%1").arg(id)});
+
+    SqlResultsBlockRowPtr row(new SqlResultsBlockRow());
+    for (int i = 0; i < block.rowCount(); i++)
+    {
+        row->load(block, i);
+        QVERIFY(plugin->exportTableRow(row));
+    }
+}
+
+QStringList SqlExportTest::finishExport()
+{
+    plugin->afterExport();
+    plugin->flushOutput();
+
+    QStringList inserts;
+    for (const QString& line : QString::fromUtf8(output->data()).split("\n"))
+    {
+        if (line.startsWith("INSERT"))
+            inserts << line;
+    }
+    return inserts;
+}
+
+QStringList SqlExportTest::createTables(Db* fileDb)
+{
+    static_qstring(createTpl, "CREATE TABLE t%1 (id int, val text);");
+    static_qstring(indexTpl, "CREATE INDEX idx_t%1 ON t%1 (val);");
+    static_qstring(insertTpl, "WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < %2) "
+                              "INSERT INTO t%1 (id, val) SELECT n, 't%1-' || n FROM seq;");
+
+    QStringList objects;
+    for (int t = 0; t < TABLES; t++)
+    {
+        if (fileDb->exec(createTpl.arg(t))->isError() || fileDb->exec(indexTpl.arg(t))->isError() ||
+            fileDb->exec(insertTpl.arg(t).arg(ROWS_PER_TABLE))->isError())
+        {
+            return QStringList();
+        }
+
+        objects << QString("t%1").arg(t) << QString("idx_t%1").arg(t);
+    }
+    return objects;
+}
+
+QString SqlExportTest::exportDatabase(Db* fileDb, const QStringList& objects, SqlExport* exportPlugin)
+{
+    QBuffer workerOutput;
+    workerOutput.open(QIODevice::WriteOnly);
+    exportPlugin->setExportMode(ExportManager::DATABASE);
+
+    ExportWorker worker(exportPlugin, &config, &workerOutput);
+    worker.prepareExportDatabase(fileDb, objects);
+    return runExport(&worker, &workerOutput);
+}
+
+QString SqlExportTest::exportTable(Db* fileDb, const QString& table, SqlExport* exportPlugin)
+{
+    QBuffer workerOutput;
+    workerOutput.open(QIODevice::WriteOnly);
+    exportPlugin->setExportMode(ExportManager::TABLE);
+
+    ExportWorker worker(exportPlugin, &config, &workerOutput);
+    worker.prepareExportTable(fileDb, "main", table);
+    return runExport(&worker, &workerOutput);
+}
+
+QString SqlExportTest::runExport(ExportWorker* worker, QBuffer* workerOutput)
+{
+    worker->setAutoDelete(false);
+    QSignalSpy finishedSpy(worker, SIGNAL(finished(bool,QIODevice*)));
+    worker->run();
+    if (finishedSpy.size() != 1 || !finishedSpy.first().first().toBool())
+        return QString();
+
+    // The header contains time of the export
+    QStringList lines;
+    for (const QString& line : QString::fromUtf8(workerOutput->data()).split("\n"))
+    {
+        if (!line.startsWith("-- File generated"))
+            lines << line;
+    }
+    return lines.join("\n");
+}
+
+void SqlExportTest::testSingleRowInserts()
+{
+    beginTable("test");
+    exportRows(1, 3);
+    QVERIFY(plugin->afterExportTable());
+
+    QStringList expected = {
+        "INSERT INTO test (id, val) VALUES (1, 'v1');",
+        "INSERT INTO test (id, val) VALUES (2, 'v2');",
+        "INSERT INTO test (id, val) VALUES (3, 'v3');"
+    };
+    QCOMPARE(finishExport(), expected);
+}
+
+void SqlExportTest::testRowsGroupedInInsert()
+{
+    setRowsPerInsert(3);
+    beginTable("test");
+    exportRows(1, 6);
+    QVERIFY(plugin->afterExportTable());
+
+    QStringList expected = {
+        "INSERT INTO test (id, val) VALUES (1, 'v1'), (2, 'v2'), (3, 'v3');",
+        "INSERT INTO test (id, val) VALUES (4, 'v4'), (5, 'v5'), (6, 'v6');"
+    };
+    QCOMPARE(finishExport(), expected);
+}
+
+void SqlExportTest::testPartialInsertFlushedAfterTable()
+{
+    setRowsPerInsert(3);
+    beginTable("test");
+    exportRows(1, 4);
+    QVERIFY(plugin->afterExportTable());
+
+    // Rows of the next table never go into the pending INSERT of the previous one
+    beginTable("other");
+    exportRows(5, 5);
+    QVERIFY(plugin->afterExportTable());
+
+    QStringList expected = {
+        "INSERT INTO test (id, val) VALUES (1, 'v1'), (2, 'v2'), (3, 'v3');",
+        "INSERT INTO test (id, val) VALUES (4, 'v4');",
+        "INSERT INTO other (id, val) VALUES (5, 'v5');"
+    };
+    QCOMPARE(finishExport(), expected);
+}
+
+void SqlExportTest::testNoEmptyInsertAfterFullGroup()
+{
+    setRowsPerInsert(2);
+    beginTable("test");
+    exportRows(1, 2);
+    QVERIFY(plugin->afterExportTable());
+
+    QStringList expected = {
+        "INSERT INTO test (id, val) VALUES (1, 'v1'), (2, 'v2');"
+    };
+    QCOMPARE(finishExport(), expected);
+}
+
+void SqlExportTest::testParallelReadingSameAsSequential()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    DbSqlite3Mock fileDb("filedb", dir.filePath("test.db"));
+    QVERIFY(fileDb.open());
+    QCOMPARE(fileDb.exec("PRAGMA journal_mode = WAL;")->getSingleCell().toString(), QString("wal"));
+
+    QStringList objects = createTables(&fileDb);
+    QCOMPARE(objects.size(), TABLES * 2);
+
+    // Connection holding the write lock and at least one table reader
+    StatsSqlExport parallelPlugin;
+    QString parallelOutput = exportDatabase(&fileDb, objects, &parallelPlugin);
+    QVERIFY(!parallelOutput.isEmpty());
+    QVERIFY(dbPlugin->instances > 1);
+
+    // Table readers need WAL mode, otherwise the connection of the export reads tables one after another
+    QCOMPARE(fileDb.exec("PRAGMA journal_mode = DELETE;")->getSingleCell().toString(), QString("delete"));
+    dbPlugin->instances = 0;
+
+    StatsSqlExport sequentialPlugin;
+    QString sequentialOutput = exportDatabase(&fileDb, objects, &sequentialPlugin);
+    QVERIFY(!sequentialOutput.isEmpty());
+    QVERIFY(dbPlugin->instances == 1);
+
+    QCOMPARE(parallelOutput, sequentialOutput);
+    QCOMPARE(parallelOutput.count("CREATE INDEX"), TABLES);
+
+    // Statistics are read along with the data
+    QList<int> expectedLengths = {QString::number(ROWS_PER_TABLE).length(), QString("t0-%1").arg(ROWS_PER_TABLE).length()};
+    for (int t = 0; t < TABLES; t++)
+    {
+        QString table = QString("t%1").arg(t);
+        QVERIFY(parallelOutput.contains(QString("'%1-%2'").arg(table).arg(ROWS_PER_TABLE)));
+        QCOMPARE(parallelPlugin.rowCounts.value(table), ROWS_PER_TABLE);
+        QCOMPARE(sequentialPlugin.rowCounts.value(table), ROWS_PER_TABLE);
+        QCOMPARE(parallelPlugin.dataLengths.value(table), expectedLengths);
+        QCOMPARE(sequentialPlugin.dataLengths.value(table), expectedLengths);
+    }
+
+    fileDb.close();
+}
+
+void SqlExportTest::testSnapshotNotAffectedByWrites()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    DbSqlite3Mock fileDb("filedb", dir.filePath("test.db"));
+    QVERIFY(fileDb.open());
+    QCOMPARE(fileDb.exec("PRAGMA journal_mode = WAL;")->getSingleCell().toString(), QString("wal"));
+    QCOMPARE(createTables(&fileDb).size(), TABLES * 2);
+
+    DbSqlite3Mock writerDb("writerdb", dir.filePath("test.db"));
+    QVERIFY(writerDb.open());
+
+    WritingSqlExport exportPlugin;
+    exportPlugin.writer = &writerDb;
+    config.consistentSnapshot = true;
+    QString output = exportTable(&fileDb, "t0", &exportPlugin);
+    QVERIFY(!output.isEmpty());
+    QVERIFY(exportPlugin.written);
+    QVERIFY(dbPlugin->instances == 1);
+
+    // Changes were committed, but the data and indexes (read after all the data) are from the beginning of the export
+    QCOMPARE(fileDb.exec("SELECT count(*) FROM t0 WHERE val = 'changed';")->getSingleCell().toInt(), ROWS_PER_TABLE + 1);
+    QVERIFY(output.contains(QString("'t0-%1'").arg(ROWS_PER_TABLE)));
+    QVERIFY(!output.contains("'new'"));
+    QVERIFY(!output.contains("'changed'"));
+    QVERIFY(output.contains("idx_t0"));
+    QVERIFY(!output.contains("idx_new"));
+
+    writerDb.close();
+    fileDb.close();
+}
+
+void SqlExportTest::initTestCase()
+{
+    initKeywords();
+    Lexer::staticInit();
+}
+
+void SqlExportTest::init()
+{
+    initMocks();
+
+    dbPlugin = new TestDbPlugin();
+    dbPluginType = new TestDbPluginType();
+
+    ExportPluginManagerMock* pluginManager = new ExportPluginManagerMock();
+    pluginManager->type = dbPluginType;
+    pluginManager->plugin = dbPlugin;
+    SQLITESTUDIO->setPluginManager(pluginManager);
+
+    db = new DbSqlite3Mock("testdb");
+    db->open();
+
+    output = new QBuffer();
+    output->open(QIODevice::WriteOnly);
+    config = ExportManager::StandardExportConfig();
+    config.codec = "UTF-8";
+
+    plugin = new SqlExport();
+    plugin->setExportMode(ExportManager::DATABASE);
+    QVERIFY(plugin->initBeforeExport(db, output, config));
+}
+
+void SqlExportTest::cleanup()
+{
+    delete plugin;
+    plugin = nullptr;
+    delete output;
+    output = nullptr;
+    db->close();
+    delete db;
+    db = nullptr;
+    delete dbPluginType;
+    dbPluginType = nullptr;
+    delete dbPlugin;
+    dbPlugin = nullptr;
+}
+
+QTEST_GUILESS_MAIN(SqlExportTest)
+
+#include "tst_sqlexporttest.moc"
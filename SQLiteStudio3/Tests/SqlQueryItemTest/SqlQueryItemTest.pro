@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Data grid item tests
+#
+#-------------------------------------------------
+
+include($$PWD/../TestUtils/test_common.pri)
+
+QT       += testlib widgets
+
+LIBS += -lguiSQLiteStudio
+
+TARGET = tst_sqlqueryitemtest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += \
+        tst_sqlqueryitemtest.cpp
@@ -0,0 +1,104 @@
+#include "datagrid/sqlqueryitem.h"
+#include "datagrid/sqlquerymodel.h"
+#include <QString>
+#include <QtTest>
+#include <type_traits>
+
+class SqlQueryItemTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        SqlQueryItemTest();
+
+    private Q_SLOTS:
+        void testNotAQObject();
+        void testLoadedValueNotUncommitted();
+        void testEditAndRollback();
+        void testNullToEmptyIsEdit();
+        void testDisplayValueLimited();
+        void testCloneKeepsState();
+};
+
+SqlQueryItemTest::SqlQueryItemTest()
+{
+}
+
+void SqlQueryItemTest::testNotAQObject()
+{
+    // One item is created per cell, so it must stay lightweight
+    QVERIFY(!(std::is_base_of<QObject, SqlQueryItem>::value));
+}
+
+void SqlQueryItemTest::testLoadedValueNotUncommitted()
+{
+    SqlQueryItem item;
+    item.setValue("abc", false, true);
+    QCOMPARE(item.getValue(), QVariant("abc"));
+    QVERIFY(!item.isUncommitted());
+    QVERIFY(!item.getOldValue().isValid());
+}
+
+void SqlQueryItemTest::testEditAndRollback()
+{
+    SqlQueryItem item;
+    item.setValue("abc", false, true);
+
+    item.setValue("def");
+    QVERIFY(item.isUncommitted());
+    QCOMPARE(item.getOldValue(), QVariant("abc"));
+
+    // The first original value is kept across subsequent edits
+    item.setValue("ghi");
+    QVERIFY(item.isUncommitted());
+    QCOMPARE(item.getOldValue(), QVariant("abc"));
+
+    item.rollback();
+    QCOMPARE(item.getValue(), QVariant("abc"));
+    QVERIFY(!item.isUncommitted());
+    QVERIFY(!item.getOldValue().isValid());
+}
+
+void SqlQueryItemTest::testNullToEmptyIsEdit()
+{
+    SqlQueryItem item;
+    item.setValue(QVariant(QVariant::String), false, true);
+    QVERIFY(item.getValue().isNull());
+
+    item.setValue(QString(""));
+    QVERIFY(item.isUncommitted());
+    QVERIFY(!item.getValue().isNull());
+}
+
+void SqlQueryItemTest::testDisplayValueLimited()
+{
+    int limit = SqlQueryModel::getCellDataLengthLimit();
+    QString longValue = QString("x").repeated(limit * 2);
+
+    SqlQueryItem item;
+    item.setValue(longValue, false, true);
+    QCOMPARE(item.getValue().toString().size(), limit * 2);
+    QCOMPARE(item.getValueForDisplay().toString().size(), limit);
+}
+
+void SqlQueryItemTest::testCloneKeepsState()
+{
+    RowId rowId;
+    rowId["ROWID"] = 5;
+
+    SqlQueryItem item;
+    item.setRowId(rowId);
+    item.setValue("abc", false, true);
+    item.setValue("def");
+
+    QScopedPointer<SqlQueryItem> clone(dynamic_cast<SqlQueryItem*>(item.clone()));
+    QVERIFY(clone);
+    QCOMPARE(clone->getValue(), QVariant("def"));
+    QCOMPARE(clone->getOldValue(), QVariant("abc"));
+    QVERIFY(clone->isUncommitted());
+    QCOMPARE(clone->getRowId(), rowId);
+}
+
+QTEST_APPLESS_MAIN(SqlQueryItemTest)
+
+#include "tst_sqlqueryitemtest.moc"
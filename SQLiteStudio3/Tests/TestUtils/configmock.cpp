@@ -80,6 +80,17 @@ Config::CfgDbPtr ConfigMock::getDb(const QString&)
     return Config::CfgDbPtr();
 }
 
+QString ConfigMock::getDbProbeResult(const QString&, qint64& modified, qint64& size)
+{
+    modified = -1;
+    size = -1;
+    return QString();
+}
+
+void ConfigMock::storeDbProbeResult(const QString&, qint64, qint64, const QString&)
+{
+}
+
 void ConfigMock::storeGroups(const QList<Config::DbGroupPtr>&)
 {
 }
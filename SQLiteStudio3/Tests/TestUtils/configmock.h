@@ -25,6 +25,8 @@ class ConfigMock : public Config
         QString getLastErrorString() const;
         QList<CfgDbPtr> dbList();
         CfgDbPtr getDb(const QString&);
+        QString getDbProbeResult(const QString&, qint64& modified, qint64& size);
+        void storeDbProbeResult(const QString&, qint64, qint64, const QString&);
         void storeGroups(const QList<DbGroupPtr>&);
         QList<DbGroupPtr> getGroups();
         DbGroupPtr getDbGroup(const QString&);
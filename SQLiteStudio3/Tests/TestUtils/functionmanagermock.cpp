@@ -19,7 +19,7 @@ QList<FunctionManager::NativeFunction *> FunctionManagerMock::getAllNativeFuncti
     return QList<FunctionManager::NativeFunction*>();
 }
 
-QVariant FunctionManagerMock::evaluateScalar(const QString&, int, const QList<QVariant>&, Db*, bool&)
+QVariant FunctionManagerMock::evaluateScalar(const QString&, int, const QList<QVariant>&, Db*, bool&, ArgumentCache*)
 {
     return QVariant();
 }
@@ -12,7 +12,7 @@ class FunctionManagerMock : public FunctionManager
         QList<ScriptFunction*> getAllScriptFunctions() const;
         QList<ScriptFunction*> getScriptFunctionsForDatabase(const QString&) const;
         QList<NativeFunction*> getAllNativeFunctions() const;
-        QVariant evaluateScalar(const QString&, int, const QList<QVariant>&, Db*, bool&);
+        QVariant evaluateScalar(const QString&, int, const QList<QVariant>&, Db*, bool&, ArgumentCache*);
         void evaluateAggregateInitial(const QString&, int, Db*, QHash<QString, QVariant>&);
         void evaluateAggregateStep(const QString&, int, const QList<QVariant>&, Db*, QHash<QString, QVariant>&);
         QVariant evaluateAggregateFinal(const QString&, int, Db*, bool&, QHash<QString, QVariant>&);
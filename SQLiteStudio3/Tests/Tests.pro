@@ -29,6 +29,45 @@ utils_test.depends = test_utils
 lexer_test.subdir = LexerTest
 lexer_test.depends = test_utils
 
+lexer_benchmark.subdir = LexerBenchmark
+lexer_benchmark.depends = test_utils
+
+db_sqlite3.subdir = DbSqlite3Test
+db_sqlite3.depends = test_utils
+
+import_test.subdir = ImportTest
+import_test.depends = test_utils
+
+schema_catalog.subdir = SchemaCatalogTest
+schema_catalog.depends = test_utils
+
+db_manager.subdir = DbManagerTest
+db_manager.depends = test_utils
+
+sql_export.subdir = SqlExportTest
+sql_export.depends = test_utils
+
+export_output_writer.subdir = ExportOutputWriterTest
+export_output_writer.depends = test_utils
+
+populate.subdir = PopulateTest
+populate.depends = test_utils
+
+parser_benchmark.subdir = ParserBenchmark
+parser_benchmark.depends = test_utils
+
+query_executor.subdir = QueryExecutorTest
+query_executor.depends = test_utils
+
+sql_query_item.subdir = SqlQueryItemTest
+sql_query_item.depends = test_utils
+
+db_tree_model.subdir = DbTreeModelTest
+db_tree_model.depends = test_utils
+
+scripting_qt.subdir = ScriptingQtTest
+scripting_qt.depends = test_utils
+
 SUBDIRS += \
     test_utils \
     completion_helper \
@@ -39,4 +78,17 @@ SUBDIRS += \
     db_ver_conv \
     dsv \
     utils_test \
-    lexer_test
+    lexer_test \
+    lexer_benchmark \
+    db_sqlite3 \
+    import_test \
+    schema_catalog \
+    db_manager \
+    sql_export \
+    export_output_writer \
+    populate \
+    parser_benchmark \
+    query_executor \
+    sql_query_item \
+    db_tree_model \
+    scripting_qt
@@ -15,6 +15,7 @@ private Q_SLOTS:
     void testRemoveComments();
     void testRemoveCommentsAndEmpties();
     void testDoubleToString();
+    void testAppendValueAsSql();
 };
 
 UtilsSqlTest::UtilsSqlTest()
@@ -81,6 +82,19 @@ void UtilsSqlTest::testDoubleToString()
     QVERIFY(doubleToString(QVariant(0.1 + 0.1 + 0.1)) == "0.3");
 }
 
+void UtilsSqlTest::testAppendValueAsSql()
+{
+    QString sql = "VALUES (";
+    QVariantList values = {QVariant(), 5, 1.5, true, QByteArray("\x01\xab"), "it's"};
+    for (const QVariant& value : values)
+    {
+        appendValueAsSql(sql, value, Dialect::Sqlite3);
+        sql += ", ";
+    }
+    QCOMPARE(sql, QString("VALUES (NULL, 5, 1.5, 1, X'01AB', 'it''s', "));
+    QCOMPARE(valueListToSqlList(values, Dialect::Sqlite3).join(", "), QString("NULL, 5, 1.5, 1, X'01AB', 'it''s'"));
+}
+
 QTEST_APPLESS_MAIN(UtilsSqlTest)
 
 #include "tst_utilssqltest.moc"
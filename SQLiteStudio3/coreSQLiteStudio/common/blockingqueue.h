@@ -0,0 +1,111 @@
+#ifndef BLOCKINGQUEUE_H
+#define BLOCKINGQUEUE_H
+
+#include <QVector>
+#include <QMutex>
+#include <QWaitCondition>
+
+/**
+ * @brief Bounded queue for passing data from one thread to another.
+ *
+ * Items are kept in a ring buffer of fixed capacity. The producer thread calls push(),
+ * which blocks while the queue is full, so the producer cannot get too far ahead of the consumer.
+ * The consumer thread calls pop(), which blocks while the queue is empty.
+ *
+ * Once the producer has no more data, it calls finish(). The consumer receives remaining items
+ * and then pop() returns false. If any of the sides needs to stop early (error, interruption),
+ * it calls abort(), which wakes up both sides and makes all further push() and pop() calls return false.
+ *
+ * The queue is synchronized with a mutex, so each item should carry a reasonable amount of data
+ * (like a block of rows), rather than a single value.
+ */
+template <class T>
+class BlockingQueue
+{
+    public:
+        explicit BlockingQueue(int capacity);
+
+        bool push(const T& item);
+        bool pop(T& item);
+        void finish();
+        void abort();
+        bool isAborted();
+
+    private:
+        QVector<T> ring;
+        int head = 0;
+        int count = 0;
+        bool finished = false;
+        bool aborted = false;
+        QMutex mutex;
+        QWaitCondition notEmpty;
+        QWaitCondition notFull;
+};
+
+template <class T>
+BlockingQueue<T>::BlockingQueue(int capacity) :
+    ring(capacity)
+{
+    Q_ASSERT(capacity > 0);
+}
+
+template <class T>
+bool BlockingQueue<T>::push(const T& item)
+{
+    QMutexLocker locker(&mutex);
+    while (count == ring.size() && !aborted)
+        notFull.wait(&mutex);
+
+    if (aborted || finished)
+        return false;
+
+    ring[(head + count) % ring.size()] = item;
+    count++;
+    notEmpty.wakeOne();
+    return true;
+}
+
+template <class T>
+bool BlockingQueue<T>::pop(T& item)
+{
+    QMutexLocker locker(&mutex);
+    while (count == 0 && !finished && !aborted)
+        notEmpty.wait(&mutex);
+
+    if (aborted || count == 0)
+        return false;
+
+    // Item is moved out of the ring, so its data is not kept alive until the slot is reused
+    item = ring[head];
+    ring[head] = T();
+    head = (head + 1) % ring.size();
+    count--;
+    notFull.wakeOne();
+    return true;
+}
+
+template <class T>
+void BlockingQueue<T>::finish()
+{
+    QMutexLocker locker(&mutex);
+    finished = true;
+    notEmpty.wakeAll();
+}
+
+template <class T>
+void BlockingQueue<T>::abort()
+{
+    QMutexLocker locker(&mutex);
+    aborted = true;
+    notEmpty.wakeAll();
+    notFull.wakeAll();
+}
+
+template <class T>
+bool BlockingQueue<T>::isAborted()
+{
+    QMutexLocker locker(&mutex);
+    return aborted;
+}
+
+#endif // BLOCKINGQUEUE_H
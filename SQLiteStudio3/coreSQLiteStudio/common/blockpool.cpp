@@ -0,0 +1,104 @@
+#include "blockpool.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadStorage>
+#include <new>
+
+static QBasicMutex sharedFreeListsMutex;
+
+BlockPool::FreeBlock* BlockPool::sharedHeads[BlockPool::SizeClasses] = {};
+
+void* BlockPool::allocate(std::size_t size)
+{
+    if (size == 0 || size > MaxBlockSize)
+        return ::operator new(size);
+
+    std::size_t sizeClass = (size - 1) / Granularity;
+    FreeLists* lists = getThreadFreeLists();
+    FreeBlock* block = lists->heads[sizeClass];
+    if (!block)
+        block = takeBlocks(sizeClass);
+
+    lists->heads[sizeClass] = block->next;
+    return block;
+}
+
+void BlockPool::deallocate(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (size == 0 || size > MaxBlockSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    std::size_t sizeClass = (size - 1) / Granularity;
+    FreeLists* lists = getThreadFreeLists();
+    FreeBlock* block = new (ptr) FreeBlock();
+    block->next = lists->heads[sizeClass];
+    lists->heads[sizeClass] = block;
+}
+
+BlockPool::FreeLists* BlockPool::getThreadFreeLists()
+{
+    // Never deleted, so threads finishing during the static destruction still hand over their free lists
+    static QThreadStorage<FreeLists*>* threadFreeLists = new QThreadStorage<FreeLists*>();
+
+    FreeLists* lists = threadFreeLists->localData();
+    if (!lists)
+    {
+        lists = new FreeLists();
+        threadFreeLists->setLocalData(lists);
+    }
+    return lists;
+}
+
+BlockPool::FreeBlock* BlockPool::takeBlocks(std::size_t sizeClass)
+{
+    {
+        QMutexLocker locker(&sharedFreeListsMutex);
+        FreeBlock* blocks = sharedHeads[sizeClass];
+        if (blocks)
+        {
+            sharedHeads[sizeClass] = nullptr;
+            return blocks;
+        }
+    }
+
+    return createBlocks(sizeClass);
+}
+
+BlockPool::FreeBlock* BlockPool::createBlocks(std::size_t sizeClass)
+{
+    std::size_t blockSize = (sizeClass + 1) * Granularity;
+    std::size_t blockCount = ChunkSize / blockSize;
+    char* chunk = static_cast<char*>(::operator new(blockCount * blockSize));
+
+    FreeBlock* head = nullptr;
+    for (std::size_t i = blockCount; i > 0; i--)
+    {
+        FreeBlock* block = new (chunk + (i - 1) * blockSize) FreeBlock();
+        block->next = head;
+        head = block;
+    }
+    return head;
+}
+
+BlockPool::FreeLists::~FreeLists()
+{
+    QMutexLocker locker(&sharedFreeListsMutex);
+    for (std::size_t sizeClass = 0; sizeClass < SizeClasses; sizeClass++)
+    {
+        if (!heads[sizeClass])
+            continue;
+
+        FreeBlock* last = heads[sizeClass];
+        while (last->next)
+            last = last->next;
+
+        last->next = sharedHeads[sizeClass];
+        sharedHeads[sizeClass] = heads[sizeClass];
+    }
+}
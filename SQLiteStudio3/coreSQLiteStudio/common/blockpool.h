@@ -0,0 +1,78 @@
+#ifndef BLOCKPOOL_H
+#define BLOCKPOOL_H
+
+#include "coreSQLiteStudio_global.h"
+#include <cstddef>
+
+/**
+ * @brief Allocator of small memory blocks for objects created and deleted in big numbers.
+ *
+ * Block sizes are rounded up to the Granularity and blocks of the same size are carved out of bigger chunks,
+ * so creating an object takes no separate heap allocation and no per-object heap bookkeeping.
+ * Blocks are aligned to the Granularity, which is enough for objects without over-aligned members.
+ * Freed blocks go to a free list of the thread that frees them and they are reused by the next allocation
+ * of the same size in that thread. Free lists of a finished thread are handed over to other threads.
+ *
+ * Chunks are never given back to the system, so the pool keeps as much memory as it needed
+ * when the most objects were alive at the same time. Blocks bigger than MaxBlockSize are allocated
+ * directly from the heap.
+ *
+ * A class uses the pool for itself and all its subclasses by putting DECLARE_BLOCK_POOL_ALLOCATION
+ * into its declaration. Objects deleted through a base class pointer need a virtual destructor,
+ * so the pool gets the size of the actual object.
+ */
+class API_EXPORT BlockPool
+{
+    public:
+        static void* allocate(std::size_t size);
+        static void deallocate(void* ptr, std::size_t size);
+
+        static const constexpr std::size_t Granularity = 8;
+        static const constexpr std::size_t MaxBlockSize = 512;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next = nullptr;
+        };
+
+        static const constexpr std::size_t SizeClasses = MaxBlockSize / Granularity;
+        static const constexpr std::size_t ChunkSize = 32 * 1024;
+
+        class FreeLists
+        {
+            public:
+                ~FreeLists();
+
+                FreeBlock* heads[SizeClasses] = {};
+        };
+
+        static FreeLists* getThreadFreeLists();
+        static FreeBlock* takeBlocks(std::size_t sizeClass);
+        static FreeBlock* createBlocks(std::size_t sizeClass);
+
+        /**
+         * @brief Free lists handed over by finished threads, guarded by a mutex.
+         */
+        static FreeBlock* sharedHeads[SizeClasses];
+};
+
+#define DECLARE_BLOCK_POOL_ALLOCATION \
+    public: \
+        static void* operator new(std::size_t size) \
+        { \
+            return BlockPool::allocate(size); \
+        } \
+        static void* operator new(std::size_t, void* place) \
+        { \
+            return place; \
+        } \
+        static void operator delete(void* ptr, std::size_t size) \
+        { \
+            BlockPool::deallocate(ptr, size); \
+        } \
+        static void operator delete(void*, void*) \
+        { \
+        }
+
+#endif // BLOCKPOOL_H
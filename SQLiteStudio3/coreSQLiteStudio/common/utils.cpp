@@ -13,6 +13,7 @@
 #include <QDir>
 #include <QByteArray>
 #include <QDataStream>
+#include <QAtomicInt>
 
 #ifdef Q_OS_LINUX
 #include <sys/utsname.h>
@@ -109,6 +110,25 @@ QString randBinStr(int length)
     return QString::fromLatin1(output, length);
 }
 
+uint randomSeed()
+{
+    static QAtomicInt counter;
+    uint seq = static_cast<uint>(counter.fetchAndAddRelaxed(1));
+    return static_cast<uint>(QDateTime::currentMSecsSinceEpoch()) ^ (seq * 2654435761u);
+}
+
+uint deriveSeed(uint baseSeed, uint streamId)
+{
+    // Finalizer of the MurmurHash3, applied to the base seed combined with the stream
+    quint32 h = static_cast<quint32>(baseSeed) ^ (static_cast<quint32>(streamId) * 2654435761u);
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
 QString randStrNotIn(int length, const QSet<QString> set, bool numChars, bool whiteSpaces)
 {
     if (length == 0)
@@ -58,6 +58,26 @@ API_EXPORT int rand(int min = 0, int max = RAND_MAX);
 API_EXPORT QString randStr(int length, bool numChars = true, bool whiteSpaces = false);
 API_EXPORT QString randStr(int length, const QString& charCollection);
 API_EXPORT QString randBinStr(int length);
+
+/**
+ * @brief Provides seed for a random number generator.
+ * @return Seed based on current time.
+ *
+ * Each call returns a different seed, even if many generators are seeded at the same moment,
+ * so their sequences don't repeat each other.
+ */
+API_EXPORT uint randomSeed();
+
+/**
+ * @brief Derives seed for one of many random number generators from a common seed.
+ * @param baseSeed Common seed.
+ * @param streamId Identifies the generator, for example by hash of the column it generates values for.
+ * @return Seed for the generator.
+ *
+ * For the same arguments it always returns the same seed, so all generators can be reproduced from the base seed only,
+ * while seeds for different generators are well mixed, so their sequences don't repeat each other.
+ */
+API_EXPORT uint deriveSeed(uint baseSeed, uint streamId);
 API_EXPORT QString randStrNotIn(int length, const QSet<QString> set, bool numChars = true, bool whiteSpaces = false);
 API_EXPORT QString generateUniqueName(const QString& prefix, const QStringList& existingNames, Qt::CaseSensitivity cs = Qt::CaseSensitive);
 API_EXPORT bool isNumeric(const QVariant& value);
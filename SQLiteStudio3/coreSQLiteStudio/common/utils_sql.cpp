@@ -414,7 +414,12 @@ QList<TokenList> splitQueries(const TokenList& tokenizedQuery, bool* complete)
     bool completeQuery = false;
     for (const TokenPtr& token : tokenizedQuery)
     {
-        value = token->value.toUpper();
+        // Only keywords are compared case insensitively. No need to convert huge strings or comments.
+        if (token->type == Token::KEYWORD)
+            value = token->value.toUpper();
+        else
+            value = token->value;
+
         if (!token->isWhitespace())
             completeQuery = false;
 
@@ -726,13 +731,18 @@ QueryAccessMode getQueryAccessMode(const QString& query, Dialect dialect, bool*
     if (isSelect)
         *isSelect = false;
 
-    TokenList tokens = Lexer::tokenize(query, dialect);
-    int keywordIdx = tokens.indexOf(Token::KEYWORD);
-    if (keywordIdx < 0)
+    // Query is tokenized lazily, as usually only tokens up to the first keyword are needed.
+    Lexer lexer(dialect);
+    lexer.prepare(query);
+    TokenPtr token;
+    while ((token = lexer.getToken()) && token->type != Token::KEYWORD) {}
+
+    if (!token)
         return QueryAccessMode::WRITE;
 
-    int cmdIdx = readOnlyCommands.indexOf(tokens[keywordIdx]->value.toUpper());
-    if (keywordIdx > -1 && cmdIdx > -1)
+    QString firstKeyword = token->value.toUpper();
+    int cmdIdx = readOnlyCommands.indexOf(firstKeyword);
+    if (cmdIdx > -1)
     {
         if (cmdIdx == 3 && isSelect)
             *isSelect = true;
@@ -740,12 +750,12 @@ QueryAccessMode getQueryAccessMode(const QString& query, Dialect dialect, bool*
         return QueryAccessMode::READ;
     }
 
-    if (keywordIdx > -1 && tokens[keywordIdx]->value.toUpper() == "WITH")
+    if (firstKeyword == "WITH")
     {
         bool matched = false;
         bool queryIsSelect = false;
         int depth = 0;
-        for (TokenPtr token : tokens)
+        while (!matched && (token = lexer.getToken()))
         {
             switch (token->type)
             {
@@ -773,9 +783,6 @@ QueryAccessMode getQueryAccessMode(const QString& query, Dialect dialect, bool*
                 default:
                     break;
             }
-
-            if (matched)
-                break;
         }
 
         if (queryIsSelect)
@@ -795,40 +802,58 @@ QStringList valueListToSqlList(const QVariantList& values, Dialect dialect)
     QStringList argList;
     for (const QVariant& value : values)
     {
-        if (!value.isValid() || value.isNull())
-        {
-            argList << "NULL";
-            continue;
-        }
+        QString arg;
+        appendValueAsSql(arg, value, dialect);
+        argList << arg;
+    }
+    return argList;
+}
+
+void appendValueAsSql(QString& sql, const QVariant& value, Dialect dialect)
+{
+    if (!value.isValid() || value.isNull())
+    {
+        sql += "NULL";
+        return;
+    }
 
-        switch (value.userType())
+    switch (value.userType())
+    {
+        case QVariant::Int:
+        case QVariant::UInt:
+        case QVariant::LongLong:
+        case QVariant::ULongLong:
+            sql += value.toString();
+            break;
+        case QVariant::Double:
+            sql += doubleToString(value);
+            break;
+        case QVariant::Bool:
+            sql += QString::number(value.toInt());
+            break;
+        case QVariant::ByteArray:
         {
-            case QVariant::Int:
-            case QVariant::UInt:
-            case QVariant::LongLong:
-            case QVariant::ULongLong:
-                argList << value.toString();
-                break;
-            case QVariant::Double:
-                argList << doubleToString(value);
-                break;
-            case QVariant::Bool:
-                argList << QString::number(value.toInt());
-                break;
-            case QVariant::ByteArray:
+            if (dialect == Dialect::Sqlite3) // version 2 will go to the regular string processing
             {
-                if (dialect == Dialect::Sqlite3) // version 2 will go to the regular string processing
-                {
-                    argList << "X'" + value.toByteArray().toHex().toUpper() + "'";
-                    break;
-                }
-            }
-            default:
-                argList << wrapString(escapeString(value.toString()));
+                sql += "X'";
+                sql += QString::fromLatin1(value.toByteArray().toHex().toUpper());
+                sql += "'";
                 break;
+            }
+        }
+        default:
+        {
+            QString str = value.toString();
+            sql += "'";
+            if (str.contains('\''))
+                sql += escapeString(str);
+            else
+                sql += str;
+
+            sql += "'";
+            break;
         }
     }
-    return argList;
 }
 
 QStringList wrapStrings(const QStringList& strList)
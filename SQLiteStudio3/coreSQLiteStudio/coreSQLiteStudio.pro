@@ -122,6 +122,7 @@ SOURCES += sqlitestudio.cpp \
     parser/parsererror.cpp \
     selectresolver.cpp \
     schemaresolver.cpp \
+    schemacatalog.cpp \
     parser/ast/sqlitequerytype.cpp \
     db/db.cpp \
     services/dbmanager.cpp \
@@ -183,6 +184,7 @@ SOURCES += sqlitestudio.cpp \
     services/impl/collationmanagerimpl.cpp \
     services/exportmanager.cpp \
     exportworker.cpp \
+    exportoutputwriter.cpp \
     plugins/scriptingsql.cpp \
     db/queryexecutorsteps/queryexecutordetectschemaalter.cpp \
     querymodel.cpp \
@@ -232,6 +234,7 @@ SOURCES += sqlitestudio.cpp \
     common/xmldeserializer.cpp \
     services/impl/sqliteextensionmanagerimpl.cpp \
     common/lazytrigger.cpp \
+    common/blockpool.cpp \
     parser/ast/sqliteupsert.cpp
 
 HEADERS += sqlitestudio.h\
@@ -292,8 +295,10 @@ HEADERS += sqlitestudio.h\
     parser/ast/sqliteattach.h \
     parser/parsererror.h \
     common/objectpool.h \
+    common/blockingqueue.h \
     selectresolver.h \
     schemaresolver.h \
+    schemacatalog.h \
     dialect.h \
     db/db.h \
     services/dbmanager.h \
@@ -373,6 +378,7 @@ HEADERS += sqlitestudio.h\
     config_builder.h \
     services/exportmanager.h \
     exportworker.h \
+    exportoutputwriter.h \
     plugins/scriptingsql.h \
     db/queryexecutorsteps/queryexecutordetectschemaalter.h \
     querymodel.h \
@@ -434,6 +440,7 @@ HEADERS += sqlitestudio.h\
     services/sqliteextensionmanager.h \
     services/impl/sqliteextensionmanagerimpl.h \
     common/lazytrigger.h \
+    common/blockpool.h \
     parser/ast/sqliteupsert.h
 
 unix: {
@@ -1,186 +1,334 @@
 #include "csvserializer.h"
 #include <QStringList>
 #include <QList>
+#include <QVector>
 #include <QDebug>
-#include <QTime>
 
-template <class C>
-bool isCsvSeparator(QList<C>& ahead, const C& theChar, const QStringList& separators)
+inline ushort csvCharCode(QChar c)
 {
-    for (const QString& sep : separators)
-        if (isCsvSeparator(ahead, theChar, sep))
-            return true;
+    return c.unicode();
+}
 
-    return false;
+inline ushort csvCharCode(char c)
+{
+    return static_cast<uchar>(c);
 }
 
-template <class C>
-bool isCsvSeparator(QList<C>& ahead, const C& theChar, const QString& singleSeparator)
+inline void csvSeparatorFromString(const QString& str, QString& separator)
 {
-    if (singleSeparator[0] != theChar)
-        return false;
+    separator = str;
+}
 
-    typename QList<C>::const_iterator aheadIter = ahead.begin();
-    int singleSeparatorSize = singleSeparator.size();
-    int i = 1;
-    while (aheadIter != ahead.end() && i < singleSeparatorSize)
-    {
-        if (singleSeparator[i++] != *aheadIter++)
-            return false;
-    }
+inline void csvSeparatorFromString(const QString& str, QByteArray& separator)
+{
+    separator = str.toLatin1();
+}
 
-    if (i < singleSeparatorSize)
-        return false;
+/**
+ * @brief CSV parsing engine.
+ *
+ * Parses entries directly from a buffer of characters. Characters that cannot start a separator
+ * and are not quotes are skipped with a tight loop and copied to the cell as a whole span,
+ * instead of being tested and appended one by one.
+ *
+ * Parsing can be resumed. If the end of the buffer is reached before the entry is complete,
+ * the parse() returns NEED_MORE and can be called again once more data was appended to the buffer.
+ */
+template <class T, class C>
+class CsvParser
+{
+    public:
+        enum class Result
+        {
+            ROW_END, /**< Row separator was found. */
+            DATA_END, /**< The data has ended. Cells contain the last entry (if any). */
+            NEED_MORE /**< The entry is not complete and more data is needed. */
+        };
 
-    for (int i = 1, total = singleSeparator.size(); i < total; ++i)
-        ahead.removeFirst();
+        explicit CsvParser(const CsvFormat& format);
 
-    return true;
-}
+        Result parse(const C* data, int size, int& pos, bool final);
+        QList<T> takeCells();
+        void reset();
+
+    private:
+        enum class Separator
+        {
+            NONE,
+            COLUMN,
+            ROW,
+            NEED_MORE
+        };
+
+        static void addSeparators(const QString& separator, const QStringList& separators, bool strict, bool multiple, QList<T>& target);
+        static bool matches(const T& separator, const C* data, int size, int pos, bool final, bool& needMore);
 
-template <class C>
-bool isCsvColumnSeparator(QList<C>& ahead, const C& theChar, const CsvFormat& format)
+        Separator matchSeparator(const C* data, int size, int pos, bool final, int& length) const;
+        bool isSpecial(C theChar) const;
+
+        QList<T> columnSeparators;
+        QList<T> rowSeparators;
+        bool special[256];
+        QVector<ushort> specialOutOfLatin1;
+
+        QList<T> cells;
+        T field;
+        bool quotes = false;
+        bool sepAsLast = false;
+};
+
+template <class T, class C>
+CsvParser<T, C>::CsvParser(const CsvFormat& format)
 {
-    if (!format.strictColumnSeparator)
-        return format.columnSeparator.contains(theChar);
+    addSeparators(format.columnSeparator, format.columnSeparators, format.strictColumnSeparator, format.multipleColumnSeparators, columnSeparators);
+    addSeparators(format.rowSeparator, format.rowSeparators, format.strictRowSeparator, format.multipleRowSeparators, rowSeparators);
+
+    // Characters that interrupt the fast scanning: quote and anything that can start a separator
+    for (int i = 0; i < 256; i++)
+        special[i] = false;
 
-    // Strict checking (characters in defined order make a separator)
-    if (format.multipleColumnSeparators)
-        return isCsvSeparator(ahead, theChar, format.columnSeparators);
+    QList<ushort> specialCodes = {'"'};
+    for (const T& sep : columnSeparators + rowSeparators)
+        specialCodes << csvCharCode(sep[0]);
 
-    return isCsvSeparator(ahead, theChar, format.columnSeparator);
+    for (ushort code : specialCodes)
+    {
+        if (code < 256)
+            special[code] = true;
+        else if (!specialOutOfLatin1.contains(code))
+            specialOutOfLatin1 << code;
+    }
 }
 
-template <class C>
-bool isCsvRowSeparator(QList<C>& ahead, const C& theChar, const CsvFormat& format)
+template <class T, class C>
+void CsvParser<T, C>::addSeparators(const QString& separator, const QStringList& separators, bool strict, bool multiple, QList<T>& target)
 {
-    if (!format.strictRowSeparator)
-        return format.rowSeparator.contains(theChar);
+    T sep;
+    if (!strict)
+    {
+        // Every single character is a separator
+        for (const QChar& c : separator)
+        {
+            csvSeparatorFromString(QString(c), sep);
+            target << sep;
+        }
+        return;
+    }
 
-    // Strict checking (characters in defined order make a separator)
-    if (format.multipleRowSeparators)
-        return isCsvSeparator(ahead, theChar, format.rowSeparators);
+    // Characters in defined order make a separator
+    for (const QString& str : (multiple ? separators : QStringList({separator})))
+    {
+        if (str.isEmpty())
+            continue;
 
-    return isCsvSeparator(ahead, theChar, format.rowSeparator);
+        csvSeparatorFromString(str, sep);
+        target << sep;
+    }
 }
 
-template <class C>
-void readAhead(QTextStream& data, QList<C>& ahead, int desiredSize)
+template <class T, class C>
+bool CsvParser<T, C>::matches(const T& separator, const C* data, int size, int pos, bool final, bool& needMore)
 {
-    C singleValue;
-    while (!data.atEnd() && ahead.size() < desiredSize)
+    for (int i = 0, total = separator.size(); i < total; ++i)
     {
-        data >> singleValue;
-        ahead << singleValue;
+        if (pos + i >= size)
+        {
+            // Matches so far, but the rest of it is not in the buffer yet
+            needMore = !final;
+            return false;
+        }
+
+        if (csvCharCode(separator[i]) != csvCharCode(data[pos + i]))
+            return false;
     }
+    return true;
 }
 
 template <class T, class C>
-void typedDeserializeInternal(QTextStream& data, const CsvFormat& format, QList<T>* cells, QList<QList<T>>* rows)
+typename CsvParser<T, C>::Separator CsvParser<T, C>::matchSeparator(const C* data, int size, int pos, bool final, int& length) const
 {
-    bool quotes = false;
-    bool sepAsLast = false;
-    int separatorMaxAhead = qMax(format.maxColumnSeparatorLength, format.maxRowSeparatorLength) - 1;
-    T field = "";
-    field.reserve(3);
-    C theChar;
-    QList<C> ahead;
-
-    while (!data.atEnd() || !ahead.isEmpty())
+    bool needMore = false;
+    for (const T& sep : columnSeparators)
     {
-        if (!ahead.isEmpty())
-            theChar = ahead.takeFirst();
-        else
-            data >> theChar;
+        if (matches(sep, data, size, pos, final, needMore))
+        {
+            length = sep.size();
+            return Separator::COLUMN;
+        }
 
-        sepAsLast = false;
-        if (!quotes && theChar == '"' )
+        if (needMore)
+            return Separator::NEED_MORE;
+    }
+
+    for (const T& sep : rowSeparators)
+    {
+        if (matches(sep, data, size, pos, final, needMore))
         {
-            quotes = true;
+            length = sep.size();
+            return Separator::ROW;
         }
-        else if (quotes && theChar == '"' )
+
+        if (needMore)
+            return Separator::NEED_MORE;
+    }
+
+    return Separator::NONE;
+}
+
+template <class T, class C>
+bool CsvParser<T, C>::isSpecial(C theChar) const
+{
+    ushort code = csvCharCode(theChar);
+    if (code < 256)
+        return special[code];
+
+    return !specialOutOfLatin1.isEmpty() && specialOutOfLatin1.contains(code);
+}
+
+template <class T, class C>
+typename CsvParser<T, C>::Result CsvParser<T, C>::parse(const C* data, int size, int& pos, bool final)
+{
+    int start;
+    int sepLength;
+    while (pos < size)
+    {
+        if (quotes)
         {
-            if (!data.atEnd())
+            // Everything up to the next quote goes to the field
+            start = pos;
+            while (pos < size && csvCharCode(data[pos]) != '"')
+                pos++;
+
+            if (pos > start)
             {
-                readAhead(data, ahead, 1);
-                if (ahead.isEmpty())
-                {
-                    field += theChar;
-                }
-                else if (ahead.first() == '"' )
+                field.append(data + start, pos - start);
+                sepAsLast = false;
+            }
+
+            if (pos >= size)
+                break;
+
+            sepAsLast = false;
+            if (pos + 1 < size)
+            {
+                if (csvCharCode(data[pos + 1]) == '"')
                 {
-                   field += theChar;
-                   ahead.removeFirst();
+                    // Escaped quote
+                    field.append(data[pos]);
+                    pos += 2;
                 }
                 else
                 {
-                   quotes = false;
+                    quotes = false;
+                    pos++;
                 }
             }
+            else if (!final)
+            {
+                return Result::NEED_MORE;
+            }
             else
             {
-                if (field.length() == 0)
-                    *cells << field;
+                if (field.size() == 0)
+                    cells << field;
 
                 quotes = false;
+                pos++;
             }
+            continue;
+        }
+
+        // Everything up to the next quote or possible separator goes to the field
+        start = pos;
+        while (pos < size && !isSpecial(data[pos]))
+            pos++;
+
+        if (pos > start)
+        {
+            field.append(data + start, pos - start);
+            sepAsLast = false;
         }
-        else if (!quotes)
+
+        if (pos >= size)
+            break;
+
+        sepAsLast = false;
+        if (csvCharCode(data[pos]) == '"')
         {
-            readAhead(data, ahead, separatorMaxAhead);
-            if (isCsvColumnSeparator(ahead, theChar, format))
-            {
-                *cells << field;
+            quotes = true;
+            pos++;
+            continue;
+        }
+
+        switch (matchSeparator(data, size, pos, final, sepLength))
+        {
+            case Separator::NEED_MORE:
+                return Result::NEED_MORE;
+            case Separator::COLUMN:
+                cells << field;
                 field.truncate(0);
                 sepAsLast = true;
-            }
-            else if (isCsvRowSeparator(ahead, theChar, format))
-            {
-                *cells << field;
+                pos += sepLength;
+                break;
+            case Separator::ROW:
+                cells << field;
                 field.truncate(0);
-                if (rows)
-                {
-                    *rows << *cells;
-                    cells->clear();
-                }
-                else
-                {
-                    break;
-                }
-            }
-            else
-            {
-                field += theChar;
-            }
-        }
-        else
-        {
-            field += theChar;
+                pos += sepLength;
+                return Result::ROW_END;
+            case Separator::NONE:
+                field.append(data[pos]);
+                pos++;
+                break;
         }
     }
 
+    if (!final)
+        return Result::NEED_MORE;
+
     if (field.size() > 0 || sepAsLast)
-        *cells << field;
+        cells << field;
 
-    if (rows && cells->size() > 0)
-        *rows << *cells;
+    field.truncate(0);
+    quotes = false;
+    sepAsLast = false;
+    return Result::DATA_END;
 }
 
 template <class T, class C>
-QList<QList<T>> typedDeserialize(QTextStream& data, const CsvFormat& format)
+QList<T> CsvParser<T, C>::takeCells()
 {
-    QList<QList<T>> rows;
-    QList<T> cells;
-    typedDeserializeInternal<T, C>(data, format, &cells, &rows);
-    return rows;
+    QList<T> result;
+    qSwap(result, cells);
+    return result;
+}
+
+template <class T, class C>
+void CsvParser<T, C>::reset()
+{
+    cells.clear();
+    field.truncate(0);
+    quotes = false;
+    sepAsLast = false;
 }
 
 template <class T, class C>
-QList<T> typedDeserializeOneEntry(QTextStream& data, const CsvFormat& format)
+QList<QList<T>> typedDeserialize(const C* data, int size, const CsvFormat& format)
 {
+    CsvParser<T, C> parser(format);
+    QList<QList<T>> rows;
     QList<T> cells;
-    typedDeserializeInternal<T, C>(data, format, &cells, nullptr);
-    return cells;
+    int pos = 0;
+    typename CsvParser<T, C>::Result result;
+    do
+    {
+        result = parser.parse(data, size, pos, true);
+        cells = parser.takeCells();
+        if (result == CsvParser<T, C>::Result::ROW_END || cells.size() > 0)
+            rows << cells;
+    }
+    while (result == CsvParser<T, C>::Result::ROW_END);
+
+    return rows;
 }
 
 QString CsvSerializer::serialize(const QList<QStringList>& data, const CsvFormat& format)
@@ -217,31 +365,97 @@ QString CsvSerializer::serialize(const QStringList& data, const CsvFormat& forma
 
 QStringList CsvSerializer::deserializeOneEntry(QTextStream& data, const CsvFormat& format)
 {
-    QList<QString> deserialized = typedDeserializeOneEntry<QString, QChar>(data, format);
-    return QStringList(deserialized);
+    typedef CsvParser<QString, QChar> Parser;
+
+    Parser parser(format);
+    QString buffer;
+    int pos = 0;
+    QChar theChar;
+    while (!data.atEnd())
+    {
+        data >> theChar;
+        buffer += theChar;
+        if (parser.parse(buffer.constData(), buffer.size(), pos, false) == Parser::Result::ROW_END)
+            return QStringList(parser.takeCells());
+    }
+
+    parser.parse(buffer.constData(), buffer.size(), pos, true);
+    return QStringList(parser.takeCells());
 }
 
 QList<QList<QByteArray>> CsvSerializer::deserialize(const QByteArray& data, const CsvFormat& format)
 {
-    QTextStream stream(data, QIODevice::ReadWrite);
-    return typedDeserialize<QByteArray,char>(stream, format);
+    return typedDeserialize<QByteArray, char>(data.constData(), data.size(), format);
 }
 
 QList<QStringList> CsvSerializer::deserialize(QTextStream& data, const CsvFormat& format)
 {
-    QList<QList<QString>> deserialized = typedDeserialize<QString, QChar>(data, format);
+    QString dataString = data.readAll();
+    return deserialize(dataString, format);
+}
+
+QList<QStringList> CsvSerializer::deserialize(const QString& data, const CsvFormat& format)
+{
+    QList<QList<QString>> deserialized = typedDeserialize<QString, QChar>(data.constData(), data.size(), format);
 
     QList<QStringList> finalList;
+    finalList.reserve(deserialized.size());
     for (const QList<QString>& resPart : deserialized)
         finalList << QStringList(resPart);
 
     return finalList;
 }
 
-QList<QStringList> CsvSerializer::deserialize(const QString& data, const CsvFormat& format)
+CsvReader::CsvReader(QTextStream* stream, const CsvFormat& format) :
+    stream(stream)
+{
+    parser = new CsvParser<QString, QChar>(format);
+}
+
+CsvReader::~CsvReader()
 {
-    QString dataString = data;
-    QTextStream stream(&dataString, QIODevice::ReadWrite);
-    return deserialize(stream, format);
+    delete parser;
 }
 
+QStringList CsvReader::readEntry()
+{
+    typedef CsvParser<QString, QChar> Parser;
+
+    Parser::Result result = parser->parse(buffer.constData(), buffer.size(), bufferPos, stream->atEnd());
+    while (result == Parser::Result::NEED_MORE)
+    {
+        bool final = !readBlock() || stream->atEnd();
+        result = parser->parse(buffer.constData(), buffer.size(), bufferPos, final);
+    }
+
+    return QStringList(parser->takeCells());
+}
+
+bool CsvReader::atEnd() const
+{
+    return bufferPos >= buffer.size() && stream->atEnd();
+}
+
+void CsvReader::reset()
+{
+    buffer.clear();
+    bufferPos = 0;
+    parser->reset();
+}
+
+bool CsvReader::readBlock()
+{
+    // Data already parsed is not needed anymore. Parser keeps its own copy of the entry being parsed.
+    if (bufferPos > 0)
+    {
+        buffer.remove(0, bufferPos);
+        bufferPos = 0;
+    }
+
+    QString block = stream->read(BLOCK_SIZE);
+    if (block.isEmpty())
+        return false;
+
+    buffer += block;
+    return true;
+}
@@ -6,6 +6,9 @@
 
 #include <QTextStream>
 
+template <class T, class C>
+class CsvParser;
+
 class API_EXPORT CsvSerializer
 {
     public:
@@ -14,7 +17,62 @@ class API_EXPORT CsvSerializer
         static QList<QStringList> deserialize(const QString& data, const CsvFormat& format);
         static QList<QList<QByteArray>> deserialize(const QByteArray& data, const CsvFormat& format);
         static QList<QStringList> deserialize(QTextStream& data, const CsvFormat& format);
+
+        /**
+         * @brief Reads single entry from the stream.
+         * @param data Stream to read from.
+         * @param format CSV format of the data.
+         * @return Cells of the entry.
+         *
+         * It reads the stream character by character, to not consume anything after the entry.
+         * To read entries one after another, use CsvReader, which reads the stream in big blocks.
+         */
         static QStringList deserializeOneEntry(QTextStream& data, const CsvFormat& format);
 };
 
+/**
+ * @brief Reads CSV entries one by one from the text stream.
+ *
+ * The stream is read in big blocks and entries are parsed directly from the block,
+ * so the stream should not be read by anything else while the reader is in use.
+ * If the stream is repositioned (with QTextStream::seek()), the reset() has to be called.
+ */
+class API_EXPORT CsvReader
+{
+        Q_DISABLE_COPY(CsvReader)
+
+    public:
+        CsvReader(QTextStream* stream, const CsvFormat& format);
+        ~CsvReader();
+
+        /**
+         * @brief Reads next entry from the stream.
+         * @return Cells of the entry, or empty list if there was no more data.
+         */
+        QStringList readEntry();
+
+        /**
+         * @brief Tests if all the data was read.
+         * @return true if there are no more entries to read.
+         */
+        bool atEnd() const;
+
+        /**
+         * @brief Drops data read ahead from the stream.
+         *
+         * Has to be called after the stream was repositioned.
+         */
+        void reset();
+
+    private:
+        bool readBlock();
+
+        static const int BLOCK_SIZE = 256 * 1024;
+
+        QTextStream* stream = nullptr;
+        CsvParser<QString, QChar>* parser = nullptr;
+        QString buffer;
+        int bufferPos = 0;
+};
+
 #endif // CSVSERIALIZER_H
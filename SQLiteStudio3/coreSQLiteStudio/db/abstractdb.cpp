@@ -11,6 +11,7 @@
 #include "services/sqliteextensionmanager.h"
 #include "log.h"
 #include "parser/lexer.h"
+#include "schemaresolver.h"
 #include <QDebug>
 #include <QTime>
 #include <QWriteLocker>
@@ -28,6 +29,7 @@ AbstractDb::AbstractDb(const QString& name, const QString& path, const QHash<QSt
 
 AbstractDb::~AbstractDb()
 {
+    SchemaResolver::invalidateCatalog(this);
 }
 
 bool AbstractDb::open()
@@ -67,6 +69,7 @@ bool AbstractDb::closeQuiet()
     interruptExecution();
     bool res = closeInternal();
     clearAttaches();
+    SchemaResolver::invalidateCatalog(this);
     registeredFunctions.clear();
     registeredCollations.clear();
     if (FUNCTIONS) // FUNCTIONS is already null when closing db while closing entire app
@@ -348,6 +351,9 @@ SqlQueryPtr AbstractDb::execHashArg(const QString& query, const QHash<QString,QV
     queryStmt->setFlags(flags);
     queryStmt->execute();
 
+    if (changesDatabaseList(query))
+        SchemaResolver::invalidateDatabaseList(this);
+
     if (flags.testFlag(Flag::PRELOAD))
         queryStmt->preload();
 
@@ -365,6 +371,9 @@ SqlQueryPtr AbstractDb::execListArg(const QString& query, const QList<QVariant>&
     queryStmt->setFlags(flags);
     queryStmt->execute();
 
+    if (changesDatabaseList(query))
+        SchemaResolver::invalidateDatabaseList(this);
+
     if (flags.testFlag(Flag::PRELOAD))
         queryStmt->preload();
 
@@ -536,14 +545,14 @@ void AbstractDb::releaseAggregateContext(void* memPtr)
     delete *aggCtxPtr;
 }
 
-QVariant AbstractDb::evaluateScalar(void* dataPtr, const QList<QVariant>& argList, bool& ok)
+QVariant AbstractDb::evaluateScalar(void* dataPtr, const QList<QVariant>& argList, bool& ok, FunctionManager::ArgumentCache* argCache)
 {
     if (!dataPtr)
         return QVariant();
 
     FunctionUserData* userData = reinterpret_cast<FunctionUserData*>(dataPtr);
 
-    return FUNCTIONS->evaluateScalar(userData->name, userData->argCount, argList, userData->db, ok);
+    return FUNCTIONS->evaluateScalar(userData->name, userData->argCount, argList, userData->db, ok, argCache);
 }
 
 void AbstractDb::evaluateAggregateStep(void* dataPtr, QHash<QString, QVariant>& aggregateContext, QList<QVariant> argList)
@@ -682,6 +691,7 @@ void AbstractDb::detachInternal(Db* otherDb)
         return;
     }
     attachedDbMap.removeRight(otherDb);
+    SchemaResolver::invalidateCatalog(this, dbName);
     emit detached(otherDb);
 }
 
@@ -691,6 +701,11 @@ void AbstractDb::clearAttaches()
     attachCounter.clear();
 }
 
+bool AbstractDb::changesDatabaseList(const QString& query)
+{
+    return query.contains("attach", Qt::CaseInsensitive) || query.contains("detach", Qt::CaseInsensitive);
+}
+
 void AbstractDb::detachAll()
 {
     QWriteLocker locker(&dbOperLock);
@@ -761,6 +776,11 @@ bool AbstractDb::isValid() const
     return true;
 }
 
+Db::StatementCacheStats AbstractDb::getStatementCacheStats() const
+{
+    return StatementCacheStats();
+}
+
 QString AbstractDb::getAttachSql(Db* otherDb, const QString& generatedAttachName)
 {
     return QString("ATTACH '%1' AS %2;").arg(otherDb->getPath(), generatedAttachName);
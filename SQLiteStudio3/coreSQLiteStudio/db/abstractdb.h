@@ -86,6 +86,7 @@ class API_EXPORT AbstractDb : public Db
         void setTimeout(int secs);
         int getTimeout() const;
         bool isValid() const;
+        StatementCacheStats getStatementCacheStats() const;
         void loadExtensions();
 
     protected:
@@ -130,6 +131,16 @@ class API_EXPORT AbstractDb : public Db
          */
         void clearAttaches();
 
+        /**
+         * @brief Tells whether given query may attach or detach a database.
+         * @param query Query to check.
+         * @return true if the query contains ATTACH or DETACH keyword.
+         *
+         * It's a plain text check, cheap enough to be done for every executed query.
+         * False positives only make the SchemaResolver read the list of databases once again.
+         */
+        static bool changesDatabaseList(const QString& query);
+
         /**
          * @brief Generated unique ID for asynchronous query execution.
          * @return Unique ID.
@@ -241,6 +252,7 @@ class API_EXPORT AbstractDb : public Db
          * @param dataPtr SQL function user data (defined when registering function). Must be of FunctionUserData* type, or descendant.
          * @param argList List of arguments passed to the function.
          * @param[out] ok true (default) to indicate successful execution, or false to report an error.
+         * @param argCache Per-statement cache for data derived from arguments, or null if the database doesn't provide it.
          * @return Result returned from the plugin handling function implementation.
          *
          * This method is aware of the implementation language and the code defined for it,
@@ -248,7 +260,7 @@ class API_EXPORT AbstractDb : public Db
          *
          * This method is called for scalar functions.
          */
-        static QVariant evaluateScalar(void* dataPtr, const QList<QVariant>& argList, bool& ok);
+        static QVariant evaluateScalar(void* dataPtr, const QList<QVariant>& argList, bool& ok, FunctionManager::ArgumentCache* argCache = nullptr);
         static void evaluateAggregateStep(void* dataPtr, QHash<QString, QVariant>& aggregateContext, QList<QVariant> argList);
         static QVariant evaluateAggregateFinal(void* dataPtr, QHash<QString, QVariant>& aggregateContext, bool& ok);
 
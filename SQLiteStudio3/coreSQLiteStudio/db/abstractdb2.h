@@ -73,7 +73,7 @@ class AbstractDb2 : public AbstractDb
                 class Row : public SqlResultsRow
                 {
                     public:
-                        void init(const QStringList& columns, const QList<QVariant>& resultValues);
+                        void init(const SqlResultsColumnsPtr& columns, const QList<QVariant>& resultValues);
                 };
 
                 Query(AbstractDb2<T>* db, const QString& query);
@@ -759,7 +759,7 @@ SqlResultsRowPtr AbstractDb2<T>::Query::nextInternal()
     ReadWriteLocker locker(&(db->dbOperLock), query, Dialect::Sqlite2, flags.testFlag(Db::Flag::NO_LOCK));
 
     Row* row = new Row;
-    row->init(colNames, nextRowValues);
+    row->init(resultColumns, nextRowValues);
 
     int res = fetchNext();
     if (res != SQLITE_OK)
@@ -906,6 +906,7 @@ void AbstractDb2<T>::Query::init(int columnsCount, const char** columns)
         else
             colNames << "";
     }
+    resultColumns = SqlResultsColumnsPtr(new SqlResultsColumns(colNames));
 }
 
 //------------------------------------------------------------------------------------
@@ -913,13 +914,10 @@ void AbstractDb2<T>::Query::init(int columnsCount, const char** columns)
 //------------------------------------------------------------------------------------
 
 template <class T>
-void AbstractDb2<T>::Query::Row::init(const QStringList& columns, const QList<QVariant>& resultValues)
+void AbstractDb2<T>::Query::Row::init(const SqlResultsColumnsPtr& columns, const QList<QVariant>& resultValues)
 {
-    for (int i = 0; i < columns.size(); i++)
-    {
-        values << resultValues[i];
-        valuesMap[columns[i]] = resultValues[i];
-    }
+    this->columns = columns;
+    values = resultValues.mid(0, columns->count());
 }
 
 #endif // ABSTRACTDB2_H
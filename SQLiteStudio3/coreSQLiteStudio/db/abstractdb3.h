@@ -12,6 +12,8 @@
 #include <QThread>
 #include <QPointer>
 #include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
 
 /**
  * @brief Complete implementation of SQLite 3 driver for SQLiteStudio.
@@ -46,6 +48,7 @@ class AbstractDb3 : public AbstractDb
 
         bool loadExtension(const QString& filePath, const QString& initFunc = QString());
         bool isComplete(const QString& sql) const;
+        StatementCacheStats getStatementCacheStats() const;
 
     protected:
         bool isOpenInternal();
@@ -71,10 +74,9 @@ class AbstractDb3 : public AbstractDb
                 class Row : public SqlResultsRow
                 {
                     public:
-                        int init(const QStringList& columns, typename T::stmt* stmt, Db::Flags flags);
+                        int init(const SqlResultsColumnsPtr& columns, typename T::stmt* stmt, Db::Flags flags);
 
-                    private:
-                        int getValue(typename T::stmt* stmt, int col, QVariant& value, Db::Flags flags);
+                        static int getValue(typename T::stmt* stmt, int col, QVariant& value, Db::Flags flags);
                 };
 
                 Query(AbstractDb3<T>* db, const QString& query);
@@ -90,6 +92,7 @@ class AbstractDb3 : public AbstractDb
             protected:
                 SqlResultsRowPtr nextInternal();
                 bool hasNextInternal();
+                int nextBatchInternal(int maxRows, SqlResultsBlock& block);
                 bool execInternal(const QList<QVariant>& args);
                 bool execInternal(const QHash<QString, QVariant>& args);
 
@@ -100,6 +103,7 @@ class AbstractDb3 : public AbstractDb
                 int fetchFirst();
                 int fetchNext();
                 bool checkDbState();
+                void handleSchemaError(int res);
                 void copyErrorFromDb();
                 void copyErrorToDb();
                 void setError(int code, const QString& msg);
@@ -111,6 +115,13 @@ class AbstractDb3 : public AbstractDb
                 int colCount = 0;
                 QStringList colNames;
                 bool rowAvailable = false;
+
+                /**
+                 * @brief Tells if the compiled statement can be returned to the statement cache when finalized.
+                 *
+                 * It's set to false when the statement failed with SQLITE_SCHEMA, so it gets really finalized.
+                 */
+                bool reusable = true;
         };
 
         struct CollationUserData
@@ -119,10 +130,83 @@ class AbstractDb3 : public AbstractDb
             AbstractDb3<T>* db = nullptr;
         };
 
+        /**
+         * @brief Auxiliary data stored by SQLite for a function argument.
+         *
+         * Apart from the data cached by the function implementation it keeps the argument value
+         * already converted to QVariant, so it doesn't have to be converted again for next rows.
+         */
+        struct ArgumentAuxData
+        {
+            QVariant value;
+            void* data = nullptr;
+            void (*deleter)(void*) = nullptr;
+        };
+
+        /**
+         * @brief Function argument cache implemented with sqlite3_get_auxdata() and sqlite3_set_auxdata().
+         *
+         * SQLite keeps auxiliary data of the argument for as long as the argument value doesn't change,
+         * which in practice means for all rows of the statement, if the argument is a constant expression.
+         */
+        class AuxDataArgumentCache : public FunctionManager::ArgumentCache
+        {
+            public:
+                AuxDataArgumentCache(typename T::context* context, const QList<QVariant>& args);
+
+            protected:
+                void* getData(int argIndex) const;
+                void setData(int argIndex, void* data, void (*deleter)(void*));
+
+            private:
+                typename T::context* context = nullptr;
+                const QList<QVariant>& args;
+        };
+
         QString extractLastError();
         void cleanUp();
         void resetError();
 
+        /**
+         * @brief Takes compiled statement for given query out of the statement cache.
+         * @param query Query to find statement for.
+         * @return Compiled statement, or null if the query was not in the cache.
+         *
+         * The statement is removed from the cache, so it's exclusively owned by the caller
+         * until it's given back with releaseStmt().
+         */
+        typename T::stmt* takeCachedStmt(const QString& query);
+
+        /**
+         * @brief Gives compiled statement back to the statement cache.
+         * @param query Query that the statement was compiled from.
+         * @param stmt Statement to keep for later reuse.
+         *
+         * The statement is reset and its bindings are cleared. If the query is not suitable for caching,
+         * or there is already another statement cached for the same query, then the statement is finalized.
+         * If the cache grows over STMT_CACHE_SIZE, the least recently used statement is finalized.
+         */
+        void releaseStmt(const QString& query, typename T::stmt* stmt);
+
+        /**
+         * @brief Finalizes all statements in the statement cache.
+         *
+         * It's called when the database is being closed and when SQLite reported that the schema has changed.
+         */
+        void clearStmtCache();
+
+        /**
+         * @brief Maximum number of compiled statements kept in the cache.
+         */
+        static const int STMT_CACHE_SIZE = 64;
+
+        /**
+         * @brief Queries longer than this (in characters) are never cached.
+         *
+         * Those are usually ad-hoc queries typed by the user, which are unlikely to be repeated.
+         */
+        static const int STMT_CACHE_MAX_QUERY_LENGTH = 4096;
+
         /**
          * @brief Registers function to call when unknown collation was encountered by the SQLite.
          *
@@ -148,12 +232,24 @@ class AbstractDb3 : public AbstractDb
          * @brief Converts SQLite arguments into the list of argument values.
          * @param argCount Number of arguments.
          * @param args SQLite argument values.
+         * @param context SQL function call context, or null if auxiliary data of arguments should not be used.
          * @return Convenient Qt list with argument values as QVariant.
          *
          * This function does necessary conversions reflecting internal SQLite datatype, so if the type
          * was for example BLOB, then the QVariant will be a QByteArray, etc.
+         *
+         * If the context is given and the argument has auxiliary data (see AuxDataArgumentCache),
+         * the value converted in one of previous calls is used.
          */
-        static QList<QVariant> getArgs(int argCount, typename T::value** args);
+        static QList<QVariant> getArgs(int argCount, typename T::value** args, typename T::context* context = nullptr);
+
+        /**
+         * @brief Releases auxiliary data of the function argument.
+         * @param auxData ArgumentAuxData object.
+         *
+         * This is called by SQLite when the argument value changes, or when the statement is finalized.
+         */
+        static void deleteArgumentAuxData(void* auxData);
 
         /**
          * @brief Evaluates requested function using defined implementation code and provides result.
@@ -299,6 +395,24 @@ class AbstractDb3 : public AbstractDb
          * and delete it when database is closed.
          */
         CollationUserData* defaultCollationUserData = nullptr;
+
+        /**
+         * @brief Compiled statements ready for reuse, keyed by the query text.
+         */
+        QHash<QString, typename T::stmt*> stmtCache;
+
+        /**
+         * @brief Queries from stmtCache ordered from the least to the most recently used one.
+         */
+        QStringList stmtCacheOrder;
+
+        /**
+         * @brief Guards the statement cache, as queries can be finalized from any thread.
+         */
+        mutable QMutex stmtCacheMutex;
+
+        quint64 stmtCacheHits = 0;
+        quint64 stmtCacheMisses = 0;
 };
 
 //------------------------------------------------------------------------------------
@@ -343,6 +457,17 @@ bool AbstractDb3<T>::isComplete(const QString& sql) const
     return T::complete(sql.toUtf8().constData());
 }
 
+template<class T>
+Db::StatementCacheStats AbstractDb3<T>::getStatementCacheStats() const
+{
+    QMutexLocker locker(&stmtCacheMutex);
+    StatementCacheStats stats;
+    stats.hits = stmtCacheHits;
+    stats.misses = stmtCacheMisses;
+    stats.size = stmtCache.size();
+    return stats;
+}
+
 template <class T>
 bool AbstractDb3<T>::isOpenInternal()
 {
@@ -527,6 +652,7 @@ void AbstractDb3<T>::cleanUp()
     for (Query* q : queries)
         q->finalize();
 
+    clearStmtCache();
     safe_delete(defaultCollationUserData);
 }
 
@@ -537,6 +663,52 @@ void AbstractDb3<T>::resetError()
     dbErrorMessage = QString();
 }
 
+template <class T>
+typename T::stmt* AbstractDb3<T>::takeCachedStmt(const QString& query)
+{
+    QMutexLocker locker(&stmtCacheMutex);
+    typename T::stmt* stmt = stmtCache.take(query);
+    if (!stmt)
+    {
+        stmtCacheMisses++;
+        return nullptr;
+    }
+
+    stmtCacheOrder.removeOne(query);
+    stmtCacheHits++;
+    return stmt;
+}
+
+template <class T>
+void AbstractDb3<T>::releaseStmt(const QString& query, typename T::stmt* stmt)
+{
+    QMutexLocker locker(&stmtCacheMutex);
+    if (!dbHandle || query.size() > STMT_CACHE_MAX_QUERY_LENGTH || stmtCache.contains(query))
+    {
+        T::finalize(stmt);
+        return;
+    }
+
+    T::reset(stmt);
+    T::clear_bindings(stmt);
+    stmtCache[query] = stmt;
+    stmtCacheOrder << query;
+
+    while (stmtCacheOrder.size() > STMT_CACHE_SIZE)
+        T::finalize(stmtCache.take(stmtCacheOrder.takeFirst()));
+}
+
+template <class T>
+void AbstractDb3<T>::clearStmtCache()
+{
+    QMutexLocker locker(&stmtCacheMutex);
+    for (typename T::stmt* stmt : stmtCache)
+        T::finalize(stmt);
+
+    stmtCache.clear();
+    stmtCacheOrder.clear();
+}
+
 template <class T>
 void AbstractDb3<T>::storeResult(typename T::context* context, const QVariant& result, bool ok)
 {
@@ -607,15 +779,22 @@ void AbstractDb3<T>::storeResult(typename T::context* context, const QVariant& r
 }
 
 template <class T>
-QList<QVariant> AbstractDb3<T>::getArgs(int argCount, typename T::value** args)
+QList<QVariant> AbstractDb3<T>::getArgs(int argCount, typename T::value** args, typename T::context* context)
 {
     int dataType;
     QList<QVariant> results;
     QVariant value;
+    ArgumentAuxData* auxData = nullptr;
 
     // The loop below uses slightly modified code from Qt (its SQLite plugin) to extract values.
     for (int i = 0; i < argCount; i++)
     {
+        if (context && (auxData = reinterpret_cast<ArgumentAuxData*>(T::get_auxdata(context, i))))
+        {
+            results << auxData->value;
+            continue;
+        }
+
         dataType = T::value_type(args[i]);
         switch (dataType)
         {
@@ -649,9 +828,10 @@ QList<QVariant> AbstractDb3<T>::getArgs(int argCount, typename T::value** args)
 template <class T>
 void AbstractDb3<T>::evaluateScalar(typename T::context* context, int argCount, typename T::value** args)
 {
-    QList<QVariant> argList = getArgs(argCount, args);
+    QList<QVariant> argList = getArgs(argCount, args, context);
+    AuxDataArgumentCache argCache(context, argList);
     bool ok = true;
-    QVariant result = AbstractDb::evaluateScalar(T::user_data(context), argList, ok);
+    QVariant result = AbstractDb::evaluateScalar(T::user_data(context), argList, ok, &argCache);
     storeResult(context, result, ok);
 }
 
@@ -699,6 +879,19 @@ void AbstractDb3<T>::deleteCollationUserData(void* userData)
     delete collUserData;
 }
 
+template <class T>
+void AbstractDb3<T>::deleteArgumentAuxData(void* auxData)
+{
+    if (!auxData)
+        return;
+
+    ArgumentAuxData* argAuxData = reinterpret_cast<ArgumentAuxData*>(auxData);
+    if (argAuxData->data && argAuxData->deleter)
+        argAuxData->deleter(argAuxData->data);
+
+    delete argAuxData;
+}
+
 template <class T>
 void AbstractDb3<T>::deleteUserData(void* dataPtr)
 {
@@ -847,6 +1040,10 @@ void AbstractDb3<T>::Query::setError(int code, const QString& msg)
 template <class T>
 int AbstractDb3<T>::Query::prepareStmt()
 {
+    stmt = db->takeCachedStmt(query);
+    if (stmt)
+        return T::OK;
+
     const char* tail;
     QByteArray queryBytes = query.toUtf8();
     int res = T::prepare_v2(db->dbHandle, queryBytes.constData(), queryBytes.size(), &stmt, &tail);
@@ -1032,12 +1229,28 @@ bool AbstractDb3<T>::Query::checkDbState()
     return true;
 }
 
+template <class T>
+void AbstractDb3<T>::Query::handleSchemaError(int res)
+{
+    if ((res & 0xff) != T::SCHEMA)
+        return;
+
+    // Schema has changed and the statement could not be recompiled transparently.
+    // None of compiled statements can be trusted anymore.
+    reusable = false;
+    db->clearStmtCache();
+}
+
 template <class T>
 void AbstractDb3<T>::Query::finalize()
 {
     if (stmt)
     {
-        T::finalize(stmt);
+        if (reusable && !db.isNull())
+            db->releaseStmt(query, stmt);
+        else
+            T::finalize(stmt);
+
         stmt = nullptr;
     }
 }
@@ -1076,7 +1289,7 @@ template <class T>
 SqlResultsRowPtr AbstractDb3<T>::Query::nextInternal()
 {
     Row* row = new Row;
-    int res = row->init(colNames, stmt, flags);
+    int res = row->init(resultColumns, stmt, flags);
     if (res != T::OK)
     {
         delete row;
@@ -1101,16 +1314,48 @@ bool AbstractDb3<T>::Query::hasNextInternal()
 }
 
 template <class T>
-int AbstractDb3<T>::Query::fetchFirst()
+int AbstractDb3<T>::Query::nextBatchInternal(int maxRows, SqlResultsBlock& block)
 {
-    colCount = T::column_count(stmt);
-    for (int i = 0; i < colCount; i++)
-        colNames << QString::fromUtf8(T::column_name(stmt, i));
+    block.reset(resultColumns);
+    int res;
+    QVariant* rowValues = nullptr;
+    while (block.rowCount() < maxRows && hasNextInternal())
+    {
+        rowValues = block.appendRow();
+        for (int i = 0; i < colCount; i++)
+        {
+            res = Row::getValue(stmt, i, rowValues[i], flags);
+            if (res != T::OK)
+            {
+                setError(res, QString::fromUtf8(T::errmsg(db->dbHandle)));
+                return block.rowCount();
+            }
+        }
 
+        if (fetchNext() != T::OK)
+            break;
+    }
+    return block.rowCount();
+}
+
+template <class T>
+int AbstractDb3<T>::Query::fetchFirst()
+{
     int changesBefore =  T::total_changes(db->dbHandle);
     rowAvailable = true;
     int res = fetchNext();
 
+    // Column names are read after the first step, because step() may have recompiled
+    // the statement (for example reused one from the cache) after the schema was changed.
+    colNames.clear();
+    if (stmt)
+    {
+        colCount = T::column_count(stmt);
+        for (int i = 0; i < colCount; i++)
+            colNames << QString::fromUtf8(T::column_name(stmt, i));
+    }
+    resultColumns = SqlResultsColumnsPtr(new SqlResultsColumns(colNames));
+
     affected = 0;
     if (res == T::OK)
     {
@@ -1153,6 +1398,7 @@ int AbstractDb3<T>::Query::fetchNext()
             break;
         default:
             setError(res, QString::fromUtf8(T::errmsg(db->dbHandle)));
+            handleSchemaError(res);
             return T::ERROR;
     }
     return T::OK;
@@ -1163,18 +1409,22 @@ int AbstractDb3<T>::Query::fetchNext()
 //------------------------------------------------------------------------------------
 
 template <class T>
-int AbstractDb3<T>::Query::Row::init(const QStringList& columns, typename T::stmt* stmt, Db::Flags flags)
+int AbstractDb3<T>::Query::Row::init(const SqlResultsColumnsPtr& columns, typename T::stmt* stmt, Db::Flags flags)
 {
+    this->columns = columns;
+
     int res = T::OK;
+    int colCount = columns->count();
+    values.reserve(colCount);
+
     QVariant value;
-    for (int i = 0; i < columns.size(); i++)
+    for (int i = 0; i < colCount; i++)
     {
         res = getValue(stmt, i, value, flags);
         if (res != T::OK)
             return res;
 
         values << value;
-        valuesMap[columns[i]] = value;
     }
     return res;
 }
@@ -1211,4 +1461,38 @@ int AbstractDb3<T>::Query::Row::getValue(typename T::stmt* stmt, int col, QVaria
     return T::OK;
 }
 
+template <class T>
+AbstractDb3<T>::AuxDataArgumentCache::AuxDataArgumentCache(typename T::context* context, const QList<QVariant>& args) :
+    context(context), args(args)
+{
+}
+
+template <class T>
+void* AbstractDb3<T>::AuxDataArgumentCache::getData(int argIndex) const
+{
+    ArgumentAuxData* auxData = reinterpret_cast<ArgumentAuxData*>(T::get_auxdata(context, argIndex));
+    if (!auxData)
+        return nullptr;
+
+    return auxData->data;
+}
+
+template <class T>
+void AbstractDb3<T>::AuxDataArgumentCache::setData(int argIndex, void* data, void (*deleter)(void*))
+{
+    if (argIndex < 0 || argIndex >= args.size())
+    {
+        deleter(data);
+        return;
+    }
+
+    ArgumentAuxData* auxData = new ArgumentAuxData;
+    auxData->value = args[argIndex];
+    auxData->data = data;
+    auxData->deleter = deleter;
+
+    // SQLite releases the previous aux data of this argument (if any) and may also release the new one immediately
+    T::set_auxdata(context, argIndex, auxData, &AbstractDb3<T>::deleteArgumentAuxData);
+}
+
 #endif // ABSTRACTDB3_H
@@ -166,6 +166,20 @@ class API_EXPORT Db : public QObject, public Interruptable
          */
         typedef std::function<void(SqlQueryPtr)> QueryResultsHandler;
 
+        /**
+         * @brief Statistics of the compiled statement cache of the database connection.
+         *
+         * Drivers which do not cache compiled statements report all values as zero.
+         *
+         * @see getStatementCacheStats()
+         */
+        struct StatementCacheStats
+        {
+            quint64 hits = 0;   /**< Number of executions which reused already compiled statement. */
+            quint64 misses = 0; /**< Number of executions which had to compile the statement. */
+            int size = 0;       /**< Number of compiled statements currently kept in the cache. */
+        };
+
         /**
          * @brief Default, empty constructor.
          */
@@ -703,6 +717,15 @@ class API_EXPORT Db : public QObject, public Interruptable
          */
         virtual bool loadExtension(const QString& filePath, const QString& initFunc = QString()) = 0;
 
+        /**
+         * @brief Provides hit/miss statistics of the compiled statement cache.
+         * @return Current statistics of the cache.
+         *
+         * The cache is maintained per connection and is cleared each time the connection is closed,
+         * but the hit/miss counters are kept for the whole lifetime of the Db object.
+         */
+        virtual StatementCacheStats getStatementCacheStats() const = 0;
+
     signals:
         /**
          * @brief Emitted when the connection to the database was established.
@@ -338,6 +338,11 @@ bool InvalidDb::isComplete(const QString& sql) const
     return false;
 }
 
+Db::StatementCacheStats InvalidDb::getStatementCacheStats() const
+{
+    return StatementCacheStats();
+}
+
 void InvalidDb::interrupt()
 {
 }
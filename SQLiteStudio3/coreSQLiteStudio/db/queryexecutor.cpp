@@ -20,6 +20,7 @@
 #include "queryexecutorsteps/queryexecutordetectschemaalter.h"
 #include "queryexecutorsteps/queryexecutorvaluesmode.h"
 #include "common/unused.h"
+#include "common/utils_sql.h"
 #include "chainexecutor.h"
 #include "log.h"
 #include <QMutexLocker>
@@ -105,14 +106,20 @@ void QueryExecutor::setupExecutionChain()
     executionChain.append(createSteps(AFTER_DISTINCT_WRAP));
 
     executionChain << new QueryExecutorCellSize()
-                   << new QueryExecutorCountResults()
-                   << new QueryExecutorParseQuery("after CellSize");
+                   << new QueryExecutorCountResults();
+
+    // CellSize and Limit steps only wrap tokens of the SELECT and the final execution works on tokens as well,
+    // so from here the query needs to be parsed again only for additional steps, which may expect up to date parsed queries.
+    if (hasAdditionalSteps(AFTER_CELL_SIZE_LIMIT))
+        executionChain << new QueryExecutorParseQuery("after CellSize");
 
     executionChain.append(additionalStatelessSteps[AFTER_CELL_SIZE_LIMIT]);
     executionChain.append(createSteps(AFTER_CELL_SIZE_LIMIT));
 
-    executionChain << new QueryExecutorLimit()
-                   << new QueryExecutorParseQuery("after Limit");
+    executionChain << new QueryExecutorLimit();
+
+    if (hasAdditionalSteps(AFTER_ROW_LIMIT_AND_OFFSET) || hasAdditionalSteps(JUST_BEFORE_EXECUTION) || hasAdditionalSteps(LAST))
+        executionChain << new QueryExecutorParseQuery("after Limit");
 
     executionChain.append(additionalStatelessSteps[AFTER_ROW_LIMIT_AND_OFFSET]);
     executionChain.append(createSteps(AFTER_ROW_LIMIT_AND_OFFSET));
@@ -211,6 +218,9 @@ void QueryExecutor::cleanupBeforeDbDestroy(Db* dbToBeUnloaded)
 
 void QueryExecutor::setQuery(const QString& query)
 {
+    if (originalQuery != query)
+        pageSeekKeys.clear();
+
     originalQuery = query;
 }
 
@@ -321,29 +331,151 @@ bool QueryExecutor::countResults()
     if (context->countingQuery.isEmpty()) // simple method doesn't provide that
         return false;
 
+    context->rowCounting = getRowCountingMode();
+    if (context->rowCounting == RowCounting::ESTIMATED)
+    {
+        if (estimateRowCount())
+            return true;
+
+        // No statistics for the query, but it's still better to count only up to the cap, than to scan everything
+        context->rowCounting = RowCounting::CAPPED;
+    }
+
+    // Partial totals make no sense if the caller is blocked until the counting is done
+    if (context->rowCounting == RowCounting::PROGRESSIVE && !asyncMode)
+        context->rowCounting = RowCounting::EXACT;
+
+    switch (context->rowCounting)
+    {
+        case RowCounting::CAPPED:
+            context->countingLimit = ROW_COUNTING_CAP;
+            break;
+        case RowCounting::PROGRESSIVE:
+            context->countingLimit = PROGRESSIVE_ROW_COUNTING_FIRST_LIMIT;
+            break;
+        case RowCounting::EXACT:
+        case RowCounting::ESTIMATED:
+            context->countingLimit = -1;
+            break;
+    }
+
     if (asyncMode)
     {
         // Start asynchronous results counting query
-        resultsCountingAsyncId = db->asyncExec(context->countingQuery, context->queryParameters, Db::Flag::NO_LOCK);
+        resultsCountingAsyncId = db->asyncExec(getLimitedCountingQuery(), context->queryParameters, Db::Flag::NO_LOCK);
     }
     else
     {
-        SqlQueryPtr results = db->exec(context->countingQuery, context->queryParameters, Db::Flag::NO_LOCK);
-        context->totalRowsReturned = results->getSingleCell().toLongLong();
-        context->totalPages = (int)qCeil(((double)(context->totalRowsReturned)) / ((double)getResultsPerPage()));
-
-        emit resultsCountingFinished(context->rowsAffected, context->totalRowsReturned, context->totalPages);
-
+        SqlQueryPtr results = db->exec(getLimitedCountingQuery(), context->queryParameters, Db::Flag::NO_LOCK);
+        applyRowCountingResults(results);
         if (results->isError())
-        {
-            notifyError(tr("An error occured while executing the count(*) query, thus data paging will be disabled. Error details from the database: %1")
-                        .arg(results->getErrorText()));
             return false;
-        }
     }
     return true;
 }
 
+QueryExecutor::RowCounting QueryExecutor::getRowCountingMode() const
+{
+    return stringToRowCounting(db->getConnectionOptions().value(ROW_COUNTING_MODE).toString());
+}
+
+QueryExecutor::RowCountAccuracy QueryExecutor::getRowCountAccuracy() const
+{
+    return context->rowCountAccuracy;
+}
+
+bool QueryExecutor::isRowCountingInProgress() const
+{
+    return resultsCountingAsyncId != 0;
+}
+
+QString QueryExecutor::rowCountingToString(QueryExecutor::RowCounting mode)
+{
+    switch (mode)
+    {
+        case RowCounting::EXACT:
+            return "exact";
+        case RowCounting::ESTIMATED:
+            return "estimated";
+        case RowCounting::PROGRESSIVE:
+            return "progressive";
+        case RowCounting::CAPPED:
+            return "capped";
+    }
+    return QString();
+}
+
+QueryExecutor::RowCounting QueryExecutor::stringToRowCounting(const QString& mode)
+{
+    QString upper = mode.toUpper();
+    if (upper == "ESTIMATED")
+        return RowCounting::ESTIMATED;
+
+    if (upper == "PROGRESSIVE")
+        return RowCounting::PROGRESSIVE;
+
+    if (upper == "CAPPED")
+        return RowCounting::CAPPED;
+
+    return RowCounting::EXACT;
+}
+
+void QueryExecutor::applyRowCountingResults(SqlQueryPtr results)
+{
+    context->totalRowsReturned = results->getSingleCell().toLongLong();
+    context->totalPages = (int)qCeil(((double)(context->totalRowsReturned)) / ((double)getResultsPerPage()));
+
+    // The limited counting query counts one row over the limit, so it's known if there is more
+    bool moreRows = !results->isError() && context->countingLimit > -1 && context->totalRowsReturned > context->countingLimit;
+    context->rowCountAccuracy = moreRows ? RowCountAccuracy::AT_LEAST : RowCountAccuracy::EXACT;
+
+    if (moreRows && context->rowCounting == RowCounting::PROGRESSIVE && asyncMode)
+    {
+        context->countingLimit *= 10;
+        resultsCountingAsyncId = db->asyncExec(getLimitedCountingQuery(), context->queryParameters, Db::Flag::NO_LOCK);
+    }
+
+    emit resultsCountingFinished(context->rowsAffected, context->totalRowsReturned, context->totalPages);
+
+    if (results->isError())
+    {
+        notifyError(tr("An error occured while executing the count(*) query, thus data paging will be disabled. Error details from the database: %1")
+                    .arg(results->getErrorText()));
+    }
+}
+
+bool QueryExecutor::estimateRowCount()
+{
+    if (context->estimationTable.isNull())
+        return false;
+
+    // The first number in the "stat" column is the number of rows in the table, no matter which index the entry is for.
+    static_qstring(estimationTpl, "SELECT CAST(stat AS INTEGER) FROM %1.sqlite_stat1 WHERE lower(tbl) = lower(?) LIMIT 1");
+
+    QString database = context->estimationDatabase.isEmpty() ? QStringLiteral("main") : context->estimationDatabase;
+    QString sql = estimationTpl.arg(wrapObjIfNeeded(database, db->getDialect()));
+    SqlQueryPtr results = db->exec(sql, QList<QVariant>({context->estimationTable}), Db::Flag::NO_LOCK);
+    QVariant estimation = results->getSingleCell();
+    if (results->isError() || estimation.isNull())
+        return false; // ANALYZE was not executed for the table
+
+    context->totalRowsReturned = estimation.toLongLong();
+    context->totalPages = (int)qCeil(((double)(context->totalRowsReturned)) / ((double)getResultsPerPage()));
+    context->rowCountAccuracy = RowCountAccuracy::ESTIMATED;
+
+    emit resultsCountingFinished(context->rowsAffected, context->totalRowsReturned, context->totalPages);
+    return true;
+}
+
+QString QueryExecutor::getLimitedCountingQuery() const
+{
+    static_qstring(limitedTpl, "SELECT count(*) AS cnt FROM (SELECT 1 FROM (%1) LIMIT %2);");
+    if (context->countingLimit < 0 || context->countedQuery.isEmpty())
+        return context->countingQuery;
+
+    return limitedTpl.arg(context->countedQuery, QString::number(context->countingLimit + 1));
+}
+
 void QueryExecutor::dbAsyncExecFinished(quint32 asyncId, SqlQueryPtr results)
 {
     if (handleRowCountingResults(asyncId, results))
@@ -401,6 +533,11 @@ QList<QueryExecutor::ResultRowIdColumnPtr> QueryExecutor::getRowIdResultColumns(
     return context->rowIdColumns;
 }
 
+QString QueryExecutor::getKeysetColumnAlias() const
+{
+    return context->keysetColumnAlias;
+}
+
 int QueryExecutor::getMetaColumnCount() const
 {
     int count = 0;
@@ -417,16 +554,23 @@ QSet<QueryExecutor::EditionForbiddenReason> QueryExecutor::getEditionForbiddenGl
 
 void QueryExecutor::setParam(const QString& name, const QVariant& value)
 {
+    if (queryParameters.value(name) != value)
+        pageSeekKeys.clear();
+
     queryParameters[name] = value;
 }
 
 void QueryExecutor::setParams(const QHash<QString, QVariant>& params)
 {
+    if (queryParameters != params)
+        pageSeekKeys.clear();
+
     queryParameters = params;
 }
 
 void QueryExecutor::arg(const QVariant& value)
 {
+    pageSeekKeys.clear();
     QVariant::Type type = value.type();
     switch (type)
     {
@@ -498,7 +642,10 @@ void QueryExecutor::simpleExecutionFinished(SqlQueryPtr results)
     context->executionTime = QDateTime::currentMSecsSinceEpoch() - simpleExecutionStartTime;
 
     if (simpleExecIsSelect())
-        context->countingQuery = "SELECT count(*) AS cnt FROM ("+trimQueryEnd(queriesForSimpleExecution.last())+");";
+    {
+        context->countedQuery = trimQueryEnd(queriesForSimpleExecution.last());
+        context->countingQuery = "SELECT count(*) AS cnt FROM ("+context->countedQuery+");";
+    }
     else
         context->rowsCountingRequired = true;
 
@@ -607,18 +754,7 @@ bool QueryExecutor::handleRowCountingResults(quint32 asyncId, SqlQueryPtr result
         return false;
 
     resultsCountingAsyncId = 0;
-
-    context->totalRowsReturned = results->getSingleCell().toLongLong();
-    context->totalPages = (int)qCeil(((double)(context->totalRowsReturned)) / ((double)getResultsPerPage()));
-
-    emit resultsCountingFinished(context->rowsAffected, context->totalRowsReturned, context->totalPages);
-
-    if (results->isError())
-    {
-        notifyError(tr("An error occured while executing the count(*) query, thus data paging will be disabled. Error details from the database: %1")
-                    .arg(results->getErrorText()));
-    }
-
+    applyRowCountingResults(results);
     return true;
 }
 
@@ -650,6 +786,11 @@ QList<QueryExecutorStep*> QueryExecutor::createSteps(QueryExecutor::StepPosition
     return steps;
 }
 
+bool QueryExecutor::hasAdditionalSteps(QueryExecutor::StepPosition position) const
+{
+    return !additionalStatelessSteps.value(position).isEmpty() || !additionalStatefulStepFactories.value(position).isEmpty();
+}
+
 int QueryExecutor::getQueryCountLimitForSmartMode() const
 {
     return queryCountLimitForSmartMode;
@@ -920,6 +1061,9 @@ int QueryExecutor::getResultsPerPage() const
 
 void QueryExecutor::setResultsPerPage(int value)
 {
+    if (resultsPerPage != value)
+        pageSeekKeys.clear();
+
     resultsPerPage = value;
 }
 
@@ -985,6 +1129,42 @@ void QueryExecutor::setSortOrder(const SortList& value)
     sortOrder = value;
 }
 
+bool QueryExecutor::getKeysetPaging() const
+{
+    return keysetPaging;
+}
+
+void QueryExecutor::setKeysetPaging(bool value)
+{
+    keysetPaging = value;
+}
+
+void QueryExecutor::setPageSeekKey(int page, const QVariant& key)
+{
+    if (page <= 0 || key.isNull())
+        return;
+
+    pageSeekKeys[page] = key;
+}
+
+void QueryExecutor::clearPageSeekKeys()
+{
+    pageSeekKeys.clear();
+}
+
+bool QueryExecutor::findPageSeekKey(int page, int& seekPage, QVariant& key) const
+{
+    // First key greater than requested page, then step back to the nearest one not greater than the page
+    QMap<int,QVariant>::const_iterator it = pageSeekKeys.upperBound(page);
+    if (it == pageSeekKeys.constBegin())
+        return false;
+
+    --it;
+    seekPage = it.key();
+    key = it.value();
+    return true;
+}
+
 int operator==(const QueryExecutor::SourceTable& t1, const QueryExecutor::SourceTable& t2)
 {
     return t1.database == t2.database && t1.table == t2.table && t1.alias == t2.alias;
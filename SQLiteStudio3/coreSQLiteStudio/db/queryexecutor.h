@@ -9,6 +9,7 @@
 #include "datatype.h"
 #include <QObject>
 #include <QHash>
+#include <QMap>
 #include <QMutex>
 #include <QRunnable>
 
@@ -235,6 +236,49 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
 
         typedef QList<Sort> SortList;
 
+        /**
+         * @brief Strategy of counting total number of result rows.
+         *
+         * It's defined per database with the ROW_COUNTING_MODE connection option.
+         * See countResults() for details.
+         */
+        enum class RowCounting
+        {
+            EXACT, /**< Counts all result rows with count(*). This is the default. */
+            ESTIMATED, /**< Takes number of rows from sqlite_stat1 when browsing a table, or falls back to CAPPED for other queries. */
+            PROGRESSIVE, /**< Counts rows in background up to growing limits, reporting partial totals, until exact number is known. */
+            CAPPED /**< Counts rows only up to ROW_COUNTING_CAP. */
+        };
+
+        /**
+         * @brief Accuracy of the total number of rows reported by resultsCountingFinished().
+         */
+        enum class RowCountAccuracy
+        {
+            EXACT, /**< Number of rows is exact. */
+            ESTIMATED, /**< Number of rows comes from statistics and can be inaccurate either way. */
+            AT_LEAST /**< There are at least as many rows as reported, but there can be more. */
+        };
+
+        /**
+         * @brief Connection option defining row counting strategy for the database.
+         *
+         * Its value is one of names returned by rowCountingToString().
+         */
+        static_char* ROW_COUNTING_MODE = "rowCountingMode";
+
+        /**
+         * @brief Maximum number of rows counted in RowCounting::CAPPED mode.
+         */
+        static constexpr int ROW_COUNTING_CAP = 100000;
+
+        /**
+         * @brief Number of rows counted in the first round of RowCounting::PROGRESSIVE mode.
+         *
+         * Each next round counts up to 10 times more rows than the previous one.
+         */
+        static constexpr int PROGRESSIVE_ROW_COUNTING_FIRST_LIMIT = 10000;
+
         /**
          * @brief ResultColumn as represented by QueryExecutor.
          *
@@ -533,6 +577,14 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
              */
             QList<SqliteQueryPtr> parsedQueries;
 
+            /**
+             * @brief Query string that the parsedQueries were parsed from.
+             *
+             * QueryExecutorParseQuery compares it with processedQuery and skips parsing
+             * if the query was not modified by steps executed since the last parsing.
+             */
+            QString lastParsedQuery;
+
             /**
              * @brief Results of executed query.
              *
@@ -574,6 +626,14 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
              */
             QList<ResultRowIdColumnPtr> rowIdColumns;
 
+            /**
+             * @brief Alias of the ROWID column used for keyset paging.
+             *
+             * QueryExecutorLimit sets it when the page was queried with keyset paging
+             * (see QueryExecutor::setKeysetPaging()). It's null if regular LIMIT/OFFSET paging was used.
+             */
+            QString keysetColumnAlias;
+
             /**
              * @brief Result columns from the query.
              *
@@ -598,6 +658,46 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
              */
             QString countingQuery;
 
+            /**
+             * @brief Query that the rows are counted for.
+             *
+             * This is the query wrapped by countingQuery. It's used to build counting queries
+             * with row limit (see QueryExecutor::RowCounting).
+             */
+            QString countedQuery;
+
+            /**
+             * @brief Database of the table browsed by the query.
+             *
+             * Set together with estimationTable.
+             */
+            QString estimationDatabase;
+
+            /**
+             * @brief Table browsed by the query.
+             *
+             * It's set by QueryExecutorCountResults only if the query reads all rows of a single table
+             * (no WHERE, no joins, no grouping, etc), so the number of rows can be estimated from sqlite_stat1.
+             */
+            QString estimationTable;
+
+            /**
+             * @brief Row counting strategy used for the query.
+             *
+             * It's taken from the database connection options when counting starts.
+             */
+            RowCounting rowCounting = RowCounting::EXACT;
+
+            /**
+             * @brief Maximum number of rows counted by current counting query, or -1 for no limit.
+             */
+            qint64 countingLimit = -1;
+
+            /**
+             * @brief Accuracy of totalRowsReturned.
+             */
+            RowCountAccuracy rowCountAccuracy = RowCountAccuracy::EXACT;
+
             /**
              * @brief Flag indicating results preloading.
              *
@@ -745,10 +845,36 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
          *
          * It is executed after the main query execution has finished.
          *
+         * The way of counting depends on the database's ROW_COUNTING_MODE connection option (see RowCounting).
+         * Modes other than RowCounting::EXACT may report number of rows that is not exact (see getRowCountAccuracy()).
+         * In RowCounting::PROGRESSIVE mode the resultsCountingFinished() signal is emitted for every counting round,
+         * with isRowCountingInProgress() returning true until the last round.
+         *
          * If query is being executed in async mode, the true result (sucess/fail) will be known from later, not from this method.
          */
         bool countResults();
 
+        /**
+         * @brief Gets row counting strategy defined for the database.
+         * @return Row counting strategy.
+         */
+        RowCounting getRowCountingMode() const;
+
+        /**
+         * @brief Gets accuracy of the total number of rows.
+         * @return Accuracy of the number reported with recent resultsCountingFinished().
+         */
+        RowCountAccuracy getRowCountAccuracy() const;
+
+        /**
+         * @brief Tests if row counting is still running in background.
+         * @return true if another counting round was started after recent resultsCountingFinished().
+         */
+        bool isRowCountingInProgress() const;
+
+        static QString rowCountingToString(RowCounting mode);
+        static RowCounting stringToRowCounting(const QString& mode);
+
         /**
          * @brief Gets time of how long it took to execute query.
          * @return Execution time in milliseconds.
@@ -824,6 +950,17 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
          */
         QList<QueryExecutor::ResultRowIdColumnPtr> getRowIdResultColumns() const;
 
+        /**
+         * @brief Gets alias of the result column used as a key for keyset paging.
+         * @return Result column alias, or null string if recent execution did not use keyset paging.
+         *
+         * Value of this column in the last row of the page should be passed to setPageSeekKey()
+         * for the next page, so the next page can be queried without OFFSET.
+         *
+         * See Context::keysetColumnAlias for details.
+         */
+        QString getKeysetColumnAlias() const;
+
         /**
          * @brief Gives number of meta columns in the executed query.
          * @return Number of the actual meta columns (such as ROWID columns) added to the executed query.
@@ -1015,6 +1152,52 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
          */
         void setSortOrder(const QueryExecutor::SortList& value);
 
+        /**
+         * @brief Tests if keyset paging is enabled.
+         * @return true if pages are queried by the key of the row preceding the page, or false otherwise.
+         */
+        bool getKeysetPaging() const;
+
+        /**
+         * @brief Enables or disables keyset paging.
+         * @param value true to enable keyset paging.
+         *
+         * With keyset paging enabled, a page of results is queried with "WHERE key > ? ORDER BY key LIMIT n"
+         * instead of "LIMIT n OFFSET m", as long as the key of the last row of the preceding page is known
+         * (see setPageSeekKey()). This way SQLite seeks directly to the page, instead of reading and dropping
+         * all rows of preceding pages. If the key for requested page is not known, the nearest preceding page
+         * with known key is used and the remaining distance is covered with OFFSET.
+         *
+         * Keyset paging is applied only if the query has a single, single-column ROWID
+         * (see Context::rowIdColumns) and no sorting is defined (see setSortOrder()).
+         * Otherwise the regular LIMIT/OFFSET paging is used.
+         */
+        void setKeysetPaging(bool value);
+
+        /**
+         * @brief Remembers key value that the given page starts after.
+         * @param page 0-based page index.
+         * @param key Value of the key column (see getKeysetColumnAlias()) of the last row of the preceding page.
+         */
+        void setPageSeekKey(int page, const QVariant& key);
+
+        /**
+         * @brief Forgets all keys remembered with setPageSeekKey().
+         *
+         * This should be called when rows were inserted or deleted, so page boundaries might have moved.
+         * Keys are also forgotten automatically when the query, its parameters or number of rows per page change.
+         */
+        void clearPageSeekKeys();
+
+        /**
+         * @brief Finds the nearest page with known seek key.
+         * @param page Requested 0-based page index.
+         * @param seekPage The page with known seek key, that is not greater than requested page.
+         * @param key Seek key of the seekPage.
+         * @return true if any page was found, or false if no seek key is known for the page and pages preceding it.
+         */
+        bool findPageSeekKey(int page, int& seekPage, QVariant& key) const;
+
         /**
          * @brief Tests if row counting is disabled.
          * @return true if row counting will be skipped, or false otherwise.
@@ -1222,6 +1405,27 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
          */
         bool handleRowCountingResults(quint32 asyncId, SqlQueryPtr results);
 
+        /**
+         * @brief Stores number of rows counted by the counting query and reports it.
+         * @param results Results from the counting query execution.
+         *
+         * In RowCounting::PROGRESSIVE mode, if there are more rows than counted, this method
+         * starts the next counting round with higher limit before reporting partial results.
+         */
+        void applyRowCountingResults(SqlQueryPtr results);
+
+        /**
+         * @brief Reports number of rows taken from sqlite_stat1.
+         * @return true if the estimation was available and reported, or false otherwise.
+         */
+        bool estimateRowCount();
+
+        /**
+         * @brief Provides counting query for current Context::countingLimit.
+         * @return Counting query.
+         */
+        QString getLimitedCountingQuery() const;
+
         QStringList applyLimitForSimpleMethod(const QStringList &queries);
 
         /**
@@ -1231,6 +1435,13 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
          */
         QList<QueryExecutorStep*> createSteps(StepPosition position);
 
+        /**
+         * @brief Tells if any additional steps (stateless or from factories) are registered for given position.
+         * @param position Position to check.
+         * @return true if there is at least one additional step for the position.
+         */
+        bool hasAdditionalSteps(StepPosition position) const;
+
         /**
          * @brief Query executor context object.
          *
@@ -1297,6 +1508,21 @@ class API_EXPORT QueryExecutor : public QObject, public QRunnable
          */
         SortList sortOrder;
 
+        /**
+         * @brief Keyset paging flag.
+         *
+         * See setKeysetPaging() for details.
+         */
+        bool keysetPaging = false;
+
+        /**
+         * @brief Sparse index of page starting keys.
+         *
+         * Maps page index to the key value of the last row of the preceding page.
+         * See setPageSeekKey() for details.
+         */
+        QMap<int,QVariant> pageSeekKeys;
+
         /**
          * @brief Flag indicating that the execution is currently in progress.
          *
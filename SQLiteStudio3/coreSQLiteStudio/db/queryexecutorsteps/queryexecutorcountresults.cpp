@@ -14,9 +14,43 @@ bool QueryExecutorCountResults::exec()
         return true;
     }
 
-    QString countSql = "SELECT count(*) AS cnt FROM ("+select->detokenize()+");";
+    context->countedQuery = select->detokenize();
+    QString countSql = "SELECT count(*) AS cnt FROM ("+context->countedQuery+");";
     context->countingQuery = countSql;
 
+    QString database;
+    QString table;
+    if (isWholeTableRead(select.data(), database, table))
+    {
+        context->estimationDatabase = database;
+        context->estimationTable = table;
+    }
+
     // qDebug() << "count sql:" << countSql;
     return true;
 }
+
+bool QueryExecutorCountResults::isWholeTableRead(SqliteSelect* select, QString& database, QString& table)
+{
+    if (select->with || select->coreSelects.size() != 1)
+        return false;
+
+    SqliteSelect::Core* core = select->coreSelects.first();
+    if (core->valuesMode || core->distinctKw || core->where || core->having || core->groupBy.size() > 0 || core->limit)
+        return false;
+
+    if (!core->from || !core->from->singleSource || core->from->otherSources.size() > 0)
+        return false;
+
+    // Previous steps wrap the query with "SELECT ... FROM (query)", so the table is usually nested
+    SqliteSelect::Core::SingleSource* source = core->from->singleSource;
+    if (source->select)
+        return isWholeTableRead(source->select, database, table);
+
+    if (source->joinSource || source->table.isNull() || !source->funcName.isNull())
+        return false;
+
+    database = source->database;
+    table = source->table;
+    return true;
+}
@@ -6,6 +6,9 @@
 /**
  * @brief Defines counting query string.
  *
+ * It also detects queries that read all rows of a single table, so their number of rows
+ * can be estimated without counting (see QueryExecutor::RowCounting::ESTIMATED).
+ *
  * @see QueryExecutor::countResults()
  */
 class QueryExecutorCountResults : public QueryExecutorStep
@@ -14,6 +17,9 @@ class QueryExecutorCountResults : public QueryExecutorStep
 
     public:
         bool exec();
+
+    private:
+        static bool isWholeTableRead(SqliteSelect* select, QString& database, QString& table);
 };
 
 #endif // QUERYEXECUTORCOUNTRESULTS_H
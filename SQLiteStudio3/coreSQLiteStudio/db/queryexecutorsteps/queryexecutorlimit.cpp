@@ -1,5 +1,6 @@
 #include "queryexecutorlimit.h"
 #include "parser/ast/sqlitelimit.h"
+#include "common/global.h"
 #include <QDebug>
 
 bool QueryExecutorLimit::exec()
@@ -16,15 +17,82 @@ bool QueryExecutorLimit::exec()
         return true; // shouldn't happen, but if happens, quit gracefully
 
     quint64 limit = queryExecutor->getResultsPerPage();
-    quint64 offset = limit * page;
 
-    // The original query is last, so if it contained any %N strings,
-    // they won't be replaced.
-    static_qstring(selectTpl, "SELECT * FROM (%1) LIMIT %2 OFFSET %3");
-    QString newSelect = selectTpl.arg(select->detokenize(), QString::number(limit), QString::number(offset));
+    // SELECT * FROM (...) [WHERE key > :seekKey ORDER BY key] LIMIT %1 OFFSET %2
+    // Tokens are wrapped directly, so the query doesn't need to be parsed again.
+    TokenList resultColumns;
+    resultColumns << TokenPtr::create(Token::OPERATOR, "*");
 
-    int begin = select->tokens.first()->start;
-    int length = select->tokens.last()->end - select->tokens.first()->start + 1;
-    context->processedQuery = context->processedQuery.replace(begin, length, newSelect);
+    TokenList tokens = wrapSelect(select->tokens, resultColumns);
+
+    int offsetPages = page;
+    QString keyAlias = getKeysetColumnAlias();
+    if (!keyAlias.isNull())
+    {
+        tokens += getKeysetTokens(keyAlias, page, offsetPages);
+        context->keysetColumnAlias = keyAlias;
+    }
+
+    tokens << TokenPtr::create(Token::SPACE, " ")
+           << TokenPtr::create(Token::KEYWORD, "LIMIT")
+           << TokenPtr::create(Token::SPACE, " ")
+           << TokenPtr::create(Token::INTEGER, QString::number(limit))
+           << TokenPtr::create(Token::SPACE, " ")
+           << TokenPtr::create(Token::KEYWORD, "OFFSET")
+           << TokenPtr::create(Token::SPACE, " ")
+           << TokenPtr::create(Token::INTEGER, QString::number(limit * offsetPages));
+
+    select->tokens = tokens;
+    updateQueries();
     return true;
 }
+
+QString QueryExecutorLimit::getKeysetColumnAlias()
+{
+    if (!queryExecutor->getKeysetPaging())
+        return QString();
+
+    if (queryExecutor->getSortOrder().size() > 0)
+        return QString(); // rows are not ordered by the key
+
+    if (context->rowIdColumns.size() != 1)
+        return QString();
+
+    QueryExecutor::ResultRowIdColumnPtr rowIdCol = context->rowIdColumns.first();
+    if (rowIdCol->queryExecutorAliasToColumn.size() != 1)
+        return QString(); // multi-column primary key of WITHOUT ROWID table
+
+    return rowIdCol->queryExecutorAliasToColumn.keys().first();
+}
+
+TokenList QueryExecutorLimit::getKeysetTokens(const QString& keyAlias, int page, int& offsetPages)
+{
+    static_qstring(seekKeyParam, ":sqlitestudio_page_seek_key");
+
+    TokenList tokens;
+    int seekPage;
+    QVariant seekKey;
+    if (queryExecutor->findPageSeekKey(page, seekPage, seekKey))
+    {
+        tokens << TokenPtr::create(Token::SPACE, " ")
+               << TokenPtr::create(Token::KEYWORD, "WHERE")
+               << TokenPtr::create(Token::SPACE, " ")
+               << TokenPtr::create(Token::OTHER, keyAlias)
+               << TokenPtr::create(Token::SPACE, " ")
+               << TokenPtr::create(Token::OPERATOR, ">")
+               << TokenPtr::create(Token::SPACE, " ")
+               << TokenPtr::create(Token::BIND_PARAM, seekKeyParam);
+
+        context->queryParameters[seekKeyParam] = seekKey;
+        offsetPages = page - seekPage;
+    }
+
+    tokens << TokenPtr::create(Token::SPACE, " ")
+           << TokenPtr::create(Token::KEYWORD, "ORDER")
+           << TokenPtr::create(Token::SPACE, " ")
+           << TokenPtr::create(Token::KEYWORD, "BY")
+           << TokenPtr::create(Token::SPACE, " ")
+           << TokenPtr::create(Token::OTHER, keyAlias);
+
+    return tokens;
+}
@@ -10,6 +10,10 @@
  * and QueryExecutor::Context::setResultsPerPage), then the SELECT query
  * is wrapped with another SELECT which defines it's own LIMIT and OFFSET
  * basing on the page and the results per page parameters.
+ *
+ * If keyset paging is enabled (QueryExecutor::setKeysetPaging()) and the query allows it,
+ * then the wrapping SELECT is ordered by the ROWID column and starts right after
+ * the nearest known page seek key, so the OFFSET is only used for pages without known key.
  */
 class QueryExecutorLimit : public QueryExecutorStep
 {
@@ -17,6 +21,10 @@ class QueryExecutorLimit : public QueryExecutorStep
 
     public:
         bool exec();
+
+    private:
+        QString getKeysetColumnAlias();
+        TokenList getKeysetTokens(const QString& keyAlias, int page, int& offsetPages);
 };
 
 #endif // QUERYEXECUTORLIMIT_H
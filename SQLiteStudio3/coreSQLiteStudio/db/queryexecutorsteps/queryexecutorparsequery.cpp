@@ -17,6 +17,10 @@ QueryExecutorParseQuery::~QueryExecutorParseQuery()
 
 bool QueryExecutorParseQuery::exec()
 {
+    // Nothing has changed since the last parsing, so parsed queries are up to date.
+    if (!context->parsedQueries.isEmpty() && context->processedQuery == context->lastParsedQuery)
+        return true;
+
     // Prepare parser
     if (parser)
         delete parser;
@@ -40,6 +44,7 @@ bool QueryExecutorParseQuery::exec()
     }
 
     context->parsedQueries = parser->getQueries();
+    context->lastParsedQuery = context->processedQuery;
 
     // We never want the semicolon in last query, because the query could be wrapped with a SELECT
     context->parsedQueries.last()->tokens.trimRight(Token::OPERATOR, ";");
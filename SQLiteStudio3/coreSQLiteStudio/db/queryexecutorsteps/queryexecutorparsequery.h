@@ -10,7 +10,8 @@
  * in QueryExecutor::Context::parsedQueries.
  *
  * This is used after some changes were made to the query and next steps will
- * require parsed representation of queries to be updated.
+ * require parsed representation of queries to be updated. If the query was not
+ * modified since it was parsed last time, the parsing is skipped.
  */
 class QueryExecutorParseQuery : public QueryExecutorStep
 {
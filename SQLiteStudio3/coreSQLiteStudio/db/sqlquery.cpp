@@ -34,6 +34,41 @@ bool SqlQuery::hasNext()
     return hasNextInternal();
 }
 
+int SqlQuery::nextBatch(int maxRows, SqlResultsBlock& block)
+{
+    if (!preloaded)
+        return nextBatchInternal(maxRows, block);
+
+    block.reset(getResultColumns());
+    while (block.rowCount() < maxRows && preloadedRowIdx < preloadedData.size())
+        block.appendRow(preloadedData[preloadedRowIdx++]->valueList());
+
+    return block.rowCount();
+}
+
+int SqlQuery::nextBatchInternal(int maxRows, SqlResultsBlock& block)
+{
+    block.reset(getResultColumns());
+    SqlResultsRowPtr row;
+    while (block.rowCount() < maxRows && hasNextInternal())
+    {
+        row = nextInternal();
+        if (!row)
+            break;
+
+        block.appendRow(row->valueList());
+    }
+    return block.rowCount();
+}
+
+SqlResultsColumnsPtr SqlQuery::getResultColumns()
+{
+    if (!resultColumns)
+        resultColumns = SqlResultsColumnsPtr(new SqlResultsColumns(getColumnNames()));
+
+    return resultColumns;
+}
+
 qint64 SqlQuery::rowsAffected()
 {
     return affected;
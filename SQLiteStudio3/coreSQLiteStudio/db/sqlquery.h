@@ -105,6 +105,20 @@ class API_EXPORT SqlQuery
          */
         bool hasNext();
 
+        /**
+         * @brief Reads block of next rows.
+         * @param maxRows Maximum number of rows to read.
+         * @param block Block to fill with rows. Any rows that were in the block before are removed.
+         * @return Number of rows read into the block. Zero means that there are no more rows available.
+         *
+         * This is an alternative to next() for reading big results. Rows are read into a flat storage
+         * of the block, instead of allocating separate row object for each row. Pass the same block
+         * object to consecutive calls, so its memory gets reused.
+         *
+         * Calls to next() and nextBatch() can be mixed, they both advance the same results cursor.
+         */
+        int nextBatch(int maxRows, SqlResultsBlock& block);
+
         /**
          * @brief Gets error test of the most recent error.
          * @return Error text.
@@ -123,6 +137,12 @@ class API_EXPORT SqlQuery
          */
         virtual QStringList getColumnNames() = 0;
 
+        /**
+         * @brief Gets column names lookup table shared by all rows of the results.
+         * @return Lookup table of column names.
+         */
+        SqlResultsColumnsPtr getResultColumns();
+
         /**
          * @brief Gets number of columns in the results.
          * @return Columns count.
@@ -268,6 +288,18 @@ class API_EXPORT SqlQuery
          */
         virtual bool hasNextInternal() = 0;
 
+        /**
+         * @brief Reads block of next rows.
+         * @param maxRows Maximum number of rows to read.
+         * @param block Block to fill.
+         * @return Number of rows read.
+         *
+         * This is pretty much the same as nextBatch(), except nextBatch() handles preloaded data.
+         * Default implementation reads rows one by one with nextInternal(). Derived implementations
+         * should reimplement it to fill the block directly from the database driver.
+         */
+        virtual int nextBatchInternal(int maxRows, SqlResultsBlock& block);
+
         virtual bool execInternal(const QList<QVariant>& args) = 0;
         virtual bool execInternal(const QHash<QString, QVariant>& args) = 0;
 
@@ -294,6 +326,14 @@ class API_EXPORT SqlQuery
          */
         QList<SqlResultsRowPtr> preloadedData;
 
+        /**
+         * @brief Column names lookup table shared by all rows of the results.
+         *
+         * Derived implementations should set it each time the query is executed.
+         * If it's not set, it will be created from getColumnNames() when needed.
+         */
+        SqlResultsColumnsPtr resultColumns;
+
         int affected = 0;
 
         QString query;
@@ -1,5 +1,28 @@
 #include "sqlresultsrow.h"
 
+SqlResultsColumns::SqlResultsColumns(const QStringList& names) :
+    names(names)
+{
+    indexes.reserve(names.size());
+    for (int i = 0; i < names.size(); i++)
+        indexes[names[i]] = i;
+}
+
+int SqlResultsColumns::indexOf(const QString& name) const
+{
+    return indexes.value(name, -1);
+}
+
+const QStringList& SqlResultsColumns::getNames() const
+{
+    return names;
+}
+
+int SqlResultsColumns::count() const
+{
+    return names.size();
+}
+
 SqlResultsRow::SqlResultsRow()
 {
 }
@@ -10,12 +33,25 @@ SqlResultsRow::~SqlResultsRow()
 
 const QVariant SqlResultsRow::value(const QString &key) const
 {
-    return valuesMap[key];
+    if (!columns)
+        return QVariant();
+
+    return value(columns->indexOf(key));
 }
 
-const QHash<QString, QVariant> &SqlResultsRow::valueMap() const
+QHash<QString, QVariant> SqlResultsRow::valueMap() const
 {
-    return valuesMap;
+    QHash<QString, QVariant> map;
+    if (!columns)
+        return map;
+
+    const QStringList& names = columns->getNames();
+    int cnt = qMin(names.size(), values.size());
+    map.reserve(cnt);
+    for (int i = 0; i < cnt; i++)
+        map[names[i]] = values[i];
+
+    return map;
 }
 
 const QList<QVariant>& SqlResultsRow::valueList() const
@@ -33,10 +69,105 @@ const QVariant SqlResultsRow::value(int idx) const
 
 bool SqlResultsRow::contains(const QString &key) const
 {
-    return valuesMap.contains(key);
+    return columns && contains(columns->indexOf(key));
 }
 
 bool SqlResultsRow::contains(int idx) const
 {
     return idx >= 0 && idx < values.size();
 }
+
+void SqlResultsBlock::reset(const SqlResultsColumnsPtr& columns)
+{
+    this->columns = columns;
+    colCount = columns ? columns->count() : 0;
+    rows = 0;
+}
+
+void SqlResultsBlock::appendRow(const QList<QVariant>& rowValues)
+{
+    QVariant* rowPtr = appendRow();
+    int cnt = qMin(colCount, rowValues.size());
+    for (int i = 0; i < cnt; i++)
+        rowPtr[i] = rowValues[i];
+
+    for (int i = cnt; i < colCount; i++)
+        rowPtr[i] = QVariant();
+}
+
+QVariant* SqlResultsBlock::appendRow()
+{
+    int requiredSize = (rows + 1) * colCount;
+    if (values.size() < requiredSize)
+        values.resize(requiredSize);
+
+    return values.data() + (rows++ * colCount);
+}
+
+QVariant SqlResultsBlock::value(int row, int col) const
+{
+    if (row < 0 || row >= rows || col < 0 || col >= colCount)
+        return QVariant();
+
+    return values[row * colCount + col];
+}
+
+QVariant SqlResultsBlock::value(int row, const QString& columnName) const
+{
+    if (!columns)
+        return QVariant();
+
+    return value(row, columns->indexOf(columnName));
+}
+
+QList<QVariant> SqlResultsBlock::rowValues(int row) const
+{
+    QList<QVariant> list;
+    if (row < 0 || row >= rows)
+        return list;
+
+    list.reserve(colCount);
+    const QVariant* rowPtr = values.constData() + row * colCount;
+    for (int i = 0; i < colCount; i++)
+        list << rowPtr[i];
+
+    return list;
+}
+
+int SqlResultsBlock::rowCount() const
+{
+    return rows;
+}
+
+int SqlResultsBlock::columnCount() const
+{
+    return colCount;
+}
+
+bool SqlResultsBlock::isEmpty() const
+{
+    return rows == 0;
+}
+
+SqlResultsColumnsPtr SqlResultsBlock::getColumns() const
+{
+    return columns;
+}
+
+void SqlResultsBlockRow::load(const SqlResultsBlock& block, int row)
+{
+    columns = block.getColumns();
+    int colCount = block.columnCount();
+    if (values.size() != colCount)
+    {
+        values.clear();
+        values.reserve(colCount);
+        for (int i = 0; i < colCount; i++)
+            values << block.value(row, i);
+
+        return;
+    }
+
+    for (int i = 0; i < colCount; i++)
+        values[i] = block.value(row, i);
+}
@@ -5,10 +5,58 @@
 #include <QVariant>
 #include <QList>
 #include <QHash>
+#include <QVector>
+#include <QStringList>
 #include <QSharedPointer>
 
 /** @file */
 
+/**
+ * @brief Column names of SQL query results.
+ *
+ * It's a name to index lookup table, created once per executed query and shared by all rows
+ * (and blocks of rows) read from that query, so rows don't need to keep their own copy of column names.
+ *
+ * If the same name is used by more than one column, then the name resolves to the last of them.
+ */
+class API_EXPORT SqlResultsColumns
+{
+    public:
+        /**
+         * @brief Creates lookup table for given column names.
+         * @param names Column names in order they appear in the results.
+         */
+        explicit SqlResultsColumns(const QStringList& names);
+
+        /**
+         * @brief Finds index of the column.
+         * @param name Column name. Case sensitive.
+         * @return 0-based index of the column, or -1 if there is no such column.
+         */
+        int indexOf(const QString& name) const;
+
+        /**
+         * @brief Provides column names.
+         * @return Column names in order they appear in the results.
+         */
+        const QStringList& getNames() const;
+
+        /**
+         * @brief Provides number of columns.
+         * @return Number of columns.
+         */
+        int count() const;
+
+    private:
+        QStringList names;
+        QHash<QString,int> indexes;
+};
+
+/**
+ * @brief Shared pointer to column names lookup table.
+ */
+typedef QSharedPointer<const SqlResultsColumns> SqlResultsColumnsPtr;
+
 /**
  * @brief SQL query results row.
  *
@@ -51,8 +99,10 @@ class API_EXPORT SqlResultsRow
          * Note, that QHash doesn't guarantee order of entries. If you want to iterate through columns
          * in order they were returned from the database, use valueList(), or iterate through SqlResults::getColumnNames()
          * and use it to call value().
+         *
+         * The hash table is built upon each call, so prefer value() when you need just several columns.
          */
-        const QHash<QString, QVariant>& valueMap() const;
+        QHash<QString, QVariant> valueMap() const;
 
         /**
          * @brief Gets list of values in this row.
@@ -80,16 +130,15 @@ class API_EXPORT SqlResultsRow
         SqlResultsRow();
 
         /**
-         * @brief Columns and their values in the row.
+         * @brief Column names lookup table, shared by all rows of the same query results.
          */
-        QHash<QString,QVariant> valuesMap;
+        SqlResultsColumnsPtr columns;
+
         /**
          * @brief Ordered list of values in the row.
          *
-         * Technical note:
-         * We keep list of values next to valuesMap, so we have it in the same order as column names when asked by valueList().
-         * This looks like having redundant data storage, but Qt container classes (such as QVariant)
-         * use smart pointers to keep their data internally, so here we actually keep only reference objects.
+         * Values are in the same order as column names in #columns. Values are looked up by column name
+         * through the shared #columns table, so the row doesn't need its own name to value map.
          */
         QList<QVariant> values;
 };
@@ -99,4 +148,112 @@ class API_EXPORT SqlResultsRow
  */
 typedef QSharedPointer<SqlResultsRow> SqlResultsRowPtr;
 
+/**
+ * @brief Block of SQL query results rows.
+ *
+ * It's filled by SqlQuery::nextBatch() and it keeps values of multiple rows in a single flat vector,
+ * so reading big results doesn't require allocating an object per each row.
+ * The same block object is meant to be reused for consecutive calls to SqlQuery::nextBatch(),
+ * so the memory allocated for values is reused as well.
+ *
+ * Typical usage:
+ * @code
+ * SqlQueryPtr results = db->exec("SELECT * FROM table");
+ * SqlResultsBlock block;
+ * while (results->nextBatch(1000, block) > 0)
+ * {
+ *     for (int row = 0; row < block.rowCount(); row++)
+ *         qDebug() << block.value(row, "column");
+ * }
+ * @endcode
+ */
+class API_EXPORT SqlResultsBlock
+{
+    public:
+        /**
+         * @brief Removes all rows from the block, keeping allocated memory.
+         * @param columns Column names lookup table for rows that will be added next.
+         */
+        void reset(const SqlResultsColumnsPtr& columns);
+
+        /**
+         * @brief Appends row to the block.
+         * @param rowValues Values of the row. Expected to have as many values as there are columns.
+         *
+         * Missing values are filled with invalid QVariant and excessive values are ignored.
+         */
+        void appendRow(const QList<QVariant>& rowValues);
+
+        /**
+         * @brief Appends row to the block and provides pointer to its values.
+         * @return Pointer to the first value of the new row. There is columnCount() values available.
+         *
+         * This is useful for drivers that want to write values directly into the block.
+         */
+        QVariant* appendRow();
+
+        /**
+         * @brief Gets value of the cell.
+         * @param row 0-based row index in this block.
+         * @param col 0-based column index.
+         * @return Value of the cell, or invalid QVariant if indexes were out of range.
+         */
+        QVariant value(int row, int col) const;
+
+        /**
+         * @brief Gets value of the cell.
+         * @param row 0-based row index in this block.
+         * @param columnName Column name. Case sensitive.
+         * @return Value of the cell, or invalid QVariant if there is no such row or column.
+         */
+        QVariant value(int row, const QString& columnName) const;
+
+        /**
+         * @brief Provides values of a single row as a list.
+         * @param row 0-based row index in this block.
+         * @return Ordered list of values in the row.
+         */
+        QList<QVariant> rowValues(int row) const;
+
+        int rowCount() const;
+        int columnCount() const;
+        bool isEmpty() const;
+        SqlResultsColumnsPtr getColumns() const;
+
+    private:
+        SqlResultsColumnsPtr columns;
+        int colCount = 0;
+        int rows = 0;
+
+        /**
+         * @brief All values of all rows in the block, row after row.
+         *
+         * The vector is never shrunk by reset(), so its capacity stays allocated for the next batch.
+         */
+        QVector<QVariant> values;
+};
+
+/**
+ * @brief SQL query results row loaded from a block of rows.
+ *
+ * It lets code that reads results with SqlQuery::nextBatch() pass rows to API expecting SqlResultsRowPtr,
+ * without allocating a row object per each row. The same object is reloaded with consecutive rows of the block,
+ * so its values are valid only until the next call to load().
+ */
+class API_EXPORT SqlResultsBlockRow : public SqlResultsRow
+{
+    public:
+        /**
+         * @brief Loads values of the row from the block.
+         * @param block Block to read values from.
+         * @param row 0-based row index in the block.
+         */
+        void load(const SqlResultsBlock& block, int row);
+};
+
+/**
+ * @brief Shared pointer to SQL query results row loaded from a block.
+ */
+typedef QSharedPointer<SqlResultsBlockRow> SqlResultsBlockRowPtr;
+
 #endif // SQLRESULTSROW_H
@@ -19,6 +19,7 @@
         static const int BUSY = UppercasePrefix##SQLITE_BUSY; \
         static const int ROW = UppercasePrefix##SQLITE_ROW; \
         static const int DONE = UppercasePrefix##SQLITE_DONE; \
+        static const int SCHEMA = UppercasePrefix##SQLITE_SCHEMA; \
         \
         typedef Prefix##sqlite3 handle; \
         typedef Prefix##sqlite3_stmt stmt; \
@@ -68,12 +69,15 @@
         static int last_insert_rowid(handle* arg) {return Prefix##sqlite3_last_insert_rowid(arg);} \
         static int step(stmt* arg) {return Prefix##sqlite3_step(arg);} \
         static int reset(stmt* arg) {return Prefix##sqlite3_reset(arg);} \
+        static int clear_bindings(stmt* arg) {return Prefix##sqlite3_clear_bindings(arg);} \
         static int close(handle* arg) {return Prefix##sqlite3_close(arg);} \
         static void free(void* arg) {return Prefix##sqlite3_free(arg);} \
         static int enable_load_extension(handle* arg1, int arg2) {return Prefix##sqlite3_enable_load_extension(arg1, arg2);} \
         static int load_extension(handle *arg1, const char *arg2, const char *arg3, char **arg4) {return Prefix##sqlite3_load_extension(arg1, arg2, arg3, arg4);} \
         static void* user_data(context* arg) {return Prefix##sqlite3_user_data(arg);} \
         static void* aggregate_context(context* arg1, int arg2) {return Prefix##sqlite3_aggregate_context(arg1, arg2);} \
+        static void* get_auxdata(context* arg1, int arg2) {return Prefix##sqlite3_get_auxdata(arg1, arg2);} \
+        static void set_auxdata(context* arg1, int arg2, void* arg3, void(*arg4)(void*)) {Prefix##sqlite3_set_auxdata(arg1, arg2, arg3, arg4);} \
         static int collation_needed(handle* a1, void* a2, void(*a3)(void*,handle*,int eTextRep,const char*)) {return Prefix##sqlite3_collation_needed(a1, a2, a3);} \
         static int prepare_v2(handle *a1, const char *a2, int a3, stmt **a4, const char **a5) {return Prefix##sqlite3_prepare_v2(a1, a2, a3, a4, a5);} \
         static int create_function(handle *a1, const char *a2, int a3, int a4, void *a5, void (*a6)(context*,int,value**), void (*a7)(context*,int,value**), void (*a8)(context*)) \
@@ -0,0 +1,151 @@
+#include "exportoutputwriter.h"
+#include <QIODevice>
+#include <QTextCodec>
+#include <QDebug>
+
+ExportOutputWriter::ExportOutputWriter(QIODevice* output, QTextCodec* codec) :
+    output(output)
+{
+    // MIB 106 is UTF-8
+    if (codec && codec->mibEnum() != 106)
+        encoder = codec->makeEncoder();
+
+    buffer.reserve(BUFFER_SIZE);
+}
+
+ExportOutputWriter::~ExportOutputWriter()
+{
+    delete encoder;
+}
+
+void ExportOutputWriter::write(const QString& str)
+{
+    if (encoder)
+        buffer.append(encoder->fromUnicode(str));
+    else
+        appendUtf8(str.constData(), str.size());
+
+    flushIfFull();
+}
+
+void ExportOutputWriter::writeln(const QString& str)
+{
+    static const QChar newLine = QLatin1Char('\n');
+    if (encoder)
+    {
+        buffer.append(encoder->fromUnicode(str));
+        buffer.append(encoder->fromUnicode(&newLine, 1));
+    }
+    else
+    {
+        appendUtf8(str.constData(), str.size());
+        appendUtf8(&newLine, 1);
+    }
+
+    flushIfFull();
+}
+
+bool ExportOutputWriter::flush()
+{
+    if (pendingHighSurrogate)
+    {
+        // Nothing more is coming to pair it with
+        buffer.append('?');
+        pendingHighSurrogate = 0;
+    }
+
+    return writeBuffer();
+}
+
+bool ExportOutputWriter::writeBuffer()
+{
+    if (!buffer.isEmpty())
+    {
+        if (output->write(buffer) != buffer.size())
+        {
+            qWarning() << "Could not write export output:" << output->errorString();
+            writeFailed = true;
+        }
+
+        // Resizing (instead of clearing) keeps the reserved memory for the next block
+        buffer.resize(0);
+    }
+
+    return !writeFailed;
+}
+
+void ExportOutputWriter::appendUtf8(const QChar* data, int size)
+{
+    // Single UTF-16 unit takes up to 3 bytes and surrogate pair (2 units) takes 4 bytes.
+    // The high surrogate left from the previous call may be completed with the first unit, which gives 4 bytes for 1 unit.
+    int pos = buffer.size();
+    buffer.resize(pos + size * 3 + 4);
+
+    uchar* begin = reinterpret_cast<uchar*>(buffer.data());
+    uchar* out = begin + pos;
+    const ushort* in = reinterpret_cast<const ushort*>(data);
+    const ushort* end = in + size;
+    uint ch;
+    while (in < end)
+    {
+        if (pendingHighSurrogate)
+        {
+            // Surrogate pair split between two strings is completed with the first unit of the current string
+            ch = pendingHighSurrogate;
+            pendingHighSurrogate = 0;
+        }
+        else
+        {
+            ch = *in++;
+        }
+
+        if (ch < 0x80)
+        {
+            *out++ = static_cast<uchar>(ch);
+            continue;
+        }
+
+        if (ch < 0x800)
+        {
+            *out++ = static_cast<uchar>(0xc0 | (ch >> 6));
+            *out++ = static_cast<uchar>(0x80 | (ch & 0x3f));
+            continue;
+        }
+
+        if (QChar::isSurrogate(ch))
+        {
+            if (QChar::isHighSurrogate(ch) && in == end)
+            {
+                // Low surrogate may come with the next string
+                pendingHighSurrogate = static_cast<ushort>(ch);
+                break;
+            }
+
+            if (QChar::isHighSurrogate(ch) && QChar::isLowSurrogate(*in))
+            {
+                ch = QChar::surrogateToUcs4(static_cast<ushort>(ch), *in++);
+                *out++ = static_cast<uchar>(0xf0 | (ch >> 18));
+                *out++ = static_cast<uchar>(0x80 | ((ch >> 12) & 0x3f));
+                *out++ = static_cast<uchar>(0x80 | ((ch >> 6) & 0x3f));
+                *out++ = static_cast<uchar>(0x80 | (ch & 0x3f));
+                continue;
+            }
+
+            // Unpaired surrogate cannot be encoded. It's replaced the same way as QTextCodec does it.
+            *out++ = '?';
+            continue;
+        }
+
+        *out++ = static_cast<uchar>(0xe0 | (ch >> 12));
+        *out++ = static_cast<uchar>(0x80 | ((ch >> 6) & 0x3f));
+        *out++ = static_cast<uchar>(0x80 | (ch & 0x3f));
+    }
+
+    buffer.resize(static_cast<int>(out - begin));
+}
+
+void ExportOutputWriter::flushIfFull()
+{
+    if (buffer.size() >= BUFFER_SIZE)
+        writeBuffer();
+}
@@ -0,0 +1,64 @@
+#ifndef EXPORTOUTPUTWRITER_H
+#define EXPORTOUTPUTWRITER_H
+
+#include "coreSQLiteStudio_global.h"
+#include <QByteArray>
+
+class QIODevice;
+class QTextCodec;
+class QTextEncoder;
+
+/**
+ * @brief Encodes exported text and writes it to the output device in big blocks.
+ *
+ * Export plugins produce lots of small strings (single values, separators, line ends). Each of them
+ * used to be encoded into a new QByteArray and written to the device separately. The writer encodes
+ * strings directly into a single reusable buffer and passes it to the device only once it gets full,
+ * or when flush() is called.
+ *
+ * When the codec is UTF-8 (or no codec is given), strings are encoded by the writer itself, with no QTextCodec involved.
+ * For any other codec the stateful QTextEncoder is used, so the byte order mark (if the codec uses one)
+ * is written only once, at the beginning of the output.
+ *
+ * Surrogate pair split between two consecutive strings is encoded as a single character, just like the encoder would do it.
+ *
+ * Nothing is written to the device when the writer is deleted. The flush() has to be called at the end of the export.
+ */
+class API_EXPORT ExportOutputWriter
+{
+        Q_DISABLE_COPY(ExportOutputWriter)
+
+    public:
+        ExportOutputWriter(QIODevice* output, QTextCodec* codec);
+        ~ExportOutputWriter();
+
+        void write(const QString& str);
+        void writeln(const QString& str);
+
+        /**
+         * @brief Writes all buffered data to the output device.
+         * @return true on success, or false if the device did not accept all the data.
+         */
+        bool flush();
+
+    private:
+        void appendUtf8(const QChar* data, int size);
+        void flushIfFull();
+        bool writeBuffer();
+
+        static const int BUFFER_SIZE = 256 * 1024;
+
+        QIODevice* output = nullptr;
+        QTextEncoder* encoder = nullptr;
+        QByteArray buffer;
+        bool writeFailed = false;
+
+        /**
+         * @brief High surrogate that ended the last string, waiting for the low surrogate from the next string.
+         *
+         * It's 0 if there is no such surrogate.
+         */
+        ushort pendingHighSurrogate = 0;
+};
+
+#endif // EXPORTOUTPUTWRITER_H
@@ -4,7 +4,10 @@
 #include "services/notifymanager.h"
 #include "common/utils_sql.h"
 #include "common/utils.h"
+#include "common/unused.h"
 #include "db/sqlresultsrow.h"
+#include "plugins/dbplugin.h"
+#include "services/pluginmanager.h"
 #include <QMutexLocker>
 #include <QDebug>
 
@@ -26,6 +29,10 @@ void ExportWorker::run()
 {
     qDebug() << "ExportWorker thread started. Export mode: " << static_cast<int>(exportMode);
     bool res = false;
+    sourceDb = db;
+    if (config->consistentSnapshot && (exportMode == ExportManager::DATABASE || exportMode == ExportManager::TABLE))
+        beginSnapshot();
+
     switch (exportMode)
     {
         case ExportManager::QUERY_RESULTS:
@@ -52,6 +59,15 @@ void ExportWorker::run()
             break;
     }
 
+    stopTableReaders();
+    endSnapshot();
+
+    if (!plugin->flushOutput() && res)
+    {
+        logExportFail("flushOutput()");
+        res = false;
+    }
+
     plugin->cleanupAfterExport();
 
     emit finished(res, output);
@@ -94,6 +110,12 @@ void ExportWorker::interrupt()
     interrupted = true;
     if (executor->isExecutionInProgress())
         executor->interrupt();
+
+    for (ExportTableData* tableData : tableReadAheadList)
+        tableData->rowBlocks.abort();
+
+    for (ExportTableReader* reader : tableReaders)
+        reader->interruptReading();
 }
 
 bool ExportWorker::exportQueryResults()
@@ -141,14 +163,18 @@ bool ExportWorker::exportQueryResults()
         return false;
     }
 
-    SqlResultsRowPtr row;
-    while (results->hasNext())
+    SqlResultsBlock block;
+    SqlResultsBlockRowPtr row(new SqlResultsBlockRow());
+    while (results->nextBatch(ROWS_PER_BATCH, block) > 0)
     {
-        row = results->next();
-        if (!plugin->exportQueryResultsRow(row))
+        for (int i = 0; i < block.rowCount(); i++)
         {
-            logExportFail("exportQueryResultsRow()");
-            return false;
+            row->load(block, i);
+            if (!plugin->exportQueryResultsRow(row))
+            {
+                logExportFail("exportQueryResultsRow()");
+                return false;
+            }
         }
 
         if (isInterrupted())
@@ -216,13 +242,33 @@ QHash<ExportManager::ExportProviderFlag, QVariant> ExportWorker::getProviderData
 
 bool ExportWorker::exportDatabase()
 {
-    QString err;
-    QList<ExportManager::ExportObjectPtr> dbObjects = collectDbObjects(&err);
-    if (!err.isNull())
+    // Schema is read from the same snapshot that tables will be read from
+    bool readTablesInParallel = openTableReaderConnections();
+    if (readTablesInParallel)
+        sourceDb = tableReaderDbs.first();
+
+    QList<ExportManager::ExportObjectPtr> dbObjects = collectDbObjects();
+    if (readTablesInParallel)
     {
-        logExportFail("exportDatabase() -> dbObjects");
-        notifyError(err);
-        return false;
+        sourceDb = db;
+        startTableReaders(dbObjects);
+    }
+    else
+    {
+        QString err;
+        for (const ExportManager::ExportObjectPtr& obj : dbObjects)
+        {
+            if (obj->type != ExportManager::ExportObject::TABLE)
+                continue;
+
+            queryTableDataToExport(sourceDb, obj->name, obj->data, obj->providerData, &err);
+            if (!err.isNull())
+            {
+                logExportFail("exportDatabase() -> dbObjects");
+                notifyError(err);
+                return false;
+            }
+        }
     }
 
     if (!plugin->initBeforeExport(db, output, *config))
@@ -344,6 +390,11 @@ bool ExportWorker::exportDatabaseObjects(const QList<ExportManager::ExportObject
         {
             qCritical() << "Could not parse" << obj->name << ", the DDL was:" << obj->ddl << ", error is:" << parser->getErrorString();
             notifyWarn(tr("Could not parse %1 in order to export it. It will be excluded from the export output.").arg(obj->name));
+
+            // Let the reader skip the table, instead of waiting for it to be exported
+            if (tableReadAhead.contains(obj.data()))
+                tableReadAhead[obj.data()]->rowBlocks.abort();
+
             continue;
         }
         parsedQuery = parser->getQueries().first();
@@ -351,7 +402,11 @@ bool ExportWorker::exportDatabaseObjects(const QList<ExportManager::ExportObject
         switch (obj->type)
         {
             case ExportManager::ExportObject::TABLE:
-                res = exportTableInternal(obj->database, obj->name, obj->ddl, parsedQuery, obj->data, obj->providerData);
+                if (tableReadAhead.contains(obj.data()))
+                    res = exportTableReadAhead(obj, parsedQuery, tableReadAhead[obj.data()]);
+                else
+                    res = exportTableInternal(obj->database, obj->name, obj->ddl, parsedQuery, obj->data, obj->providerData);
+
                 break;
             case ExportManager::ExportObject::INDEX:
                 res = plugin->exportIndex(obj->database, obj->name, obj->ddl, parsedQuery.dynamicCast<SqliteCreateIndex>());
@@ -387,7 +442,7 @@ bool ExportWorker::exportTable()
     SqlQueryPtr results;
     QString errorMessage;
     QHash<ExportManager::ExportProviderFlag,QVariant> providerData;
-    queryTableDataToExport(db, table, results, providerData, &errorMessage);
+    queryTableDataToExport(sourceDb, table, results, providerData, &errorMessage);
     if (!errorMessage.isNull())
     {
         logExportFail("fetching table data");
@@ -395,7 +450,7 @@ bool ExportWorker::exportTable()
         return false;
     }
 
-    SchemaResolver resolver(db);
+    SchemaResolver resolver(sourceDb);
     QString ddl = resolver.getObjectDdl(database, table, SchemaResolver::TABLE);
 
     if (!parser->parse(ddl) || parser->getQueries().size() < 1)
@@ -480,57 +535,101 @@ bool ExportWorker::exportTable()
 bool ExportWorker::exportTableInternal(const QString& database, const QString& table, const QString& ddl, SqliteQueryPtr parsedDdl, SqlQueryPtr results,
                                        const QHash<ExportManager::ExportProviderFlag,QVariant>& providerData)
 {
-    SqliteCreateTablePtr createTable = parsedDdl.dynamicCast<SqliteCreateTable>();
-    SqliteCreateVirtualTablePtr createVirtualTable = parsedDdl.dynamicCast<SqliteCreateVirtualTable>();
-
     QStringList colNames;
     if (results)
         colNames = results->getColumnNames();
 
-    if (createTable)
-    {
-        if (!results)
-            colNames = createTable->getColumnNames();
+    if (!exportTableEntry(database, table, ddl, parsedDdl, colNames, providerData))
+        return false;
 
-        if (!plugin->exportTable(database, table, colNames, ddl, createTable, providerData))
+    if (results)
+    {
+        SqlResultsBlock block;
+        SqlResultsBlockRowPtr row(new SqlResultsBlockRow());
+        while (results->nextBatch(ROWS_PER_BATCH, block) > 0)
         {
-            logExportFail("exportTable()");
-            return false;
+            for (int i = 0; i < block.rowCount(); i++)
+            {
+                row->load(block, i);
+                if (!plugin->exportTableRow(row))
+                {
+                    logExportFail("exportTableRow()");
+                    return false;
+                }
+            }
+
+            if (isInterrupted())
+            {
+                logExportFail("internal table export interruption (2)");
+                return false;
+            }
         }
     }
-    else
+
+    if (!plugin->afterExportTable())
     {
-        if (!plugin->exportVirtualTable(database, table, colNames, ddl, createVirtualTable, providerData))
-        {
-            logExportFail("exportVirtualTable()");
-            return false;
-        }
+        logExportFail("afterExportTable()");
+        return false;
     }
 
+    return true;
+}
+
+bool ExportWorker::exportTableReadAhead(const ExportManager::ExportObjectPtr& obj, SqliteQueryPtr parsedDdl, ExportTableData* tableData)
+{
+    // Column names and provider data are ready once the first block is popped, or the queue was finished.
+    // Error message is ready only after the queue was finished.
+    SqlResultsBlock block;
+    bool hasRows = tableData->rowBlocks.pop(block);
     if (isInterrupted())
     {
-        logExportFail("internal table export interruption");
+        logExportFail("read ahead table export interruption");
         return false;
     }
 
-    SqlResultsRowPtr row;
-    if (results)
+    if (!hasRows && !tableData->errorMessage.isNull())
+    {
+        logExportFail("reading table data");
+        notifyError(tableData->errorMessage);
+        return false;
+    }
+
+    if (!exportTableEntry(obj->database, obj->name, obj->ddl, parsedDdl, tableData->columns, tableData->providerData))
+        return false;
+
+    SqlResultsBlockRowPtr row(new SqlResultsBlockRow());
+    while (hasRows)
     {
-        while (results->hasNext())
+        for (int i = 0; i < block.rowCount(); i++)
         {
-            row = results->next();
+            row->load(block, i);
             if (!plugin->exportTableRow(row))
             {
                 logExportFail("exportTableRow()");
                 return false;
             }
+        }
 
-            if (isInterrupted())
-            {
-                logExportFail("internal table export interruption (2)");
-                return false;
-            }
+        if (isInterrupted())
+        {
+            logExportFail("read ahead table export interruption (2)");
+            return false;
         }
+
+        hasRows = tableData->rowBlocks.pop(block);
+    }
+
+    if (isInterrupted())
+    {
+        logExportFail("read ahead table export interruption (3)");
+        return false;
+    }
+
+    if (!tableData->errorMessage.isNull())
+    {
+        logExportFail("reading table data (2)");
+        notifyError(tableData->errorMessage);
+        return false;
     }
 
     if (!plugin->afterExportTable())
@@ -542,9 +641,44 @@ bool ExportWorker::exportTableInternal(const QString& database, const QString& t
     return true;
 }
 
-QList<ExportManager::ExportObjectPtr> ExportWorker::collectDbObjects(QString* errorMessage)
+bool ExportWorker::exportTableEntry(const QString& database, const QString& table, const QString& ddl, SqliteQueryPtr parsedDdl, QStringList colNames,
+                                    const QHash<ExportManager::ExportProviderFlag, QVariant>& providerData)
+{
+    SqliteCreateTablePtr createTable = parsedDdl.dynamicCast<SqliteCreateTable>();
+    SqliteCreateVirtualTablePtr createVirtualTable = parsedDdl.dynamicCast<SqliteCreateVirtualTable>();
+
+    if (createTable)
+    {
+        if (colNames.isEmpty())
+            colNames = createTable->getColumnNames();
+
+        if (!plugin->exportTable(database, table, colNames, ddl, createTable, providerData))
+        {
+            logExportFail("exportTable()");
+            return false;
+        }
+    }
+    else
+    {
+        if (!plugin->exportVirtualTable(database, table, colNames, ddl, createVirtualTable, providerData))
+        {
+            logExportFail("exportVirtualTable()");
+            return false;
+        }
+    }
+
+    if (isInterrupted())
+    {
+        logExportFail("internal table export interruption");
+        return false;
+    }
+
+    return true;
+}
+
+QList<ExportManager::ExportObjectPtr> ExportWorker::collectDbObjects()
 {
-    SchemaResolver resolver(db);
+    SchemaResolver resolver(sourceDb);
     StrHash<SchemaResolver::ObjectDetails> allDetails = resolver.getAllObjectDetails();
 
     QList<ExportManager::ExportObjectPtr> objectsToExport;
@@ -561,12 +695,7 @@ QList<ExportManager::ExportObjectPtr> ExportWorker::collectDbObjects(QString* er
 
         exportObj = ExportManager::ExportObjectPtr::create();
         if (details.type == SchemaResolver::TABLE)
-        {
             exportObj->type = ExportManager::ExportObject::TABLE;
-            queryTableDataToExport(db, objName, exportObj->data, exportObj->providerData, errorMessage);
-            if (!errorMessage->isNull())
-                return objectsToExport;
-        }
         else if (details.type == SchemaResolver::INDEX)
             exportObj->type = ExportManager::ExportObject::INDEX;
         else if (details.type == SchemaResolver::TRIGGER)
@@ -594,56 +723,301 @@ QList<ExportManager::ExportObjectPtr> ExportWorker::collectDbObjects(QString* er
 
 void ExportWorker::queryTableDataToExport(Db* db, const QString& table, SqlQueryPtr& dataPtr, QHash<ExportManager::ExportProviderFlag,QVariant>& providerData,
                                           QString* errorMessage) const
+{
+    if (config->exportData)
+        queryTableData(db, table, plugin->getProviderFlags(), dataPtr, providerData, errorMessage);
+}
+
+void ExportWorker::queryTableData(Db* db, const QString& table, ExportManager::ExportProviderFlags providerFlags, SqlQueryPtr& dataPtr,
+                                  QHash<ExportManager::ExportProviderFlag, QVariant>& providerData, QString* errorMessage)
 {
     static const QString sql = QStringLiteral("SELECT * FROM %1");
-    static const QString countSql = QStringLiteral("SELECT count(*) FROM %1");
-    static const QString colLengthSql = QStringLiteral("SELECT %1 FROM %2");
+    static const QString statsSql = QStringLiteral("SELECT %1 FROM %2");
+    static const QString countTpl = QStringLiteral("count(*)");
     static const QString colLengthTpl = QStringLiteral("max(length(%1))");
+    static const QString dataWithStatsSql = QStringLiteral("SELECT *, %1 FROM %2");
+    static const QString windowTpl = QStringLiteral("%1 OVER ()");
 
-    if (config->exportData)
+    QString wrappedTable = wrapObjIfNeeded(table, db->getDialect());
+    dataPtr = db->exec(sql.arg(wrappedTable));
+    if (dataPtr->isError())
+    {
+        *errorMessage = tr("Error while reading data to export from table %1: %2").arg(table, dataPtr->getErrorText());
+        return;
+    }
+
+    bool rowCount = providerFlags.testFlag(ExportManager::ROW_COUNT);
+    bool dataLengths = providerFlags.testFlag(ExportManager::DATA_LENGTHS);
+    if (!rowCount && !dataLengths)
+        return;
+
+    QStringList statsCols;
+    if (rowCount)
+        statsCols << countTpl;
+
+    if (dataLengths)
     {
-        QString wrappedTable = wrapObjIfNeeded(table, db->getDialect());
-        dataPtr = db->exec(sql.arg(wrappedTable));
-        if (dataPtr->isError() && !errorMessage->isNull())
-            *errorMessage = tr("Error while reading data to export from table %1: %2").arg(table, dataPtr->getErrorText());
+        for (const QString& col : dataPtr->getColumnNames())
+            statsCols << colLengthTpl.arg(wrapObjIfNeeded(col, db->getDialect()));
+    }
+
+    // With window functions (SQLite 3.25.0 and later) statistics are read by the data query, so the table is read only once.
+    // Otherwise they're read by a separate query.
+    if (db->getDialect() == Dialect::Sqlite3)
+    {
+        QStringList windowCols;
+        for (const QString& col : statsCols)
+            windowCols << windowTpl.arg(col);
 
-        if (plugin->getProviderFlags().testFlag(ExportManager::ROW_COUNT))
+        SqlQueryPtr dataWithStats = db->exec(dataWithStatsSql.arg(windowCols.join(", "), wrappedTable));
+        if (!dataWithStats->isError())
         {
-            SqlQueryPtr countQuery = db->exec(countSql.arg(wrappedTable));
-            if (countQuery->isError())
-            {
-                if (!errorMessage->isNull())
-                    *errorMessage = tr("Error while counting data to export from table %1: %2").arg(table, countQuery->getErrorText());
-            }
-            else
-                providerData[ExportManager::ROW_COUNT] = countQuery->getSingleCell().toInt();
+            ExportTableStatsResults* statsResults = new ExportTableStatsResults(dataWithStats, dataPtr->columnCount());
+            dataPtr = SqlQueryPtr(statsResults);
+            if (!statsResults->readStats(providerFlags, providerData))
+                *errorMessage = tr("Error while reading data to export from table %1: %2").arg(table, statsResults->getErrorText());
+
+            return;
         }
+    }
 
-        if (plugin->getProviderFlags().testFlag(ExportManager::DATA_LENGTHS))
-        {
-            QStringList wrappedCols;
-            for (const QString& col : dataPtr->getColumnNames())
-                wrappedCols << colLengthTpl.arg(wrapObjIfNeeded(col, db->getDialect()));
+    SqlQueryPtr statsQuery = db->exec(statsSql.arg(statsCols.join(", "), wrappedTable));
+    if (statsQuery->isError())
+    {
+        if (dataLengths)
+            *errorMessage = tr("Error while counting data column width to export from table %1: %2").arg(table, statsQuery->getErrorText());
+        else
+            *errorMessage = tr("Error while counting data to export from table %1: %2").arg(table, statsQuery->getErrorText());
 
-            SqlQueryPtr colLengthQuery = db->exec(colLengthSql.arg(wrappedCols.join(", "), wrappedTable));
-            if (colLengthQuery->isError())
-            {
-                if (!errorMessage->isNull())
-                    *errorMessage = tr("Error while counting data column width to export from table %1: %2").arg(table, colLengthQuery->getErrorText());
-            }
-            else
-            {
-                QList<int> colWidths;
-                SqlResultsRowPtr row = colLengthQuery->next();
-                for (const QVariant& value : row->valueList())
-                    colWidths << value.toInt();
+        return;
+    }
 
-                providerData[ExportManager::DATA_LENGTHS] = QVariant::fromValue(colWidths);
-            }
-        }
+    QList<QVariant> stats = statsQuery->next()->valueList();
+    if (rowCount)
+        providerData[ExportManager::ROW_COUNT] = stats.takeFirst().toInt();
+
+    if (dataLengths)
+    {
+        QList<int> colWidths;
+        for (const QVariant& value : stats)
+            colWidths << value.toInt();
+
+        providerData[ExportManager::DATA_LENGTHS] = QVariant::fromValue(colWidths);
     }
 }
 
+bool ExportWorker::openTableReaderConnections()
+{
+    // All reads from the snapshot have to be done with its single connection
+    if (!config->exportData || snapshotDb || !canOpenSecondaryConnection())
+        return false;
+
+    // While this connection holds the write lock, nothing can be committed, so all readers begin with the same snapshot.
+    // If the lock cannot be taken (i.e. the database is being modified, also by the connection of the export), tables are read sequentially.
+    Db* lockDb = openSecondaryConnection();
+    if (!lockDb)
+        return false;
+
+    if (!isWalMode(lockDb) || lockDb->exec("BEGIN IMMEDIATE;")->isError())
+    {
+        lockDb->closeQuiet();
+        delete lockDb;
+        return false;
+    }
+
+    // One core is left for the export plugin, which processes data read by readers
+    int readerCount = qMin(objectListToExport.size(), qBound(1, QThread::idealThreadCount() - 1, MAX_TABLE_READERS));
+    Db* readerDb = nullptr;
+    for (int i = 0; i < readerCount; i++)
+    {
+        readerDb = openReadTransactionConnection();
+        if (!readerDb)
+            break;
+
+        tableReaderDbs << readerDb;
+    }
+
+    lockDb->exec("ROLLBACK;");
+    lockDb->closeQuiet();
+    delete lockDb;
+
+    return !tableReaderDbs.isEmpty();
+}
+
+void ExportWorker::startTableReaders(const QList<ExportManager::ExportObjectPtr>& dbObjects)
+{
+    int tableCount = 0;
+    for (const ExportManager::ExportObjectPtr& obj : dbObjects)
+    {
+        if (obj->type == ExportManager::ExportObject::TABLE)
+            tableCount++;
+    }
+
+    // Connections were opened before the number of tables was known
+    Db* readerDb = nullptr;
+    while (tableReaderDbs.size() > tableCount)
+    {
+        readerDb = tableReaderDbs.takeLast();
+        readerDb->closeQuiet();
+        delete readerDb;
+    }
+
+    QMutexLocker locker(&interruptMutex);
+    ExportTableData* tableData = nullptr;
+    for (const ExportManager::ExportObjectPtr& obj : dbObjects)
+    {
+        if (obj->type != ExportManager::ExportObject::TABLE)
+            continue;
+
+        tableData = new ExportTableData(obj->name);
+        tableReadAheadList << tableData;
+        tableReadAhead[obj.data()] = tableData;
+    }
+
+    nextTableToRead.store(0);
+    ExportManager::ExportProviderFlags providerFlags = plugin->getProviderFlags();
+    ExportTableReader* reader = nullptr;
+    for (Db* readerConnection : tableReaderDbs)
+    {
+        reader = new ExportTableReader(readerConnection, &tableReadAheadList, &nextTableToRead, providerFlags);
+        tableReaders << reader;
+        reader->start();
+    }
+
+    // Readers own their connections now
+    tableReaderDbs.clear();
+}
+
+void ExportWorker::stopTableReaders()
+{
+    for (Db* readerDb : tableReaderDbs)
+    {
+        readerDb->closeQuiet();
+        delete readerDb;
+    }
+    tableReaderDbs.clear();
+
+    if (tableReaders.isEmpty())
+        return;
+
+    QList<ExportTableReader*> readers;
+    QList<ExportTableData*> tablesData;
+    {
+        QMutexLocker locker(&interruptMutex);
+        for (ExportTableData* tableData : tableReadAheadList)
+            tableData->rowBlocks.abort();
+
+        readers = tableReaders;
+        tablesData = tableReadAheadList;
+        tableReaders.clear();
+        tableReadAheadList.clear();
+        tableReadAhead.clear();
+    }
+
+    for (ExportTableReader* reader : readers)
+    {
+        reader->wait();
+        delete reader;
+    }
+
+    qDeleteAll(tablesData);
+}
+
+bool ExportWorker::canOpenSecondaryConnection() const
+{
+    // SQLite 2 is not prepared for multithreaded access and in-memory database cannot be opened with another connection
+    if (db->getDialect() != Dialect::Sqlite3)
+        return false;
+
+    QString path = db->getPath();
+    return !path.isEmpty() && path != ":memory:";
+}
+
+Db* ExportWorker::openSecondaryConnection() const
+{
+    DbPlugin* dbPlugin = getDbPlugin();
+    if (!dbPlugin)
+        return nullptr;
+
+    Db* connection = dbPlugin->getInstanceWithoutProbing(db->getName(), db->getPath(), db->getConnectionOptions());
+    if (!connection)
+        return nullptr;
+
+    if (!connection->initAfterCreated() || !connection->openQuiet())
+    {
+        delete connection;
+        return nullptr;
+    }
+    return connection;
+}
+
+Db* ExportWorker::openReadTransactionConnection() const
+{
+    Db* connection = openSecondaryConnection();
+    if (!connection)
+        return nullptr;
+
+    // The connection is only for reading, any attempt to modify the database should fail.
+    // Deferred transaction pins the snapshot with the first read from the database.
+    if (connection->exec("PRAGMA query_only = 1;")->isError() || !connection->begin() ||
+        connection->exec("SELECT count(*) FROM sqlite_master;")->isError())
+    {
+        qWarning() << "Could not begin read transaction on additional connection for export:" << connection->getErrorText();
+        connection->closeQuiet();
+        delete connection;
+        return nullptr;
+    }
+    return connection;
+}
+
+bool ExportWorker::isWalMode(Db* connection)
+{
+    SqlQueryPtr results = connection->exec("PRAGMA journal_mode;");
+    if (results->isError())
+        return false;
+
+    return results->getSingleCell().toString().compare("wal", Qt::CaseInsensitive) == 0;
+}
+
+void ExportWorker::beginSnapshot()
+{
+    if (canOpenSecondaryConnection())
+        snapshotDb = openReadTransactionConnection();
+
+    if (!snapshotDb)
+    {
+        notifyWarn(tr("Could not read a consistent snapshot of the database %1. The export will read the database without it.").arg(db->getName()));
+        return;
+    }
+
+    sourceDb = snapshotDb;
+    snapshotTimer.start();
+}
+
+void ExportWorker::endSnapshot()
+{
+    if (!snapshotDb)
+        return;
+
+    snapshotDb->rollback();
+    int heldFor = static_cast<int>(snapshotTimer.elapsed());
+    snapshotDb->closeQuiet();
+    safe_delete(snapshotDb);
+    sourceDb = db;
+
+    notifyInfo(tr("Data was exported from a consistent snapshot of the database %1, which was held for %2.").arg(db->getName(), formatTimePeriod(heldFor)));
+}
+
+DbPlugin* ExportWorker::getDbPlugin() const
+{
+    for (DbPlugin* dbPlugin : PLUGINS->getLoadedPlugins<DbPlugin>())
+    {
+        if (dbPlugin->checkIfDbServedByPlugin(db))
+            return dbPlugin;
+    }
+    return nullptr;
+}
+
 bool ExportWorker::isInterrupted()
 {
     QMutexLocker locker(&interruptMutex);
@@ -655,3 +1029,171 @@ void ExportWorker::logExportFail(const QString &stageName)
     qWarning() << "Export has faild at" << stageName << "stage.";
 }
 
+
+ExportTableData::ExportTableData(const QString& table) :
+    table(table), rowBlocks(READ_AHEAD_BLOCKS)
+{
+}
+
+ExportTableStatsResults::ExportTableStatsResults(SqlQueryPtr results, int dataColumns) :
+    results(results), dataColumns(dataColumns)
+{
+    resultColumns = SqlResultsColumnsPtr(new SqlResultsColumns(results->getColumnNames().mid(0, dataColumns)));
+}
+
+bool ExportTableStatsResults::readStats(ExportManager::ExportProviderFlags providerFlags, QHash<ExportManager::ExportProviderFlag, QVariant>& providerData)
+{
+    if (!fetchRows() && results->isError())
+        return false;
+
+    // All rows have the same statistics. If there are no rows, then there is no data either.
+    bool hasRow = fetchedBlock.rowCount() > 0;
+    int statsCol = dataColumns;
+    if (providerFlags.testFlag(ExportManager::ROW_COUNT))
+        providerData[ExportManager::ROW_COUNT] = hasRow ? fetchedBlock.value(0, statsCol++).toInt() : 0;
+
+    if (providerFlags.testFlag(ExportManager::DATA_LENGTHS))
+    {
+        QList<int> colWidths;
+        for (int i = 0; i < dataColumns; i++)
+            colWidths << (hasRow ? fetchedBlock.value(0, statsCol++).toInt() : 0);
+
+        providerData[ExportManager::DATA_LENGTHS] = QVariant::fromValue(colWidths);
+    }
+    return true;
+}
+
+QString ExportTableStatsResults::getErrorText()
+{
+    return results->getErrorText();
+}
+
+int ExportTableStatsResults::getErrorCode()
+{
+    return results->getErrorCode();
+}
+
+QStringList ExportTableStatsResults::getColumnNames()
+{
+    return resultColumns->getNames();
+}
+
+int ExportTableStatsResults::columnCount()
+{
+    return dataColumns;
+}
+
+SqlResultsRowPtr ExportTableStatsResults::nextInternal()
+{
+    SqlResultsBlock rowBlock;
+    if (nextBatchInternal(1, rowBlock) == 0)
+        return SqlResultsRowPtr();
+
+    SqlResultsBlockRow* row = new SqlResultsBlockRow();
+    row->load(rowBlock, 0);
+    return SqlResultsRowPtr(row);
+}
+
+bool ExportTableStatsResults::hasNextInternal()
+{
+    return fetchedRow < fetchedBlock.rowCount() || fetchRows();
+}
+
+int ExportTableStatsResults::nextBatchInternal(int maxRows, SqlResultsBlock& block)
+{
+    block.reset(resultColumns);
+    QVariant* rowValues = nullptr;
+    while (block.rowCount() < maxRows && hasNextInternal())
+    {
+        rowValues = block.appendRow();
+        for (int c = 0; c < dataColumns; c++)
+            rowValues[c] = fetchedBlock.value(fetchedRow, c);
+
+        fetchedRow++;
+    }
+    return block.rowCount();
+}
+
+bool ExportTableStatsResults::execInternal(const QList<QVariant>& args)
+{
+    UNUSED(args);
+    fetchedBlock.reset(resultColumns);
+    fetchedRow = 0;
+    return results->execute();
+}
+
+bool ExportTableStatsResults::execInternal(const QHash<QString, QVariant>& args)
+{
+    UNUSED(args);
+    fetchedBlock.reset(resultColumns);
+    fetchedRow = 0;
+    return results->execute();
+}
+
+bool ExportTableStatsResults::fetchRows()
+{
+    fetchedRow = 0;
+    return results->nextBatch(ROWS_PER_FETCH, fetchedBlock) > 0;
+}
+
+ExportTableReader::ExportTableReader(Db* db, const QList<ExportTableData*>* tables, QAtomicInt* nextTable,
+                                     ExportManager::ExportProviderFlags providerFlags) :
+    db(db), tables(tables), nextTable(nextTable), providerFlags(providerFlags)
+{
+}
+
+ExportTableReader::~ExportTableReader()
+{
+    db->rollback();
+    db->closeQuiet();
+    safe_delete(db);
+}
+
+void ExportTableReader::interruptReading()
+{
+    db->interrupt();
+}
+
+void ExportTableReader::run()
+{
+    int idx;
+    while ((idx = nextTable->fetchAndAddOrdered(1)) < tables->size())
+    {
+        ExportTableData* tableData = tables->at(idx);
+        if (tableData->rowBlocks.isAborted())
+            continue;
+
+        readTable(tableData);
+    }
+}
+
+void ExportTableReader::readTable(ExportTableData* tableData)
+{
+    SqlQueryPtr results;
+    ExportWorker::queryTableData(db, tableData->table, providerFlags, results, tableData->providerData, &tableData->errorMessage);
+    if (!tableData->errorMessage.isNull())
+    {
+        tableData->rowBlocks.finish();
+        return;
+    }
+
+    tableData->columns = results->getColumnNames();
+
+    // New block for each batch, as the pushed one is shared with the exporting thread until it's popped and processed.
+    SqlResultsBlock block;
+    while (results->nextBatch(ROWS_PER_BLOCK, block) == ROWS_PER_BLOCK)
+    {
+        if (!tableData->rowBlocks.push(block))
+            return;
+
+        block = SqlResultsBlock();
+    }
+
+    if (results->isError())
+        tableData->errorMessage = ExportWorker::tr("Error while reading data to export from table %1: %2").arg(tableData->table, results->getErrorText());
+
+    if (!block.isEmpty() && !tableData->rowBlocks.push(block))
+        return;
+
+    tableData->rowBlocks.finish();
+}
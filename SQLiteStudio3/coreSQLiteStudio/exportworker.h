@@ -3,12 +3,121 @@
 
 #include "services/exportmanager.h"
 #include "db/queryexecutor.h"
+#include "db/sqlresultsrow.h"
 #include "parser/ast/sqlitecreatetable.h"
+#include "common/blockingqueue.h"
 #include <QObject>
 #include <QRunnable>
 #include <QMutex>
+#include <QThread>
+#include <QAtomicInt>
+#include <QElapsedTimer>
 
 class Db;
+class DbPlugin;
+
+/**
+ * @brief Data of a single table read ahead for the database export.
+ *
+ * Column names, provider data and error message are set by the reader before it pushes the first block of rows
+ * (or finishes the queue), so they can be used once the first pop() from the queue has returned.
+ */
+struct ExportTableData
+{
+    explicit ExportTableData(const QString& table);
+
+    /**
+     * @brief Number of row blocks that can be read ahead of exporting them.
+     */
+    static const int READ_AHEAD_BLOCKS = 8;
+
+    QString table;
+    QStringList columns;
+    QHash<ExportManager::ExportProviderFlag,QVariant> providerData;
+    QString errorMessage;
+    BlockingQueue<SqlResultsBlock> rowBlocks;
+};
+
+/**
+ * @brief Table data results with statistics for the export plugin read by the same query.
+ *
+ * When the export plugin asks for the row count or data lengths (see ExportManager::ExportProviderFlag),
+ * they are appended to the data query as window function columns, so the table is read only once.
+ * This object wraps results of such query, reads statistics from the first row and hides their columns,
+ * so it looks just like results of the plain data query.
+ */
+class ExportTableStatsResults : public SqlQuery
+{
+    public:
+        ExportTableStatsResults(SqlQueryPtr results, int dataColumns);
+
+        /**
+         * @brief Reads statistics from the first row of results.
+         * @param providerFlags Statistics that were appended to the query, in order: the row count, then data lengths.
+         * @param providerData Hash to put statistics into.
+         * @return true if statistics were read, or false in case of error of the underlying query.
+         *
+         * The first row is not consumed. It will be returned as usual, just without statistics.
+         */
+        bool readStats(ExportManager::ExportProviderFlags providerFlags, QHash<ExportManager::ExportProviderFlag, QVariant>& providerData);
+
+        QString getErrorText();
+        int getErrorCode();
+        QStringList getColumnNames();
+        int columnCount();
+
+    protected:
+        SqlResultsRowPtr nextInternal();
+        bool hasNextInternal();
+        int nextBatchInternal(int maxRows, SqlResultsBlock& block);
+        bool execInternal(const QList<QVariant>& args);
+        bool execInternal(const QHash<QString, QVariant>& args);
+
+    private:
+        bool fetchRows();
+
+        static const int ROWS_PER_FETCH = 1000;
+
+        SqlQueryPtr results;
+        int dataColumns = 0;
+        SqlResultsBlock fetchedBlock;
+        int fetchedRow = 0;
+};
+
+/**
+ * @brief Reads data of tables for the database export in a separate thread.
+ *
+ * Each reader has its own connection to the database. Readers take tables one after another,
+ * in the order of the export, and push blocks of rows into the queue of the table.
+ * The ExportWorker passes them to the export plugin table after table, so many tables are read in parallel,
+ * while the plugin still gets them in the original order.
+ *
+ * Reader connections are read-only and each of them is in a read transaction begun by the ExportWorker
+ * before the schema was read, so all readers see the same snapshot of the database (see ExportWorker::openTableReaderConnections()).
+ *
+ * The reader owns the connection and closes it (ending the read transaction) when deleted.
+ */
+class ExportTableReader : public QThread
+{
+    public:
+        ExportTableReader(Db* db, const QList<ExportTableData*>* tables, QAtomicInt* nextTable, ExportManager::ExportProviderFlags providerFlags);
+        ~ExportTableReader();
+
+        void interruptReading();
+
+    protected:
+        void run();
+
+    private:
+        void readTable(ExportTableData* tableData);
+
+        static const int ROWS_PER_BLOCK = 1000;
+
+        Db* db = nullptr;
+        const QList<ExportTableData*>* tables = nullptr;
+        QAtomicInt* nextTable = nullptr;
+        ExportManager::ExportProviderFlags providerFlags;
+};
 
 class API_EXPORT ExportWorker : public QObject, public QRunnable
 {
@@ -23,6 +132,8 @@ class API_EXPORT ExportWorker : public QObject, public QRunnable
         void prepareExportTable(Db* db, const QString& database, const QString& table);
 
     private:
+        friend class ExportTableReader;
+
         void prepareParser();
         bool exportQueryResults();
         QHash<ExportManager::ExportProviderFlag, QVariant> getProviderDataForQueryResults();
@@ -31,17 +142,75 @@ class API_EXPORT ExportWorker : public QObject, public QRunnable
         bool exportTable();
         bool exportTableInternal(const QString& database, const QString& table, const QString& ddl, SqliteQueryPtr parsedDdl, SqlQueryPtr results,
                                  const QHash<ExportManager::ExportProviderFlag, QVariant>& providerData);
-        QList<ExportManager::ExportObjectPtr> collectDbObjects(QString* errorMessage);
+        bool exportTableReadAhead(const ExportManager::ExportObjectPtr& obj, SqliteQueryPtr parsedDdl, ExportTableData* tableData);
+        bool exportTableEntry(const QString& database, const QString& table, const QString& ddl, SqliteQueryPtr parsedDdl, QStringList colNames,
+                              const QHash<ExportManager::ExportProviderFlag, QVariant>& providerData);
+        QList<ExportManager::ExportObjectPtr> collectDbObjects();
         void queryTableDataToExport(Db* db, const QString& table, SqlQueryPtr& dataPtr, QHash<ExportManager::ExportProviderFlag, QVariant>& providerData,
                                     QString* errorMessage) const;
+        /**
+         * @brief Opens connections for reading tables in parallel, all of them reading the same snapshot of the database.
+         * @return true if at least one connection was opened, or false if tables should be read sequentially.
+         *
+         * Each connection begins a read transaction, which pins its snapshot. Snapshots of all connections are the same
+         * only if no other connection commits anything in the meantime, so the write lock is held while they're begun.
+         * Holding the write lock doesn't block readers only in WAL mode, therefore the database has to be in WAL mode.
+         * It has to be called before the schema is read, so the schema comes from the same snapshot as the data.
+         */
+        bool openTableReaderConnections();
+        void startTableReaders(const QList<ExportManager::ExportObjectPtr>& dbObjects);
+        void stopTableReaders();
+        bool canOpenSecondaryConnection() const;
+        Db* openSecondaryConnection() const;
+
+        /**
+         * @brief Opens read-only connection in a read transaction.
+         * @return Connection, or null if it could not be opened, or the transaction could not be started.
+         *
+         * The transaction is deferred and the connection reads from the database once, so the snapshot is already pinned when it's returned.
+         */
+        Db* openReadTransactionConnection() const;
+        static bool isWalMode(Db* connection);
+        void beginSnapshot();
+        void endSnapshot();
+        DbPlugin* getDbPlugin() const;
         bool isInterrupted();
         void logExportFail(const QString& stageName);
 
+        /**
+         * @brief Executes the query reading the table data and queries for data requested by the export plugin.
+         *
+         * Row count and data lengths (if requested) are collected with a single scan of the table.
+         * On failure the errorMessage is set.
+         */
+        static void queryTableData(Db* db, const QString& table, ExportManager::ExportProviderFlags providerFlags, SqlQueryPtr& dataPtr,
+                                   QHash<ExportManager::ExportProviderFlag, QVariant>& providerData, QString* errorMessage);
+
+        /**
+         * @brief Maximum number of connections reading tables in parallel for the database export.
+         */
+        static const int MAX_TABLE_READERS = 8;
+
+        /**
+         * @brief Maximum number of rows read from the results with a single SqlQuery::nextBatch() call.
+         */
+        static const int ROWS_PER_BATCH = 1000;
+
         ExportPlugin* plugin = nullptr;
         ExportManager::StandardExportConfig* config = nullptr;
         QIODevice* output = nullptr;
         ExportManager::ExportMode exportMode = ExportManager::UNDEFINED;
         Db* db = nullptr;
+
+        /**
+         * @brief Database that the schema and table data is read from.
+         *
+         * It's the same as db, unless the export reads from a consistent snapshot (then it's the snapshotDb).
+         * The export plugin always gets the db.
+         */
+        Db* sourceDb = nullptr;
+        Db* snapshotDb = nullptr;
+        QElapsedTimer snapshotTimer;
         QString query;
         QString database;
         QString table;
@@ -50,6 +219,11 @@ class API_EXPORT ExportWorker : public QObject, public QRunnable
         bool interrupted = false;
         QMutex interruptMutex;
         Parser* parser = nullptr;
+        QList<Db*> tableReaderDbs;
+        QList<ExportTableReader*> tableReaders;
+        QList<ExportTableData*> tableReadAheadList;
+        QHash<ExportManager::ExportObject*, ExportTableData*> tableReadAhead;
+        QAtomicInt nextTableToRead;
 
     public slots:
         void interrupt();
@@ -4,9 +4,10 @@
 #include "db/db.h"
 #include "plugins/importplugin.h"
 #include "common/utils.h"
+#include "common/global.h"
 
 ImportWorker::ImportWorker(ImportPlugin* plugin, ImportManager::StandardImportConfig* config, Db* db, const QString& table, QObject *parent) :
-    QObject(parent), plugin(plugin), config(config), db(db), table(table)
+    QObject(parent), plugin(plugin), config(config), db(db), table(table), rowBlocks(READ_AHEAD_BLOCKS)
 {
 }
 
@@ -25,37 +26,40 @@ void ImportWorker::run()
         return;
     }
 
-    if (!config->skipTransaction && !db->begin())
-    {
-        error(tr("Could not start transaction in order to import a data: %1").arg(db->getErrorText()));
-        return;
-    }
+    if (!config->skipTransaction && config->fastImportPragmas)
+        applyFastImportPragmas();
 
-    if (!prepareTable())
+    if (!beginTransaction())
     {
-        if (!config->skipTransaction)
-            db->rollback();
-
+        QString errorText = db->getErrorText();
+        restorePragmas();
+        error(tr("Could not start transaction in order to import a data: %1").arg(errorText));
         return;
     }
 
-    if (!importData())
+    if (!prepareTable() || !importData())
     {
-        if (!config->skipTransaction)
-            db->rollback();
+        rollbackTransaction();
+        restorePragmas();
+
+        // Part of the data could have been already committed, including the new table
+        if (tableCreated && anyCommitDone)
+            emit createdTable(db, table);
 
         return;
     }
 
-    if (!config->skipTransaction && !db->commit())
+    if (!commitTransaction())
     {
         error(tr("Could not commit transaction for imported data: %1").arg(db->getErrorText()));
-        if (!config->skipTransaction)
-            db->rollback();
-
+        rollbackTransaction();
+        restorePragmas();
         return;
     }
 
+    restorePragmas();
+    reportProgress();
+
     if (tableCreated)
         emit createdTable(db, table);
 
@@ -67,6 +71,7 @@ void ImportWorker::interrupt()
 {
     QMutexLocker locker(&interruptMutex);
     interrupted = true;
+    rowBlocks.abort();
 }
 
 void ImportWorker::readPluginColumns()
@@ -81,6 +86,7 @@ void ImportWorker::readPluginColumns()
 
 void ImportWorker::error(const QString& err)
 {
+    stopReading();
     notifyError(err);
     plugin->afterImport();
     emit finished(false);
@@ -140,56 +146,275 @@ bool ImportWorker::prepareTable()
 
 bool ImportWorker::importData()
 {
-    static const QString insertTemplate = QStringLiteral("INSERT INTO %1 VALUES (%2)");
-
     int colCount = targetColumns.size();
-    QStringList valList;
-    for (int i = 0; i < colCount; i++)
-        valList << "?";
+    int rowsPerInsert = getRowsPerInsert();
+    SqlQueryPtr batchQuery = prepareInsert(rowsPerInsert);
+    SqlQueryPtr singleRowQuery = (rowsPerInsert > 1) ? prepareInsert(1) : batchQuery;
 
-    QString theInsert = insertTemplate.arg(wrapObjIfNeeded(table, db->getDialect()), valList.join(", "));
-    SqlQueryPtr query = db->prepare(theInsert);
-    query->setFlags(Db::Flag::SKIP_DROP_DETECTION|Db::Flag::SKIP_PARAM_COUNTING|Db::Flag::NO_LOCK);
+    reader = new ImportDataReader(plugin, &rowBlocks, colCount, rowsPerInsert);
+    reader->start();
 
-    int rowCnt = 0;
-    QList<QVariant> row;
-    while ((row = plugin->next()).size() > 0)
+    progressTimer.start();
+    int rows;
+    QList<QVariant> args;
+    while (rowBlocks.pop(args))
     {
-        // Fill up missing values in the line
-        for (int i = row.size(); i < colCount; i++)
-            row << QVariant(QVariant::String);
+        rows = args.size() / colCount;
+        if (!insertRows((rows == rowsPerInsert) ? batchQuery : prepareInsert(rows), singleRowQuery, args, rows))
+            return false;
 
-        // Assign argument values
-        query->setArgs(row.mid(0, colCount));
+        if (isInterrupted())
+            break;
 
-        if (!query->execute())
+        if (!config->skipTransaction && config->commitInterval > 0 && rowsSinceCommit >= config->commitInterval)
         {
-            if (config->ignoreErrors)
-            {
-                qDebug() << "Could not import data row number" << (rowCnt+1) << ". The row was ignored. Problem details:"
-                         << query->getErrorText();
-
-                notifyWarn(tr("Could not import data row number %1. The row was ignored. Problem details: %2")
-                           .arg(QString::number(rowCnt + 1), query->getErrorText()));
-            }
-            else
+            if (!commitTransaction() || !beginTransaction())
             {
-                error(tr("Error while importing data: %1").arg(query->getErrorText()));
+                error(tr("Could not commit transaction for imported data: %1").arg(db->getErrorText()));
                 return false;
             }
         }
 
-        if ((rowCnt % 100) == 0 && isInterrupted())
+        if (progressTimer.elapsed() >= PROGRESS_REPORT_INTERVAL)
+            reportProgress();
+    }
+
+    // Queue is aborted only by interruption, otherwise it's finished when reader has no more data
+    if (isInterrupted())
+    {
+        error(tr("Error while importing data: %1").arg(tr("Interrupted.", "import process status update")));
+        return false;
+    }
+
+    stopReading();
+    return true;
+}
+
+int ImportWorker::getRowsPerInsert() const
+{
+    // Multi-row VALUES clause is not supported by SQLite 2
+    if (db->getDialect() == Dialect::Sqlite2)
+        return 1;
+
+    return qMax(1, MAX_BIND_PARAMS / targetColumns.size());
+}
+
+SqlQueryPtr ImportWorker::prepareInsert(int rows)
+{
+    static_qstring(insertTemplate, "INSERT INTO %1 VALUES %2");
+
+    QStringList valList;
+    for (int i = 0, total = targetColumns.size(); i < total; i++)
+        valList << "?";
+
+    QString rowValues = "(" + valList.join(", ") + ")";
+    QStringList rowList;
+    for (int i = 0; i < rows; i++)
+        rowList << rowValues;
+
+    QString theInsert = insertTemplate.arg(wrapObjIfNeeded(table, db->getDialect()), rowList.join(", "));
+    SqlQueryPtr query = db->prepare(theInsert);
+    query->setFlags(Db::Flag::SKIP_DROP_DETECTION|Db::Flag::SKIP_PARAM_COUNTING|Db::Flag::NO_LOCK);
+    return query;
+}
+
+bool ImportWorker::insertRows(SqlQueryPtr batchQuery, SqlQueryPtr singleRowQuery, const QList<QVariant>& args, int rows)
+{
+    if (rows > 1)
+    {
+        batchQuery->setArgs(args);
+        if (batchQuery->execute())
+        {
+            processedRows += rows;
+            importedRows += rows;
+            rowsSinceCommit += rows;
+            return true;
+        }
+
+        if (!config->ignoreErrors)
         {
-            error(tr("Error while importing data: %1").arg(tr("Interrupted.", "import process status update")));
+            error(tr("Error while importing data: %1").arg(batchQuery->getErrorText()));
             return false;
         }
-        rowCnt++;
+
+        // Failed statement has no effect, so the rows are inserted one by one to skip only the invalid ones
+    }
+
+    int colCount = targetColumns.size();
+    for (int i = 0; i < rows; i++)
+    {
+        if (!insertSingleRow(singleRowQuery, args.mid(i * colCount, colCount)))
+            return false;
+    }
+
+    return true;
+}
+
+bool ImportWorker::insertSingleRow(SqlQueryPtr query, const QList<QVariant>& args)
+{
+    processedRows++;
+    query->setArgs(args);
+    if (query->execute())
+    {
+        importedRows++;
+        rowsSinceCommit++;
+        return true;
+    }
+
+    if (!config->ignoreErrors)
+    {
+        error(tr("Error while importing data: %1").arg(query->getErrorText()));
+        return false;
+    }
+
+    qDebug() << "Could not import data row number" << processedRows << ". The row was ignored. Problem details:"
+             << query->getErrorText();
+
+    notifyWarn(tr("Could not import data row number %1. The row was ignored. Problem details: %2")
+               .arg(QString::number(processedRows), query->getErrorText()));
+
+    return true;
+}
+
+void ImportWorker::applyFastImportPragmas()
+{
+    static const QList<QPair<QString, QString>> fastImportPragmas = {
+        {"journal_mode", "MEMORY"},
+        {"synchronous", "OFF"},
+        {"cache_size", "-65536"}
+    };
+    static_qstring(getPragmaTemplate, "PRAGMA %1");
+    static_qstring(setPragmaTemplate, "PRAGMA %1 = %2");
+
+    originalPragmas.clear();
+    SqlQueryPtr results;
+    QVariant originalValue;
+    for (const QPair<QString, QString>& pragma : fastImportPragmas)
+    {
+        results = db->exec(getPragmaTemplate.arg(pragma.first));
+        if (results->isError())
+        {
+            qWarning() << "Could not read pragma" << pragma.first << "before import:" << results->getErrorText();
+            continue;
+        }
+
+        // WAL is cheap enough already and leaving it would require checkpoint, so it's kept as is
+        originalValue = results->getSingleCell();
+        if (pragma.first == "journal_mode" && originalValue.toString().toLower() == "wal")
+            continue;
+
+        results = db->exec(setPragmaTemplate.arg(pragma.first, pragma.second));
+        if (results->isError())
+        {
+            qWarning() << "Could not set pragma" << pragma.first << "for import:" << results->getErrorText();
+            continue;
+        }
+
+        originalPragmas << QPair<QString, QVariant>(pragma.first, originalValue);
+    }
+}
+
+void ImportWorker::restorePragmas()
+{
+    static_qstring(setPragmaTemplate, "PRAGMA %1 = %2");
+
+    SqlQueryPtr results;
+    for (const QPair<QString, QVariant>& pragma : originalPragmas)
+    {
+        results = db->exec(setPragmaTemplate.arg(pragma.first, pragma.second.toString()));
+        if (results->isError())
+            qWarning() << "Could not restore pragma" << pragma.first << "after import:" << results->getErrorText();
     }
+    originalPragmas.clear();
+}
+
+bool ImportWorker::beginTransaction()
+{
+    return config->skipTransaction || db->begin();
+}
+
+bool ImportWorker::commitTransaction()
+{
+    if (config->skipTransaction)
+        return true;
+
+    if (!db->commit())
+        return false;
 
+    anyCommitDone = true;
+    rowsSinceCommit = 0;
     return true;
 }
 
+void ImportWorker::rollbackTransaction()
+{
+    if (!config->skipTransaction)
+        db->rollback();
+}
+
+void ImportWorker::reportProgress()
+{
+    emit progress(importedRows, reader ? reader->getReadBytes() : plugin->getReadBytes());
+    progressTimer.restart();
+}
+
+void ImportWorker::stopReading()
+{
+    if (!reader)
+        return;
+
+    rowBlocks.abort();
+    reader->wait();
+    safe_delete(reader);
+}
+
+ImportDataReader::ImportDataReader(ImportPlugin* plugin, BlockingQueue<QList<QVariant>>* queue, int colCount, int rowsPerBlock) :
+    plugin(plugin), queue(queue), colCount(colCount), rowsPerBlock(rowsPerBlock), readBytes(-1)
+{
+}
+
+qint64 ImportDataReader::getReadBytes() const
+{
+    return readBytes.load();
+}
+
+void ImportDataReader::run()
+{
+    QList<QVariant> args;
+    args.reserve(colCount * rowsPerBlock);
+
+    int rowsInBlock = 0;
+    int valuesToCopy;
+    QList<QVariant> row;
+    while ((row = plugin->next()).size() > 0)
+    {
+        // Excessive values in the line are ignored, missing ones are filled up with nulls
+        valuesToCopy = qMin(row.size(), colCount);
+        for (int i = 0; i < valuesToCopy; i++)
+            args << row[i];
+
+        for (int i = valuesToCopy; i < colCount; i++)
+            args << QVariant(QVariant::String);
+
+        if (++rowsInBlock < rowsPerBlock)
+            continue;
+
+        readBytes.store(plugin->getReadBytes());
+        if (!queue->push(args))
+            return;
+
+        args.clear();
+        args.reserve(colCount * rowsPerBlock);
+        rowsInBlock = 0;
+    }
+
+    readBytes.store(plugin->getReadBytes());
+    if (rowsInBlock > 0 && !queue->push(args))
+        return;
+
+    queue->finish();
+}
+
 bool ImportWorker::isInterrupted()
 {
     QMutexLocker locker(&interruptMutex);
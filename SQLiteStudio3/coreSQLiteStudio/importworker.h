@@ -2,11 +2,41 @@
 #define IMPORTWORKER_H
 
 #include "services/importmanager.h"
+#include "db/sqlquery.h"
+#include "common/blockingqueue.h"
 #include <QObject>
 #include <QRunnable>
 #include <QMutex>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QAtomicInteger>
 
-class ImportWorker : public QObject, public QRunnable
+/**
+ * @brief Reads rows from the import plugin in a separate thread.
+ *
+ * Rows are collected into blocks of bind arguments (already adjusted to the number of target columns)
+ * and pushed into the queue, from which the ImportWorker inserts them into the database.
+ * This way parsing of the input data and writing to the database are done in parallel.
+ */
+class ImportDataReader : public QThread
+{
+    public:
+        ImportDataReader(ImportPlugin* plugin, BlockingQueue<QList<QVariant>>* queue, int colCount, int rowsPerBlock);
+
+        qint64 getReadBytes() const;
+
+    protected:
+        void run();
+
+    private:
+        ImportPlugin* plugin = nullptr;
+        BlockingQueue<QList<QVariant>>* queue = nullptr;
+        int colCount = 0;
+        int rowsPerBlock = 0;
+        QAtomicInteger<qint64> readBytes;
+};
+
+class API_EXPORT ImportWorker : public QObject, public QRunnable
 {
         Q_OBJECT
     public:
@@ -20,6 +50,32 @@ class ImportWorker : public QObject, public QRunnable
         bool prepareTable();
         bool importData();
         bool isInterrupted();
+        bool beginTransaction();
+        bool commitTransaction();
+        void rollbackTransaction();
+        int getRowsPerInsert() const;
+        SqlQueryPtr prepareInsert(int rows);
+        bool insertRows(SqlQueryPtr batchQuery, SqlQueryPtr singleRowQuery, const QList<QVariant>& args, int rows);
+        bool insertSingleRow(SqlQueryPtr query, const QList<QVariant>& args);
+        void applyFastImportPragmas();
+        void restorePragmas();
+        void reportProgress();
+        void stopReading();
+
+        /**
+         * @brief Maximum number of bind parameters in a single query.
+         *
+         * This is default value of SQLITE_MAX_VARIABLE_NUMBER for SQLite versions before 3.32.0.
+         * Newer versions allow more, but the statement would not get much faster with more rows.
+         */
+        static const int MAX_BIND_PARAMS = 999;
+
+        static const int PROGRESS_REPORT_INTERVAL = 500;
+
+        /**
+         * @brief Number of row blocks that the reader thread can read ahead of inserting them.
+         */
+        static const int READ_AHEAD_BLOCKS = 16;
 
         ImportPlugin* plugin = nullptr;
         ImportManager::StandardImportConfig* config = nullptr;
@@ -32,6 +88,14 @@ class ImportWorker : public QObject, public QRunnable
         bool interrupted = false;
         QMutex interruptMutex;
         bool tableCreated = false;
+        bool anyCommitDone = false;
+        qint64 importedRows = 0;
+        qint64 processedRows = 0;
+        qint64 rowsSinceCommit = 0;
+        QElapsedTimer progressTimer;
+        QList<QPair<QString, QVariant>> originalPragmas;
+        BlockingQueue<QList<QVariant>> rowBlocks;
+        ImportDataReader* reader = nullptr;
 
     public slots:
         void interrupt();
@@ -39,6 +103,7 @@ class ImportWorker : public QObject, public QRunnable
     signals:
         void createdTable(Db* db, const QString& table);
         void finished(bool result);
+        void progress(qint64 rows, qint64 bytes);
 };
 
 #endif // IMPORTWORKER_H
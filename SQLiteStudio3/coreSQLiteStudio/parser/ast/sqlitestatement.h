@@ -2,6 +2,7 @@
 #define SQLITESTATEMENT_H
 
 #include "common/utils.h"
+#include "common/blockpool.h"
 #include "parser/token.h"
 #include "dialect.h"
 #include <QList>
@@ -185,6 +186,9 @@ class API_EXPORT SqliteStatement : public QObject
 {
     Q_OBJECT
 
+    // Parsing creates lots of statements, so all of them are allocated from the pool
+    DECLARE_BLOCK_POOL_ALLOCATION
+
     public:
         struct FullObject
         {
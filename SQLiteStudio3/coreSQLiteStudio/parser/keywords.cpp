@@ -3,9 +3,369 @@
 #include "sqlite2_parse.h"
 #include <QDebug>
 #include <QList>
+#include <cstring>
+
+namespace
+{
+    struct KeywordEntry
+    {
+        const char* keyword;
+        int tokenId;
+    };
+
+    /**
+     * @brief Compile-time hash table of keywords.
+     *
+     * Slots keep indexes of keyword entries (increased by 1, so 0 means an empty slot).
+     * Collisions are resolved with linear probing. The table is at most half full, so probe sequences are short.
+     */
+    struct KeywordHashTable
+    {
+        static constexpr int SIZE = 256;
+        static constexpr int MASK = SIZE - 1;
+
+        quint8 slots[SIZE] = {};
+    };
+
+    /**
+     * @brief Length of the longest keyword (CURRENT_TIMESTAMP).
+     */
+    constexpr int MAX_KEYWORD_LENGTH = 17;
+
+    constexpr KeywordEntry sqlite3Keywords[] =
+    {
+        {"REINDEX",             TK3_REINDEX},
+        {"INDEXED",             TK3_INDEXED},
+        {"INDEX",               TK3_INDEX},
+        {"DESC",                TK3_DESC},
+        {"ESCAPE",              TK3_ESCAPE},
+        {"EACH",                TK3_EACH},
+        {"CHECK",               TK3_CHECK},
+        {"KEY",                 TK3_KEY},
+        {"BEFORE",              TK3_BEFORE},
+        {"FOREIGN",             TK3_FOREIGN},
+        {"FOR",                 TK3_FOR},
+        {"IGNORE",              TK3_IGNORE},
+        {"REGEXP",              TK3_LIKE_KW},
+        {"EXPLAIN",             TK3_EXPLAIN},
+        {"INSTEAD",             TK3_INSTEAD},
+        {"ADD",                 TK3_ADD},
+        {"DATABASE",            TK3_DATABASE},
+        {"AS",                  TK3_AS},
+        {"SELECT",              TK3_SELECT},
+        {"TABLE",               TK3_TABLE},
+        {"LEFT",                TK3_JOIN_KW},
+        {"THEN",                TK3_THEN},
+        {"END",                 TK3_END},
+        {"DEFERRABLE",          TK3_DEFERRABLE},
+        {"ELSE",                TK3_ELSE},
+        {"EXCEPT",              TK3_EXCEPT},
+        {"TRANSACTION",         TK3_TRANSACTION},
+        {"ACTION",              TK3_ACTION},
+        {"ON",                  TK3_ON},
+        {"NATURAL",             TK3_JOIN_KW},
+        {"ALTER",               TK3_ALTER},
+        {"RAISE",               TK3_RAISE},
+        {"EXCLUSIVE",           TK3_EXCLUSIVE},
+        {"EXISTS",              TK3_EXISTS},
+        {"SAVEPOINT",           TK3_SAVEPOINT},
+        {"INTERSECT",           TK3_INTERSECT},
+        {"TRIGGER",             TK3_TRIGGER},
+        {"REFERENCES",          TK3_REFERENCES},
+        {"CONSTRAINT",          TK3_CONSTRAINT},
+        {"INTO",                TK3_INTO},
+        {"OFFSET",              TK3_OFFSET},
+        {"OF",                  TK3_OF},
+        {"SET",                 TK3_SET},
+        {"TEMP",                TK3_TEMP},
+        {"TEMPORARY",           TK3_TEMP},
+        {"OR",                  TK3_OR},
+        {"UNIQUE",              TK3_UNIQUE},
+        {"QUERY",               TK3_QUERY},
+        {"ATTACH",              TK3_ATTACH},
+        {"HAVING",              TK3_HAVING},
+        {"GROUP",               TK3_GROUP},
+        {"UPDATE",              TK3_UPDATE},
+        {"BEGIN",               TK3_BEGIN},
+        {"INNER",               TK3_JOIN_KW},
+        {"RELEASE",             TK3_RELEASE},
+        {"BETWEEN",             TK3_BETWEEN},
+        {"NOTNULL",             TK3_NOTNULL},
+        {"NOT",                 TK3_NOT},
+        {"NO",                  TK3_NO},
+        {"DO",                  TK3_DO},
+        {"NOTHING",             TK3_NOTHING},
+        {"NULL",                TK3_NULL},
+        {"LIKE",                TK3_LIKE_KW},
+        {"CASCADE",             TK3_CASCADE},
+        {"ASC",                 TK3_ASC},
+        {"DELETE",              TK3_DELETE},
+        {"CASE",                TK3_CASE},
+        {"COLLATE",             TK3_COLLATE},
+        {"CREATE",              TK3_CREATE},
+        {"CURRENT_DATE",        TK3_CTIME_KW},
+        {"DETACH",              TK3_DETACH},
+        {"IMMEDIATE",           TK3_IMMEDIATE},
+        {"JOIN",                TK3_JOIN},
+        {"INSERT",              TK3_INSERT},
+        {"MATCH",               TK3_MATCH},
+        {"PLAN",                TK3_PLAN},
+        {"ANALYZE",             TK3_ANALYZE},
+        {"PRAGMA",              TK3_PRAGMA},
+        {"ABORT",               TK3_ABORT},
+        {"VALUES",              TK3_VALUES},
+        {"VIRTUAL",             TK3_VIRTUAL},
+        {"LIMIT",               TK3_LIMIT},
+        {"WHEN",                TK3_WHEN},
+        {"WHERE",               TK3_WHERE},
+        {"RENAME",              TK3_RENAME},
+        {"AFTER",               TK3_AFTER},
+        {"REPLACE",             TK3_REPLACE},
+        {"AND",                 TK3_AND},
+        {"DEFAULT",             TK3_DEFAULT},
+        {"AUTOINCREMENT",       TK3_AUTOINCR},
+        {"TO",                  TK3_TO},
+        {"IN",                  TK3_IN},
+        {"CAST",                TK3_CAST},
+        {"COLUMN",              TK3_COLUMNKW},
+        {"COMMIT",              TK3_COMMIT},
+        {"CONFLICT",            TK3_CONFLICT},
+        {"CROSS",               TK3_JOIN_KW},
+        {"CURRENT_TIMESTAMP",   TK3_CTIME_KW},
+        {"CURRENT_TIME",        TK3_CTIME_KW},
+        {"PRIMARY",             TK3_PRIMARY},
+        {"DEFERRED",            TK3_DEFERRED},
+        {"DISTINCT",            TK3_DISTINCT},
+        {"IS",                  TK3_IS},
+        {"DROP",                TK3_DROP},
+        {"FAIL",                TK3_FAIL},
+        {"FROM",                TK3_FROM},
+        {"FULL",                TK3_JOIN_KW},
+        {"GLOB",                TK3_LIKE_KW},
+        {"BY",                  TK3_BY},
+        {"IF",                  TK3_IF},
+        {"ISNULL",              TK3_ISNULL},
+        {"ORDER",               TK3_ORDER},
+        {"RESTRICT",            TK3_RESTRICT},
+        {"OUTER",               TK3_JOIN_KW},
+        {"RIGHT",               TK3_JOIN_KW},
+        {"ROLLBACK",            TK3_ROLLBACK},
+        {"ROW",                 TK3_ROW},
+        {"UNION",               TK3_UNION},
+        {"USING",               TK3_USING},
+        {"VACUUM",              TK3_VACUUM},
+        {"VIEW",                TK3_VIEW},
+        {"INITIALLY",           TK3_INITIALLY},
+        {"WITHOUT",             TK3_WITHOUT},
+        {"ALL",                 TK3_ALL},
+        {"WITH",                TK3_WITH},
+        {"RECURSIVE",           TK3_RECURSIVE}
+    };
+
+    constexpr KeywordEntry sqlite2Keywords[] =
+    {
+        {"ABORT",         TK2_ABORT},
+        {"AFTER",         TK2_AFTER},
+        {"ALL",           TK2_ALL},
+        {"AND",           TK2_AND},
+        {"AS",            TK2_AS},
+        {"ASC",           TK2_ASC},
+        {"ATTACH",        TK2_ATTACH},
+        {"BEFORE",        TK2_BEFORE},
+        {"BEGIN",         TK2_BEGIN},
+        {"BETWEEN",       TK2_BETWEEN},
+        {"BY",            TK2_BY},
+        {"CASCADE",       TK2_CASCADE},
+        {"CASE",          TK2_CASE},
+        {"CHECK",         TK2_CHECK},
+        {"CLUSTER",       TK2_CLUSTER},
+        {"COLLATE",       TK2_COLLATE},
+        {"COMMIT",        TK2_COMMIT},
+        {"CONFLICT",      TK2_CONFLICT},
+        {"CONSTRAINT",    TK2_CONSTRAINT},
+        {"COPY",          TK2_COPY},
+        {"CREATE",        TK2_CREATE},
+        {"CROSS",         TK2_JOIN_KW},
+        {"DATABASE",      TK2_DATABASE},
+        {"DEFAULT",       TK2_DEFAULT},
+        {"DEFERRED",      TK2_DEFERRED},
+        {"DEFERRABLE",    TK2_DEFERRABLE},
+        {"DELETE",        TK2_DELETE},
+        {"DELIMITERS",    TK2_DELIMITERS},
+        {"DESC",          TK2_DESC},
+        {"DETACH",        TK2_DETACH},
+        {"DISTINCT",      TK2_DISTINCT},
+        {"DROP",          TK2_DROP},
+        {"END",           TK2_END},
+        {"EACH",          TK2_EACH},
+        {"ELSE",          TK2_ELSE},
+        {"EXCEPT",        TK2_EXCEPT},
+        {"EXPLAIN",       TK2_EXPLAIN},
+        {"FAIL",          TK2_FAIL},
+        {"FOR",           TK2_FOR},
+        {"FOREIGN",       TK2_FOREIGN},
+        {"FROM",          TK2_FROM},
+        {"FULL",          TK2_JOIN_KW},
+        {"GLOB",          TK2_GLOB},
+        {"GROUP",         TK2_GROUP},
+        {"HAVING",        TK2_HAVING},
+        {"IGNORE",        TK2_IGNORE},
+        {"IMMEDIATE",     TK2_IMMEDIATE},
+        {"IN",            TK2_IN},
+        {"INDEX",         TK2_INDEX},
+        {"INITIALLY",     TK2_INITIALLY},
+        {"INNER",         TK2_JOIN_KW},
+        {"INSERT",        TK2_INSERT},
+        {"INSTEAD",       TK2_INSTEAD},
+        {"INTERSECT",     TK2_INTERSECT},
+        {"INTO",          TK2_INTO},
+        {"IS",            TK2_IS},
+        {"ISNULL",        TK2_ISNULL},
+        {"JOIN",          TK2_JOIN},
+        {"KEY",           TK2_KEY},
+        {"LEFT",          TK2_JOIN_KW},
+        {"LIKE",          TK2_LIKE},
+        {"LIMIT",         TK2_LIMIT},
+        {"MATCH",         TK2_MATCH},
+        {"NATURAL",       TK2_JOIN_KW},
+        {"NOT",           TK2_NOT},
+        {"NOTNULL",       TK2_NOTNULL},
+        {"NULL",          TK2_NULL},
+        {"OF",            TK2_OF},
+        {"OFFSET",        TK2_OFFSET},
+        {"ON",            TK2_ON},
+        {"OR",            TK2_OR},
+        {"ORDER",         TK2_ORDER},
+        {"OUTER",         TK2_JOIN_KW},
+        {"PRAGMA",        TK2_PRAGMA},
+        {"PRIMARY",       TK2_PRIMARY},
+        {"RAISE",         TK2_RAISE},
+        {"REFERENCES",    TK2_REFERENCES},
+        {"REPLACE",       TK2_REPLACE},
+        {"RESTRICT",      TK2_RESTRICT},
+        {"RIGHT",         TK2_JOIN_KW},
+        {"ROLLBACK",      TK2_ROLLBACK},
+        {"ROW",           TK2_ROW},
+        {"SELECT",        TK2_SELECT},
+        {"SET",           TK2_SET},
+        {"STATEMENT",     TK2_STATEMENT},
+        {"TABLE",         TK2_TABLE},
+        {"TEMP",          TK2_TEMP},
+        {"TEMPORARY",     TK2_TEMP},
+        {"THEN",          TK2_THEN},
+        {"TRANSACTION",   TK2_TRANSACTION},
+        {"TRIGGER",       TK2_TRIGGER},
+        {"UNION",         TK2_UNION},
+        {"UNIQUE",        TK2_UNIQUE},
+        {"UPDATE",        TK2_UPDATE},
+        {"USING",         TK2_USING},
+        {"VACUUM",        TK2_VACUUM},
+        {"VALUES",        TK2_VALUES},
+        {"VIEW",          TK2_VIEW},
+        {"WHEN",          TK2_WHEN},
+        {"WHERE",         TK2_WHERE}
+    };
+
+    constexpr int keywordLength(const char* keyword)
+    {
+        int length = 0;
+        while (keyword[length])
+            length++;
+
+        return length;
+    }
+
+    /**
+     * @brief FNV-1a hash of the uppercase ASCII keyword.
+     */
+    constexpr quint32 keywordHash(const char* keyword, int length)
+    {
+        quint32 hash = 2166136261u;
+        for (int i = 0; i < length; i++)
+        {
+            hash ^= static_cast<quint8>(keyword[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    template <int N>
+    constexpr KeywordHashTable buildHashTable(const KeywordEntry (&entries)[N])
+    {
+        static_assert(N * 2 <= KeywordHashTable::SIZE, "Keyword hash table is too small for the number of keywords.");
+
+        KeywordHashTable table;
+        for (int i = 0; i < N; i++)
+        {
+            quint32 slot = keywordHash(entries[i].keyword, keywordLength(entries[i].keyword)) & KeywordHashTable::MASK;
+            while (table.slots[slot])
+                slot = (slot + 1) & KeywordHashTable::MASK;
+
+            table.slots[slot] = static_cast<quint8>(i + 1);
+        }
+        return table;
+    }
+
+    template <int N>
+    constexpr int maxKeywordLength(const KeywordEntry (&entries)[N])
+    {
+        int maxLength = 0;
+        for (int i = 0; i < N; i++)
+        {
+            if (keywordLength(entries[i].keyword) > maxLength)
+                maxLength = keywordLength(entries[i].keyword);
+        }
+        return maxLength;
+    }
+
+    constexpr KeywordHashTable sqlite3KeywordTable = buildHashTable(sqlite3Keywords);
+    constexpr KeywordHashTable sqlite2KeywordTable = buildHashTable(sqlite2Keywords);
+
+    static_assert(maxKeywordLength(sqlite3Keywords) <= MAX_KEYWORD_LENGTH, "MAX_KEYWORD_LENGTH is lower than the longest SQLite 3 keyword.");
+    static_assert(maxKeywordLength(sqlite2Keywords) <= MAX_KEYWORD_LENGTH, "MAX_KEYWORD_LENGTH is lower than the longest SQLite 2 keyword.");
+
+    template <int N>
+    int findKeyword(const KeywordHashTable& table, const KeywordEntry (&entries)[N], const QChar* str, int length, int notFoundId)
+    {
+        if (length <= 0 || length > MAX_KEYWORD_LENGTH)
+            return notFoundId;
+
+        // Keywords are plain ASCII, so the case is folded by hand, into a buffer on the stack
+        char upper[MAX_KEYWORD_LENGTH];
+        ushort c;
+        for (int i = 0; i < length; i++)
+        {
+            c = str[i].unicode();
+            if (c >= 'a' && c <= 'z')
+                c -= 'a' - 'A';
+            else if (c > 127)
+                return notFoundId;
+
+            upper[i] = static_cast<char>(c);
+        }
+
+        const KeywordEntry* entry = nullptr;
+        for (quint32 slot = keywordHash(upper, length) & KeywordHashTable::MASK; table.slots[slot]; slot = (slot + 1) & KeywordHashTable::MASK)
+        {
+            entry = &entries[table.slots[slot] - 1];
+            if (strncmp(entry->keyword, upper, length) == 0 && entry->keyword[length] == 0)
+                return entry->tokenId;
+        }
+        return notFoundId;
+    }
+
+    template <int N>
+    QHash<QString,int> toHash(const KeywordEntry (&entries)[N])
+    {
+        QHash<QString,int> hash;
+        hash.reserve(N);
+        for (const KeywordEntry& entry : entries)
+            hash[QString::fromLatin1(entry.keyword)] = entry.tokenId;
+
+        return hash;
+    }
+}
 
-QHash<QString,int> keywords2;
-QHash<QString,int> keywords3;
 QSet<QString> rowIdKeywords;
 QStringList joinKeywords;
 QStringList fkMatchKeywords;
@@ -13,20 +373,22 @@ QStringList conflictAlgoKeywords;
 
 int getKeywordId2(const QString& str)
 {
-    QString upStr = str.toUpper();
-    if (keywords2.contains(upStr))
-        return keywords2[upStr];
-    else
-        return TK2_ID;
+    return getKeywordId2(str.constData(), str.length());
+}
+
+int getKeywordId2(const QChar* str, int length)
+{
+    return findKeyword(sqlite2KeywordTable, sqlite2Keywords, str, length, TK2_ID);
 }
 
 int getKeywordId3(const QString& str)
 {
-    QString upStr = str.toUpper();
-    if (keywords3.contains(upStr))
-        return keywords3[upStr];
-    else
-        return TK3_ID;
+    return getKeywordId3(str.constData(), str.length());
+}
+
+int getKeywordId3(const QChar* str, int length)
+{
+    return findKeyword(sqlite3KeywordTable, sqlite3Keywords, str, length, TK3_ID);
 }
 
 bool isRowIdKeyword(const QString& str)
@@ -36,246 +398,18 @@ bool isRowIdKeyword(const QString& str)
 
 const QHash<QString,int>& getKeywords2()
 {
+    static const QHash<QString,int> keywords2 = toHash(sqlite2Keywords);
     return keywords2;
 }
 
 const QHash<QString,int>& getKeywords3()
 {
+    static const QHash<QString,int> keywords3 = toHash(sqlite3Keywords);
     return keywords3;
 }
 
 void initKeywords()
 {
-    // SQLite 3
-    keywords3["REINDEX"] = TK3_REINDEX;
-    keywords3["INDEXED"] = TK3_INDEXED;
-    keywords3["INDEX"] = TK3_INDEX;
-    keywords3["DESC"] = TK3_DESC;
-    keywords3["ESCAPE"] = TK3_ESCAPE;
-    keywords3["EACH"] = TK3_EACH;
-    keywords3["CHECK"] = TK3_CHECK;
-    keywords3["KEY"] = TK3_KEY;
-    keywords3["BEFORE"] = TK3_BEFORE;
-    keywords3["FOREIGN"] = TK3_FOREIGN;
-    keywords3["FOR"] = TK3_FOR;
-    keywords3["IGNORE"] = TK3_IGNORE;
-    keywords3["REGEXP"] = TK3_LIKE_KW;
-    keywords3["EXPLAIN"] = TK3_EXPLAIN;
-    keywords3["INSTEAD"] = TK3_INSTEAD;
-    keywords3["ADD"] = TK3_ADD;
-    keywords3["DATABASE"] = TK3_DATABASE;
-    keywords3["AS"] = TK3_AS;
-    keywords3["SELECT"] = TK3_SELECT;
-    keywords3["TABLE"] = TK3_TABLE;
-    keywords3["LEFT"] = TK3_JOIN_KW;
-    keywords3["THEN"] = TK3_THEN;
-    keywords3["END"] = TK3_END;
-    keywords3["DEFERRABLE"] = TK3_DEFERRABLE;
-    keywords3["ELSE"] = TK3_ELSE;
-    keywords3["EXCEPT"] = TK3_EXCEPT;
-    keywords3["TRANSACTION"] = TK3_TRANSACTION;
-    keywords3["ACTION"] = TK3_ACTION;
-    keywords3["ON"] = TK3_ON;
-    keywords3["NATURAL"] = TK3_JOIN_KW;
-    keywords3["ALTER"] = TK3_ALTER;
-    keywords3["RAISE"] = TK3_RAISE;
-    keywords3["EXCLUSIVE"] = TK3_EXCLUSIVE;
-    keywords3["EXISTS"] = TK3_EXISTS;
-    keywords3["SAVEPOINT"] = TK3_SAVEPOINT;
-    keywords3["INTERSECT"] = TK3_INTERSECT;
-    keywords3["TRIGGER"] = TK3_TRIGGER;
-    keywords3["REFERENCES"] = TK3_REFERENCES;
-    keywords3["CONSTRAINT"] = TK3_CONSTRAINT;
-    keywords3["INTO"] = TK3_INTO;
-    keywords3["OFFSET"] = TK3_OFFSET;
-    keywords3["OF"] = TK3_OF;
-    keywords3["SET"] = TK3_SET;
-    keywords3["TEMP"] = TK3_TEMP;
-    keywords3["TEMPORARY"] = TK3_TEMP;
-    keywords3["OR"] = TK3_OR;
-    keywords3["UNIQUE"] = TK3_UNIQUE;
-    keywords3["QUERY"] = TK3_QUERY;
-    keywords3["ATTACH"] = TK3_ATTACH;
-    keywords3["HAVING"] = TK3_HAVING;
-    keywords3["GROUP"] = TK3_GROUP;
-    keywords3["UPDATE"] = TK3_UPDATE;
-    keywords3["BEGIN"] = TK3_BEGIN;
-    keywords3["INNER"] = TK3_JOIN_KW;
-    keywords3["RELEASE"] = TK3_RELEASE;
-    keywords3["BETWEEN"] = TK3_BETWEEN;
-    keywords3["NOTNULL"] = TK3_NOTNULL;
-    keywords3["NOT"] = TK3_NOT;
-    keywords3["NO"] = TK3_NO;
-    keywords3["DO"] = TK3_DO;
-    keywords3["NOTHING"] = TK3_NOTHING;
-    keywords3["NULL"] = TK3_NULL;
-    keywords3["LIKE"] = TK3_LIKE_KW;
-    keywords3["CASCADE"] = TK3_CASCADE;
-    keywords3["ASC"] = TK3_ASC;
-    keywords3["DELETE"] = TK3_DELETE;
-    keywords3["CASE"] = TK3_CASE;
-    keywords3["COLLATE"] = TK3_COLLATE;
-    keywords3["CREATE"] = TK3_CREATE;
-    keywords3["CURRENT_DATE"] = TK3_CTIME_KW;
-    keywords3["DETACH"] = TK3_DETACH;
-    keywords3["IMMEDIATE"] = TK3_IMMEDIATE;
-    keywords3["JOIN"] = TK3_JOIN;
-    keywords3["INSERT"] = TK3_INSERT;
-    keywords3["MATCH"] = TK3_MATCH;
-    keywords3["PLAN"] = TK3_PLAN;
-    keywords3["ANALYZE"] = TK3_ANALYZE;
-    keywords3["PRAGMA"] = TK3_PRAGMA;
-    keywords3["ABORT"] = TK3_ABORT;
-    keywords3["VALUES"] = TK3_VALUES;
-    keywords3["VIRTUAL"] = TK3_VIRTUAL;
-    keywords3["LIMIT"] = TK3_LIMIT;
-    keywords3["WHEN"] = TK3_WHEN;
-    keywords3["WHERE"] = TK3_WHERE;
-    keywords3["RENAME"] = TK3_RENAME;
-    keywords3["AFTER"] = TK3_AFTER;
-    keywords3["REPLACE"] = TK3_REPLACE;
-    keywords3["AND"] = TK3_AND;
-    keywords3["DEFAULT"] = TK3_DEFAULT;
-    keywords3["AUTOINCREMENT"] = TK3_AUTOINCR;
-    keywords3["TO"] = TK3_TO;
-    keywords3["IN"] = TK3_IN;
-    keywords3["CAST"] = TK3_CAST;
-    keywords3["COLUMN"] = TK3_COLUMNKW;
-    keywords3["COMMIT"] = TK3_COMMIT;
-    keywords3["CONFLICT"] = TK3_CONFLICT;
-    keywords3["CROSS"] = TK3_JOIN_KW;
-    keywords3["CURRENT_TIMESTAMP"] = TK3_CTIME_KW;
-    keywords3["CURRENT_TIME"] = TK3_CTIME_KW;
-    keywords3["PRIMARY"] = TK3_PRIMARY;
-    keywords3["DEFERRED"] = TK3_DEFERRED;
-    keywords3["DISTINCT"] = TK3_DISTINCT;
-    keywords3["IS"] = TK3_IS;
-    keywords3["DROP"] = TK3_DROP;
-    keywords3["FAIL"] = TK3_FAIL;
-    keywords3["FROM"] = TK3_FROM;
-    keywords3["FULL"] = TK3_JOIN_KW;
-    keywords3["GLOB"] = TK3_LIKE_KW;
-    keywords3["BY"] = TK3_BY;
-    keywords3["IF"] = TK3_IF;
-    keywords3["ISNULL"] = TK3_ISNULL;
-    keywords3["ORDER"] = TK3_ORDER;
-    keywords3["RESTRICT"] = TK3_RESTRICT;
-    keywords3["OUTER"] = TK3_JOIN_KW;
-    keywords3["RIGHT"] = TK3_JOIN_KW;
-    keywords3["ROLLBACK"] = TK3_ROLLBACK;
-    keywords3["ROW"] = TK3_ROW;
-    keywords3["UNION"] = TK3_UNION;
-    keywords3["USING"] = TK3_USING;
-    keywords3["VACUUM"] = TK3_VACUUM;
-    keywords3["VIEW"] = TK3_VIEW;
-    keywords3["INITIALLY"] = TK3_INITIALLY;
-    keywords3["WITHOUT"] = TK3_WITHOUT;
-    keywords3["ALL"] = TK3_ALL;
-    keywords3["WITH"] = TK3_WITH;
-    keywords3["RECURSIVE"] = TK3_RECURSIVE;
-
-    // SQLite 2
-    keywords2["ABORT"] = TK2_ABORT;
-    keywords2["AFTER"] = TK2_AFTER;
-    keywords2["ALL"] = TK2_ALL;
-    keywords2["AND"] = TK2_AND;
-    keywords2["AS"] = TK2_AS;
-    keywords2["ASC"] = TK2_ASC;
-    keywords2["ATTACH"] = TK2_ATTACH;
-    keywords2["BEFORE"] = TK2_BEFORE;
-    keywords2["BEGIN"] = TK2_BEGIN;
-    keywords2["BETWEEN"] = TK2_BETWEEN;
-    keywords2["BY"] = TK2_BY;
-    keywords2["CASCADE"] = TK2_CASCADE;
-    keywords2["CASE"] = TK2_CASE;
-    keywords2["CHECK"] = TK2_CHECK;
-    keywords2["CLUSTER"] = TK2_CLUSTER;
-    keywords2["COLLATE"] = TK2_COLLATE;
-    keywords2["COMMIT"] = TK2_COMMIT;
-    keywords2["CONFLICT"] = TK2_CONFLICT;
-    keywords2["CONSTRAINT"] = TK2_CONSTRAINT;
-    keywords2["COPY"] = TK2_COPY;
-    keywords2["CREATE"] = TK2_CREATE;
-    keywords2["CROSS"] = TK2_JOIN_KW;
-    keywords2["DATABASE"] = TK2_DATABASE;
-    keywords2["DEFAULT"] = TK2_DEFAULT;
-    keywords2["DEFERRED"] = TK2_DEFERRED;
-    keywords2["DEFERRABLE"] = TK2_DEFERRABLE;
-    keywords2["DELETE"] = TK2_DELETE;
-    keywords2["DELIMITERS"] = TK2_DELIMITERS;
-    keywords2["DESC"] = TK2_DESC;
-    keywords2["DETACH"] = TK2_DETACH;
-    keywords2["DISTINCT"] = TK2_DISTINCT;
-    keywords2["DROP"] = TK2_DROP;
-    keywords2["END"] = TK2_END;
-    keywords2["EACH"] = TK2_EACH;
-    keywords2["ELSE"] = TK2_ELSE;
-    keywords2["EXCEPT"] = TK2_EXCEPT;
-    keywords2["EXPLAIN"] = TK2_EXPLAIN;
-    keywords2["FAIL"] = TK2_FAIL;
-    keywords2["FOR"] = TK2_FOR;
-    keywords2["FOREIGN"] = TK2_FOREIGN;
-    keywords2["FROM"] = TK2_FROM;
-    keywords2["FULL"] = TK2_JOIN_KW;
-    keywords2["GLOB"] = TK2_GLOB;
-    keywords2["GROUP"] = TK2_GROUP;
-    keywords2["HAVING"] = TK2_HAVING;
-    keywords2["IGNORE"] = TK2_IGNORE;
-    keywords2["IMMEDIATE"] = TK2_IMMEDIATE;
-    keywords2["IN"] = TK2_IN;
-    keywords2["INDEX"] = TK2_INDEX;
-    keywords2["INITIALLY"] = TK2_INITIALLY;
-    keywords2["INNER"] = TK2_JOIN_KW;
-    keywords2["INSERT"] = TK2_INSERT;
-    keywords2["INSTEAD"] = TK2_INSTEAD;
-    keywords2["INTERSECT"] = TK2_INTERSECT;
-    keywords2["INTO"] = TK2_INTO;
-    keywords2["IS"] = TK2_IS;
-    keywords2["ISNULL"] = TK2_ISNULL;
-    keywords2["JOIN"] = TK2_JOIN;
-    keywords2["KEY"] = TK2_KEY;
-    keywords2["LEFT"] = TK2_JOIN_KW;
-    keywords2["LIKE"] = TK2_LIKE;
-    keywords2["LIMIT"] = TK2_LIMIT;
-    keywords2["MATCH"] = TK2_MATCH;
-    keywords2["NATURAL"] = TK2_JOIN_KW;
-    keywords2["NOT"] = TK2_NOT;
-    keywords2["NOTNULL"] = TK2_NOTNULL;
-    keywords2["NULL"] = TK2_NULL;
-    keywords2["OF"] = TK2_OF;
-    keywords2["OFFSET"] = TK2_OFFSET;
-    keywords2["ON"] = TK2_ON;
-    keywords2["OR"] = TK2_OR;
-    keywords2["ORDER"] = TK2_ORDER;
-    keywords2["OUTER"] = TK2_JOIN_KW;
-    keywords2["PRAGMA"] = TK2_PRAGMA;
-    keywords2["PRIMARY"] = TK2_PRIMARY;
-    keywords2["RAISE"] = TK2_RAISE;
-    keywords2["REFERENCES"] = TK2_REFERENCES;
-    keywords2["REPLACE"] = TK2_REPLACE;
-    keywords2["RESTRICT"] = TK2_RESTRICT;
-    keywords2["RIGHT"] = TK2_JOIN_KW;
-    keywords2["ROLLBACK"] = TK2_ROLLBACK;
-    keywords2["ROW"] = TK2_ROW;
-    keywords2["SELECT"] = TK2_SELECT;
-    keywords2["SET"] = TK2_SET;
-    keywords2["STATEMENT"] = TK2_STATEMENT;
-    keywords2["TABLE"] = TK2_TABLE;
-    keywords2["TEMP"] = TK2_TEMP;
-    keywords2["TEMPORARY"] = TK2_TEMP;
-    keywords2["THEN"] = TK2_THEN;
-    keywords2["TRANSACTION"] = TK2_TRANSACTION;
-    keywords2["TRIGGER"] = TK2_TRIGGER;
-    keywords2["UNION"] = TK2_UNION;
-    keywords2["UNIQUE"] = TK2_UNIQUE;
-    keywords2["UPDATE"] = TK2_UPDATE;
-    keywords2["USING"] = TK2_USING;
-    keywords2["VACUUM"] = TK2_VACUUM;
-    keywords2["VALUES"] = TK2_VALUES;
-    keywords2["VIEW"] = TK2_VIEW;
-    keywords2["WHEN"] = TK2_WHEN;
-    keywords2["WHERE"] = TK2_WHERE;
-
     rowIdKeywords << "_ROWID_"
                   << "ROWID"
                   << "OID";
@@ -313,9 +447,9 @@ bool isKeyword(const QString& str, Dialect dialect)
     switch (dialect)
     {
         case Dialect::Sqlite3:
-            return keywords3.contains(str.toUpper());
+            return getKeywordId3(str) != TK3_ID;
         case Dialect::Sqlite2:
-            return keywords2.contains(str.toUpper());
+            return getKeywordId2(str) != TK2_ID;
     }
     return false;
 }
@@ -19,6 +19,16 @@
  */
 API_EXPORT int getKeywordId2(const QString& str);
 
+/**
+ * @brief Translates keyword into it's Lemon token ID for SQLite 2 dialect.
+ * @param str Pointer to the first character of the keyword.
+ * @param length Number of characters in the keyword.
+ * @return Lemon generated token ID, or TK2_ID value when the string was not recognized as a valid SQLite 2 keyword.
+ *
+ * This version lets the Lexer look up the keyword directly in the source string, without copying it.
+ */
+API_EXPORT int getKeywordId2(const QChar* str, int length);
+
 /**
  * @brief Translates keyword into it's Lemon token ID for SQLite 3 dialect.
  * @param str The keyword.
@@ -29,6 +39,16 @@ API_EXPORT int getKeywordId2(const QString& str);
  */
 API_EXPORT int getKeywordId3(const QString& str);
 
+/**
+ * @brief Translates keyword into it's Lemon token ID for SQLite 3 dialect.
+ * @param str Pointer to the first character of the keyword.
+ * @param length Number of characters in the keyword.
+ * @return Lemon generated token ID, or TK3_ID value when the string was not recognized as a valid SQLite 3 keyword.
+ *
+ * This version lets the Lexer look up the keyword directly in the source string, without copying it.
+ */
+API_EXPORT int getKeywordId3(const QChar* str, int length);
+
 /**
  * @brief Tests whether given string represents a keyword in given SQLite dialect.
  * @param str String to test.
@@ -104,10 +124,10 @@ API_EXPORT QStringList getFkMatchKeywords();
 API_EXPORT bool isFkMatchKeyword(const QString& str);
 
 /**
- * @brief Initializes internal tables of keywords.
+ * @brief Initializes internal lists of keywords.
  *
- * This has to be (and it is) done at application startup. It defines all internal hash tables
- * and lists with keywords.
+ * This has to be (and it is) done at application startup. It defines lists with special groups of keywords.
+ * Keyword-to-Lemon-ID tables are built at compile time and don't need any initialization.
  */
 API_EXPORT void initKeywords();
 
@@ -16,7 +16,7 @@ TokenPtr Lexer::semicolonTokenSqlite2;
 TokenPtr Lexer::semicolonTokenSqlite3;
 
 Lexer::Lexer(Dialect dialect)
-    : dialect(dialect), sqlToTokenize(QString())
+    : dialect(dialect), sqlToTokenize(QString()), tokenPosition(0)
 {
 }
 
@@ -30,41 +30,50 @@ TokenList Lexer::tokenize(const QString &sql)
     TokenList resultList;
     int lgt;
     TokenPtr token;
-    QString str = sql;
+    int sqliteVersion = (dialect == Dialect::Sqlite2 ? 2 : 3);
+    int size = sql.size();
 
-    quint64 pos = 0;
-    for (;str.size() > 0;)
+    for (int pos = 0; pos < size; pos += lgt)
     {
         if (tolerant)
             token = TolerantTokenPtr::create();
         else
             token = TokenPtr::create();
 
-        lgt = lexerGetToken(str, token, dialect == Dialect::Sqlite2 ? 2 : 3, tolerant);
+        lgt = lexerGetToken(sql, pos, token, sqliteVersion, tolerant);
         if (lgt == 0)
             break;
 
-        token->value = str.mid(0, lgt);
+        token->value = sql.mid(pos, lgt);
         token->start = pos;
         token->end = pos + lgt - 1;
 
         resultList << token;
-        str = str.mid(lgt);
-        pos += lgt;
     }
 
     return resultList;
 }
 
 void Lexer::prepare(const QString &sql)
+{
+    prepare(sql, OpenToken::NONE);
+}
+
+void Lexer::prepare(const QString& sql, OpenToken openToken)
 {
     sqlToTokenize = sql;
     tokenPosition = 0;
+    this->openToken = tolerant ? openToken : OpenToken::NONE;
+}
+
+Lexer::OpenToken Lexer::getOpenToken() const
+{
+    return openToken;
 }
 
 TokenPtr Lexer::getToken()
 {
-    if (sqlToTokenize.isEmpty())
+    if (isEnd())
         return TokenPtr();
 
     TokenPtr token;
@@ -73,17 +82,25 @@ TokenPtr Lexer::getToken()
     else
         token = TokenPtr::create();
 
-    int lgt = lexerGetToken(sqlToTokenize, token, dialect == Dialect::Sqlite2 ? 2 : 3, tolerant);
+    int sqliteVersion = (dialect == Dialect::Sqlite2 ? 2 : 3);
+    int lgt;
+    if (openToken != OpenToken::NONE)
+        lgt = lexerGetContinuedToken(sqlToTokenize, tokenPosition, token, sqliteVersion, openToken);
+    else
+        lgt = lexerGetToken(sqlToTokenize, tokenPosition, token, sqliteVersion, tolerant);
+
     if (lgt == 0)
         return TokenPtr();
 
-    token->value = sqlToTokenize.mid(0, lgt);
+    token->value = sqlToTokenize.mid(tokenPosition, lgt);
     token->start = tokenPosition;
     token->end = tokenPosition + lgt - 1;
 
-    sqlToTokenize = sqlToTokenize.mid(lgt);
     tokenPosition += lgt;
 
+    if (tolerant)
+        openToken = resolveOpenToken(token.staticCast<TolerantToken>(), openToken);
+
     return token;
 }
 
@@ -91,6 +108,50 @@ void Lexer::cleanUp()
 {
     sqlToTokenize.clear();
     tokenPosition = 0;
+    openToken = OpenToken::NONE;
+}
+
+Lexer::OpenToken Lexer::resolveOpenToken(const TolerantTokenPtr& token, OpenToken continuedToken)
+{
+    if (!token->invalid)
+        return OpenToken::NONE;
+
+    // Continued token is invalid only if it's still not closed
+    if (continuedToken != OpenToken::NONE)
+        return continuedToken;
+
+    switch (token->type)
+    {
+        case Token::STRING:
+            return OpenToken::STRING;
+        case Token::COMMENT:
+            return OpenToken::COMMENT;
+        case Token::BLOB:
+        {
+            // Blob is invalid also when it has odd number of digits or non-hex digits, but then it's closed
+            int lgt = token->value.length();
+            if (lgt > 2 && token->value[lgt - 1] == '\'')
+                return OpenToken::NONE;
+
+            return OpenToken::BLOB;
+        }
+        case Token::OTHER:
+        {
+            switch (token->value[0].unicode())
+            {
+                case '[':
+                    return OpenToken::ID_BRACKET;
+                case '"':
+                    return OpenToken::ID_DOUBLE_QUOTE;
+                case '`':
+                    return OpenToken::ID_GRAVE_ACCENT;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return OpenToken::NONE;
 }
 
 void Lexer::setTolerantMode(bool enabled)
@@ -127,7 +188,7 @@ QSet<TokenPtr> Lexer::getEveryTokenType(QSet<Token::Type> types)
 
 bool Lexer::isEnd() const
 {
-    return sqlToTokenize.isEmpty();
+    return tokenPosition >= sqlToTokenize.size();
 }
 
 TokenPtr Lexer::getSemicolonToken(Dialect dialect)
@@ -23,6 +23,23 @@
 class API_EXPORT Lexer
 {
     public:
+        /**
+         * @brief Kind of token left unfinished at the end of tokenized text.
+         *
+         * It's used to carry the lexer state between separately tokenized chunks of a query,
+         * like lines in the SQL editor. See prepare(const QString&, OpenToken) and getOpenToken().
+         */
+        enum class OpenToken
+        {
+            NONE,            /**< All tokens were finished. */
+            STRING,          /**< 'string */
+            BLOB,            /**< x'blob */
+            COMMENT,         /**< &#47;* comment */
+            ID_BRACKET,      /**< [id */
+            ID_DOUBLE_QUOTE, /**< "id */
+            ID_GRAVE_ACCENT  /**< `id */
+        };
+
         /**
          * @brief Creates lexer for given dialect.
          * @param dialect SQLite dialect.
@@ -49,6 +66,26 @@ class API_EXPORT Lexer
          */
         void prepare(const QString& sql);
 
+        /**
+         * @brief Stores given SQL query internally, continuing a token opened before the query.
+         * @param sql Query to remember.
+         * @param openToken Kind of token left open at the end of previous chunk of the query, as returned by getOpenToken().
+         *
+         * The first token returned by getToken() will be the rest of the open token.
+         * Continuing tokens is supported only in tolerant mode, otherwise the \p openToken is ignored.
+         * No part of previous chunk is needed, so chunks of a long query can be tokenized one by one
+         * at a cost proportional to the chunk length.
+         */
+        void prepare(const QString& sql, OpenToken openToken);
+
+        /**
+         * @brief Provides kind of token left unfinished by the last token read with getToken().
+         * @return Open token kind, or OpenToken::NONE if the last token was finished, or if the lexer is not in tolerant mode.
+         *
+         * Value returned after reading all tokens can be passed to prepare(const QString&, OpenToken) for the next chunk of the query.
+         */
+        OpenToken getOpenToken() const;
+
         /**
          * @brief Gets next token from query defined with prepare().
          * @return Token read from the query, or null token if no more tokens are available.
@@ -193,6 +230,14 @@ class API_EXPORT Lexer
          */
         static TokenPtr createTokenType(Dialect dialect, int lemonType, Token::Type type, const QString& value);
 
+        /**
+         * @brief Determinates whether the token is left open.
+         * @param token Token read in tolerant mode.
+         * @param continuedToken Kind of open token that the \p token continues, or OpenToken::NONE if it's a regular token.
+         * @return Kind of token that is still open after the \p token.
+         */
+        static OpenToken resolveOpenToken(const TolerantTokenPtr& token, OpenToken continuedToken);
+
         /**
          * @brief Current "tolerant mode" flag.
          *
@@ -208,7 +253,8 @@ class API_EXPORT Lexer
         /**
          * @brief SQL query to be tokenized with getToken().
          *
-         * It's defined with prepare().
+         * It's defined with prepare(). It's never modified while tokenizing,
+         * only the tokenPosition is moved forward.
          */
         QString sqlToTokenize;
 
@@ -220,7 +266,14 @@ class API_EXPORT Lexer
          *
          * It's reset to 0 by prepare() and cleanUp().
          */
-        quint64 tokenPosition;
+        int tokenPosition;
+
+        /**
+         * @brief Kind of token open at the tokenPosition.
+         *
+         * It's defined with prepare() for the beginning of the query and updated by getToken().
+         */
+        OpenToken openToken = OpenToken::NONE;
 
         /**
          * @brief Internal table of every token type for SQLite 2.
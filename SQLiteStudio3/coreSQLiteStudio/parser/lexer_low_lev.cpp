@@ -19,7 +19,7 @@ bool isIdChar(const QChar& c)
     return c.isPrint() && !c.isSpace() && !doesObjectNeedWrapping(c);
 }
 
-int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tolerant)
+int lexerGetToken(const QString& sql, int offset, TokenPtr token, int sqliteVersion, bool tolerant)
 {
     if (sqliteVersion < 2 || sqliteVersion > 3)
     {
@@ -27,31 +27,44 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         return 0;
     }
 
-    if (tolerant && !token.dynamicCast<TolerantToken>())
+    TolerantToken* tolerantToken = nullptr;
+    if (tolerant)
     {
-        qCritical() << "lexerGetToken() called with tolerant=true, but not a TolerantToken entity!";
-        return 0;
+        tolerantToken = dynamic_cast<TolerantToken*>(token.data());
+        if (!tolerantToken)
+        {
+            qCritical() << "lexerGetToken() called with tolerant=true, but not a TolerantToken entity!";
+            return 0;
+        }
     }
 
+    // All characters are read relative to the offset, so the input is never copied.
+    const QChar* z = sql.constData() + offset;
+    int zLength = sql.size() - offset;
+    auto charAt = [z, zLength](int pos) -> QChar
+    {
+        return (pos >= 0 && pos < zLength) ? z[pos] : QChar(0);
+    };
+
     bool v3 = sqliteVersion == 3;
     int i;
     QChar c;
-    QChar z0 = charAt(z, 0);
+    QChar z0 = charAt(0);
 
     for (;;)
     {
         if (z0.isSpace())
         {
-            for(i=1; charAt(z, i).isSpace(); i++) {}
+            for(i=1; charAt(i).isSpace(); i++) {}
             token->lemonType = v3 ? TK3_SPACE : TK2_SPACE;
             token->type = Token::SPACE;
             return i;
         }
         if (z0 == '-')
         {
-            if (charAt(z, 1) == '-')
+            if (charAt(1) == '-')
             {
-                for (i=2; !(c = charAt(z, i)).isNull() && c != '\n'; i++) {}
+                for (i=2; !(c = charAt(i)).isNull() && c != '\n'; i++) {}
                 token->lemonType = v3 ? TK3_COMMENT : TK2_COMMENT;
                 token->type = Token::COMMENT;
                 return i;
@@ -92,26 +105,26 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         }
         if (z0 == '/')
         {
-            if ( charAt(z, 1) != '*' )
+            if ( charAt(1) != '*' )
             {
                 token->lemonType = v3 ? TK3_SLASH : TK2_SLASH;
                 token->type = Token::OPERATOR;
                 return 1;
             }
 
-            if ( charAt(z, 2).isNull() )
+            if ( charAt(2).isNull() )
             {
                 token->lemonType = v3 ? TK3_COMMENT : TK2_COMMENT;
                 token->type = Token::COMMENT;
                 if (tolerant)
-                    token.dynamicCast<TolerantToken>()->invalid = true;
+                    tolerantToken->invalid = true;
 
                 return 2;
             }
-            for (i = 3, c = charAt(z, 2); (c != '*' || charAt(z, i) != '/') && !(c = charAt(z, i)).isNull(); i++) {}
+            for (i = 3, c = charAt(2); (c != '*' || charAt(i) != '/') && !(c = charAt(i)).isNull(); i++) {}
 
-            if (tolerant && (c != '*' || charAt(z, i) != '/'))
-                token.dynamicCast<TolerantToken>()->invalid = true;
+            if (tolerant && (c != '*' || charAt(i) != '/'))
+                tolerantToken->invalid = true;
 
 #if QT_VERSION >= 0x050800
             if ( c.unicode() > 0 )
@@ -133,11 +146,11 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         {
             token->lemonType = v3 ? TK3_EQ : TK2_EQ;
             token->type = Token::OPERATOR;
-            return 1 + (charAt(z, 1) == '=');
+            return 1 + (charAt(1) == '=');
         }
         if (z0 == '<')
         {
-            if ( (c = charAt(z, 1)) == '=' )
+            if ( (c = charAt(1)) == '=' )
             {
                 token->lemonType = v3 ? TK3_LE : TK2_LE;
                 token->type = Token::OPERATOR;
@@ -164,7 +177,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         }
         if (z0 == '>')
         {
-            if ( (c = charAt(z, 1)) == '=' )
+            if ( (c = charAt(1)) == '=' )
             {
                 token->lemonType = v3 ? TK3_GE : TK2_GE;
                 token->type = Token::OPERATOR;
@@ -185,7 +198,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         }
         if (z0 == '!')
         {
-            if ( charAt(z, 1) != '=' )
+            if ( charAt(1) != '=' )
             {
                 token->lemonType = v3 ? TK3_ILLEGAL : TK2_ILLEGAL;
                 token->type = Token::INVALID;
@@ -200,7 +213,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         }
         if (z0 == '|')
         {
-            if( charAt(z, 1) != '|' )
+            if( charAt(1) != '|' )
             {
                 token->lemonType = v3 ? TK3_BITOR : TK2_BITOR;
                 token->type = Token::OPERATOR;
@@ -236,11 +249,11 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
             z0 == '"')
         {
             QChar delim = z0;
-            for (i = 1; !(c = charAt(z, i)).isNull(); i++)
+            for (i = 1; !(c = charAt(i)).isNull(); i++)
             {
                 if ( c == delim )
                 {
-                    if( charAt(z, i+1) == delim )
+                    if( charAt(i+1) == delim )
                         i++;
                     else
                         break;
@@ -270,7 +283,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
                     token->lemonType = v3 ? TK3_ID : TK2_ID;
                     token->type = Token::OTHER;
                 }
-                token.dynamicCast<TolerantToken>()->invalid = true;
+                tolerantToken->invalid = true;
                 return i;
             }
             else
@@ -282,7 +295,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         }
         if (z0 == '.')
         {
-            if( !charAt(z, 1).isDigit() )
+            if( !charAt(1).isDigit() )
             {
                 token->lemonType = v3 ? TK3_DOT : TK2_DOT;
                 token->type = Token::OPERATOR;
@@ -297,35 +310,35 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         {
             token->lemonType = v3 ? TK3_INTEGER : TK2_INTEGER;
             token->type = Token::INTEGER;
-            if (v3 && charAt(z, 0) == '0' && (charAt(z, 1) == 'x' || charAt(z, 1) == 'X') && isHex(charAt(z, 2)))
+            if (v3 && charAt(0) == '0' && (charAt(1) == 'x' || charAt(1) == 'X') && isHex(charAt(2)))
             {
-                for (i=3; isHex(charAt(z, i)); i++) {}
+                for (i=3; isHex(charAt(i)); i++) {}
                 return i;
             }
-            for (i=0; charAt(z, i).isDigit(); i++) {}
-            if ( charAt(z, i) == '.' )
+            for (i=0; charAt(i).isDigit(); i++) {}
+            if ( charAt(i) == '.' )
             {
                 i++;
-                while ( charAt(z, i).isDigit() )
+                while ( charAt(i).isDigit() )
                     i++;
 
                 token->lemonType = v3 ? TK3_FLOAT : TK2_FLOAT;
                 token->type = Token::FLOAT;
             }
-            if ( (charAt(z, i) == 'e' || charAt(z, i) == 'E') &&
-                 ( charAt(z, i+1).isDigit()
-                   || ((charAt(z, i+1) == '+' || charAt(z, i+1) == '-') && charAt(z, i+2).isDigit())
+            if ( (charAt(i) == 'e' || charAt(i) == 'E') &&
+                 ( charAt(i+1).isDigit()
+                   || ((charAt(i+1) == '+' || charAt(i+1) == '-') && charAt(i+2).isDigit())
                  )
                )
             {
                 i += 2;
-                while ( charAt(z, i).isDigit() )
+                while ( charAt(i).isDigit() )
                     i++;
 
                 token->lemonType = v3 ? TK3_FLOAT : TK2_FLOAT;
                 token->type = Token::FLOAT;
             }
-            while ( isIdChar(charAt(z, i)) )
+            while ( isIdChar(charAt(i)) )
             {
                 token->lemonType = v3 ? TK3_ILLEGAL : TK2_ILLEGAL;
                 token->type = Token::INVALID;
@@ -335,7 +348,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         }
         if (z0 == '[')
         {
-            for (i = 1, c = z0; c!=']' && !(c = charAt(z, i)).isNull(); i++) {}
+            for (i = 1, c = z0; c!=']' && !(c = charAt(i)).isNull(); i++) {}
             if (c == ']')
             {
                 token->lemonType = v3 ? TK3_ID : TK2_ID;
@@ -345,7 +358,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
             {
                 token->lemonType = v3 ? TK3_ID : TK2_ID;
                 token->type = Token::OTHER;
-                token.dynamicCast<TolerantToken>()->invalid = true;
+                tolerantToken->invalid = true;
             }
             else
             {
@@ -358,7 +371,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
         {
             token->lemonType = v3 ? TK3_VARIABLE : TK2_VARIABLE;
             token->type = Token::BIND_PARAM;
-            for (i=1; charAt(z, i).isDigit(); i++) {}
+            for (i=1; charAt(i).isDigit(); i++) {}
             return i;
         }
         if (z0 == '$' ||
@@ -368,7 +381,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
             int n = 0;
             token->lemonType = v3 ? TK3_VARIABLE : TK2_VARIABLE;
             token->type = Token::BIND_PARAM;
-            for (i = 1; !(c = charAt(z, i)).isNull(); i++)
+            for (i = 1; !(c = charAt(i)).isNull(); i++)
             {
                 if ( isIdChar(c) )
                 {
@@ -380,7 +393,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
                     {
                         i++;
                     }
-                    while ( !(c = charAt(z, i)).isNull() && !c.isSpace() && c != ')' );
+                    while ( !(c = charAt(i)).isNull() && !c.isSpace() && c != ')' );
 
                     if ( c==')' )
                     {
@@ -393,7 +406,7 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
                     }
                     break;
                 }
-                else if ( c == ':' && charAt(z, i+1) == ':' )
+                else if ( c == ':' && charAt(i+1) == ':' )
                 {
                     i++;
                 }
@@ -414,18 +427,18 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
              z0 == 'X') &&
              v3)
         {
-            if ( charAt(z, 1) == '\'' )
+            if ( charAt(1) == '\'' )
             {
                 token->lemonType = TK3_BLOB;
                 token->type = Token::BLOB;
-                for (i = 2; isXDigit(charAt(z, i)); i++) {}
-                if (charAt(z, i) != '\'' || i%2)
+                for (i = 2; isXDigit(charAt(i)); i++) {}
+                if (charAt(i) != '\'' || i%2)
                 {
                     if (tolerant)
                     {
                         token->lemonType = TK3_BLOB;
                         token->type = Token::BLOB;
-                        token.dynamicCast<TolerantToken>()->invalid = true;
+                        tolerantToken->invalid = true;
                     }
                     else
                     {
@@ -433,16 +446,16 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
                         token->type = Token::INVALID;
                     }
 #if QT_VERSION >= 0x050800
-                    while (charAt(z, i).unicode() > 0 && charAt(z, i).unicode() != '\'')
+                    while (charAt(i).unicode() > 0 && charAt(i).unicode() != '\'')
 #else
-                    while (charAt(z, i) > 0 && charAt(z, i) != '\'')
+                    while (charAt(i) > 0 && charAt(i) != '\'')
 #endif
                         i++;
                 }
 #if QT_VERSION >= 0x050800
-                if ( charAt(z, i).unicode() > 0 )
+                if ( charAt(i).unicode() > 0 )
 #else
-                if ( charAt(z, i) > 0 )
+                if ( charAt(i) > 0 )
 #endif
                     i++;
 
@@ -455,12 +468,12 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
             if (!isIdChar(z0))
                 break;
 
-            for (i = 1; isIdChar(charAt(z, i)); i++) {}
+            for (i = 1; isIdChar(charAt(i)); i++) {}
 
             if (v3)
-                token->lemonType = getKeywordId3(z.mid(0, i));
+                token->lemonType = getKeywordId3(z, i);
             else
-                token->lemonType = getKeywordId2(z.mid(0, i));
+                token->lemonType = getKeywordId2(z, i);
 
             if (token->lemonType == TK3_ID || token->lemonType == TK2_ID)
                 token->type = Token::OTHER;
@@ -480,3 +493,92 @@ int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tole
     return 1;
 }
 
+
+int lexerGetContinuedToken(const QString& sql, int offset, TokenPtr token, int sqliteVersion, Lexer::OpenToken openToken)
+{
+    TolerantToken* tolerantToken = dynamic_cast<TolerantToken*>(token.data());
+    if (!tolerantToken)
+    {
+        qCritical() << "lexerGetContinuedToken() called with not a TolerantToken entity!";
+        return 0;
+    }
+
+    const QChar* z = sql.constData() + offset;
+    int zLength = sql.size() - offset;
+    if (zLength <= 0)
+        return 0;
+
+    bool v3 = sqliteVersion == 3;
+    int i = 0;
+    bool closed = false;
+    switch (openToken)
+    {
+        case Lexer::OpenToken::STRING:
+        case Lexer::OpenToken::ID_DOUBLE_QUOTE:
+        case Lexer::OpenToken::ID_GRAVE_ACCENT:
+        {
+            QChar delim = (openToken == Lexer::OpenToken::STRING) ? '\'' : (openToken == Lexer::OpenToken::ID_DOUBLE_QUOTE ? '"' : '`');
+            for (; i < zLength; i++)
+            {
+                if (z[i] != delim)
+                    continue;
+
+                if (i + 1 < zLength && z[i+1] == delim)
+                {
+                    i++;
+                    continue;
+                }
+
+                closed = true;
+                i++;
+                break;
+            }
+
+            if (openToken == Lexer::OpenToken::STRING)
+            {
+                token->lemonType = v3 ? TK3_STRING : TK2_STRING;
+                token->type = Token::STRING;
+            }
+            else
+            {
+                token->lemonType = v3 ? TK3_ID : TK2_ID;
+                token->type = Token::OTHER;
+            }
+            break;
+        }
+        case Lexer::OpenToken::ID_BRACKET:
+        {
+            for (; i < zLength && !closed; i++)
+                closed = (z[i] == ']');
+
+            token->lemonType = v3 ? TK3_ID : TK2_ID;
+            token->type = Token::OTHER;
+            break;
+        }
+        case Lexer::OpenToken::COMMENT:
+        {
+            for (; i < zLength && !closed; i++)
+                closed = (z[i] == '/' && i > 0 && z[i-1] == '*');
+
+            token->lemonType = v3 ? TK3_COMMENT : TK2_COMMENT;
+            token->type = Token::COMMENT;
+            break;
+        }
+        case Lexer::OpenToken::BLOB:
+        {
+            for (; i < zLength && !closed; i++)
+                closed = (z[i] == '\'');
+
+            // Only SQLite 3 has blob literals, so there's no SQLite 2 token ID for it
+            token->lemonType = TK3_BLOB;
+            token->type = Token::BLOB;
+            break;
+        }
+        case Lexer::OpenToken::NONE:
+            qCritical() << "lexerGetContinuedToken() called with no open token!";
+            return 0;
+    }
+
+    tolerantToken->invalid = !closed;
+    return i;
+}
@@ -2,6 +2,7 @@
 #define LEXER_LOW_LEV_H
 
 #include "parser/token.h"
+#include "parser/lexer.h"
 #include <QString>
 #include <QTextStream>
 
@@ -9,20 +10,39 @@
 
 /**
  * @brief Low level tokenizer function used by the Lexer.
- * @param z Query to tokenize.
+ * @param sql Query to tokenize.
+ * @param offset Position in \p sql at which the token starts.
  * @param[out] token Token container to fill with values. Can be also a TolerantToken.
  * @param sqliteVersion SQLite version, for which the tokenizer should work (2 or 3).
  * Version affects the list of recognized keywords, a BLOB expression and an object name wrapper with the grave accent character (`).
  * @param tolerant If true, then all multi-line and unfinished tokens (strings, comments)
  * will be reported with invalid=true in TolerantToken, but the token itself will have type like it was finished.
  * If this is true, then \p token must be of type TolerantToken, otherwise the the method will return 0 and log a critical error.
- * @return Lemon token ID (see sqlite2_parse.h and sqlite3_parse.h for possible token IDs).
+ * @return Length of the token in characters, or 0 if there is nothing more to tokenize.
+ * Lemon token ID (see sqlite2_parse.h and sqlite3_parse.h for possible token IDs) is stored in the \p token.
+ *
+ * The \p sql is never copied, so tokenizing whole query by moving the \p offset is linear in the query length.
  *
  * You shouldn't normally need to use this method. Instead of that, use Lexer class, as it provides higher level API.
  *
  * Most of the method code was taken from SQLite tokenizer code. It is modified to support both SQLite 2 and 3 grammas
  * and other SQLiteStudio specific features.
  */
-int lexerGetToken(const QString& z, TokenPtr token, int sqliteVersion, bool tolerant = false);
+int lexerGetToken(const QString& sql, int offset, TokenPtr token, int sqliteVersion, bool tolerant = false);
+
+/**
+ * @brief Low level tokenizer function reading the rest of a token opened before the \p sql.
+ * @param sql Query to tokenize.
+ * @param offset Position in \p sql at which the rest of the token starts.
+ * @param[out] token Token container to fill with values. It must be of type TolerantToken.
+ * @param sqliteVersion SQLite version, for which the tokenizer should work (2 or 3).
+ * @param openToken Kind of the token that was left open. It cannot be Lexer::OpenToken::NONE.
+ * @return Length of the rest of the token in characters, or 0 if there is nothing more to tokenize.
+ * If the token is not closed in the \p sql either, it covers all remaining characters and it's reported with invalid=true.
+ *
+ * This is used by Lexer to continue tokenizing a multi-line string, comment, etc. from a line that starts in the middle
+ * of such token, without having to tokenize previous lines again.
+ */
+int lexerGetContinuedToken(const QString& sql, int offset, TokenPtr token, int sqliteVersion, Lexer::OpenToken openToken);
 
 #endif // LEXER_LOW_LEV_H
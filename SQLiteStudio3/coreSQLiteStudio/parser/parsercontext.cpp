@@ -116,8 +116,9 @@ void ParserContext::flushErrors()
 
 TokenPtr ParserContext::getTokenPtr(Token* token)
 {
-    if (tokenPtrMap.contains(token))
-        return tokenPtrMap[token];
+    QHash<Token*, TokenPtr>::const_iterator it = tokenPtrMap.constFind(token);
+    if (it != tokenPtrMap.constEnd())
+        return it.value();
 
     TokenPtr tokenPtr = Lexer::getEveryTokenTypePtr(token);
     if (!tokenPtr.isNull())
@@ -130,6 +131,7 @@ TokenPtr ParserContext::getTokenPtr(Token* token)
 TokenList ParserContext::getTokenPtrList(const QList<Token*>& tokens)
 {
     TokenList resList;
+    resList.reserve(tokens.size());
     for (Token* token : tokens)
         resList << getTokenPtr(token);
 
@@ -992,6 +992,21 @@ static const char *const yyTokenName[] = {
   "trigger_time",  "trigger_event",  "foreach_clause",  "when_clause", 
   "trigger_cmd_list",  "trigger_cmd",   "database_kw_opt",  "key_opt",     
 };
+
+/* Names of all symbols as QStrings. They are used as keys of the tokensMap
+** on every reduction, so they are converted from yyTokenName only once. */
+static const QStringList& yyTokenNameStrings(){
+  static const QStringList names = [](){
+    QStringList list;
+    int cnt = (int)(sizeof(yyTokenName)/sizeof(yyTokenName[0]));
+    list.reserve(cnt);
+    for (int i = 0; i < cnt; i++)
+      list << QString::fromLatin1(yyTokenName[i]);
+
+    return list;
+  }();
+  return names;
+}
 #endif /* NDEBUG */
 
 #ifndef NDEBUG
@@ -4351,10 +4366,11 @@ static void yy_reduce(
       }
 
       QList<Token*> tokens;
+      const QStringList& symbolNames = yyTokenNameStrings();
       for (int i = yypParser->yyidx - yysize + 1; i <= yypParser->yyidx; i++)
       {
           tokens.clear();
-          const char* fieldName = yyTokenName[yypParser->yystack[i].major];
+          const QString& fieldName = symbolNames[yypParser->yystack[i].major];
 
           // Adding token being subject of this reduction. It's usually not includes in the inherited tokens,
           // although if inheriting from simple statements, like "FAIL" or "ROLLBACK", this tends to be redundant with the inherited tokens.
@@ -4364,7 +4380,7 @@ static void yy_reduce(
 
           tokens += *(yypParser->yystack[i].tokens);
 
-          if (!noTokenInheritanceFields.contains(fieldName))
+          if (noTokenInheritanceFields.isEmpty() || !noTokenInheritanceFields.contains(fieldName))
           {
               if (objectForTokens)
               {
@@ -39,6 +39,11 @@ Token::~Token()
 {
 }
 
+TokenPtr Token::clone() const
+{
+    return TokenPtr::create(*this);
+}
+
 QString Token::toString()
 {
     return "{" +
@@ -192,6 +197,11 @@ uint qHash(const TokenPtr& token)
     return (uint)reinterpret_cast<qint64>(token.data());
 }
 
+TokenPtr TolerantToken::clone() const
+{
+    return TolerantTokenPtr::create(*this);
+}
+
 TokenList::TokenList()
     : QList<TokenPtr>()
 {
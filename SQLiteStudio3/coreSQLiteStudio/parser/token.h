@@ -165,6 +165,12 @@ struct API_EXPORT Token
      */
     virtual ~Token();
 
+    /**
+     * @brief Creates copy of the token.
+     * @return Copy of the same type as this token, so for example TolerantToken is copied with its flag.
+     */
+    virtual TokenPtr clone() const;
+
     /**
      * @brief Serializes token to human readable form.
      * @return Token values in format: <tt>{type value start end}</tt>
@@ -289,8 +295,10 @@ typedef QSharedPointer<TolerantToken> TolerantTokenPtr;
  * In such cases the syntax highlighter must be aware of the token being invalid, so the proper
  * state is marked for the paragraph.
  */
-struct TolerantToken : public Token
+struct API_EXPORT TolerantToken : public Token
 {
+    TokenPtr clone() const;
+
     /**
      * @brief Invalid state flag for the token.
      */
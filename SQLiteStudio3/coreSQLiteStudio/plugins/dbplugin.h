@@ -25,6 +25,23 @@ class API_EXPORT DbPlugin : virtual public Plugin
          */
         virtual Db* getInstance(const QString& name, const QString& path, const QHash<QString,QVariant> &options, QString* errorMessage = 0) = 0;
 
+        /**
+         * @brief Creates database instance without verifying that the database is supported by the plugin.
+         * @param name Name for the database.
+         * @param path Path to the database file.
+         * @param options Options for the database passed while registering the database in the application.
+         * @param errorMessage If the result is null (on failure) and this pointer is not null, the error message will be stored in it.
+         * @return Database instance on success, or null pointer on failure.
+         *
+         * The getInstance() usually opens the database to check if it's supported. The DbManager calls this method
+         * instead of getInstance() when the same (not modified) file was already checked by this plugin before.
+         * Default implementation simply calls getInstance().
+         */
+        virtual Db* getInstanceWithoutProbing(const QString& name, const QString& path, const QHash<QString,QVariant> &options, QString* errorMessage = 0)
+        {
+            return getInstance(name, path, options, errorMessage);
+        }
+
         /**
          * @brief Provides label of what type is the database.
          * @return Type label.
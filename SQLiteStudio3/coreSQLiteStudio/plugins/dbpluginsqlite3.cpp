@@ -1,11 +1,16 @@
 #include "dbpluginsqlite3.h"
 #include "db/dbsqlite3.h"
+#include "db/queryexecutor.h"
 #include "common/unused.h"
 #include <QFileInfo>
+#include <QFile>
 
 Db* DbPluginSqlite3::getInstance(const QString& name, const QString& path, const QHash<QString, QVariant>& options, QString* errorMessage)
 {
     UNUSED(errorMessage);
+    if (!hasValidHeader(path))
+        return nullptr;
+
     Db* db = new DbSqlite3(name, path, options);
 
     if (!db->openForProbing())
@@ -14,7 +19,8 @@ Db* DbPluginSqlite3::getInstance(const QString& name, const QString& path, const
         return nullptr;
     }
 
-    SqlQueryPtr results = db->exec("SELECT * FROM sqlite_master");
+    // Reading schema version is enough to verify the database header, without reading whole schema.
+    SqlQueryPtr results = db->exec("PRAGMA schema_version");
     if (results->isError())
     {
         delete db;
@@ -25,6 +31,28 @@ Db* DbPluginSqlite3::getInstance(const QString& name, const QString& path, const
     return db;
 }
 
+Db* DbPluginSqlite3::getInstanceWithoutProbing(const QString& name, const QString& path, const QHash<QString, QVariant>& options, QString* errorMessage)
+{
+    UNUSED(errorMessage);
+    return new DbSqlite3(name, path, options);
+}
+
+bool DbPluginSqlite3::hasValidHeader(const QString& path)
+{
+    static const QByteArray header = QByteArray("SQLite format 3", 16);
+
+    // Empty files are valid databases and non-file paths (like URIs) are left to SQLite to verify
+    QFileInfo fileInfo(path);
+    if (!fileInfo.isFile() || fileInfo.size() == 0)
+        return true;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return true;
+
+    return file.read(header.size()) == header;
+}
+
 QString DbPluginSqlite3::getLabel() const
 {
     return "SQLite 3";
@@ -32,7 +60,28 @@ QString DbPluginSqlite3::getLabel() const
 
 QList<DbPluginOption> DbPluginSqlite3::getOptionsList() const
 {
-    return QList<DbPluginOption>();
+    QList<DbPluginOption> opts;
+
+    DbPluginOption opt;
+    opt.type = DbPluginOption::CHOICE;
+    opt.key = QueryExecutor::ROW_COUNTING_MODE;
+    opt.label = tr("Row counting");
+    opt.toolTip = tr("How the total number of rows is counted for browsed data and query results:\n"
+                     "exact - counts all rows (slow for large tables),\n"
+                     "estimated - uses statistics collected by ANALYZE when browsing a table,\n"
+                     "progressive - counts rows in background, showing partial totals,\n"
+                     "capped - counts up to %1 rows.").arg(QueryExecutor::ROW_COUNTING_CAP);
+    opt.choiceValues = {
+        QueryExecutor::rowCountingToString(QueryExecutor::RowCounting::EXACT),
+        QueryExecutor::rowCountingToString(QueryExecutor::RowCounting::ESTIMATED),
+        QueryExecutor::rowCountingToString(QueryExecutor::RowCounting::PROGRESSIVE),
+        QueryExecutor::rowCountingToString(QueryExecutor::RowCounting::CAPPED)
+    };
+    opt.defaultValue = QueryExecutor::rowCountingToString(QueryExecutor::RowCounting::EXACT);
+    opt.choiceReadOnly = true;
+    opts << opt;
+
+    return opts;
 }
 
 QString DbPluginSqlite3::generateDbName(const QVariant& baseValue)
@@ -15,10 +15,14 @@ class DbPluginSqlite3 : public BuiltInPlugin, public DbPlugin
 
     public:
         Db* getInstance(const QString& name, const QString& path, const QHash<QString, QVariant>& options, QString* errorMessage);
+        Db* getInstanceWithoutProbing(const QString& name, const QString& path, const QHash<QString, QVariant>& options, QString* errorMessage);
         QString getLabel() const;
         QList<DbPluginOption> getOptionsList() const;
         QString generateDbName(const QVariant& baseValue);
         bool checkIfDbServedByPlugin(Db* db) const;
+
+    private:
+        static bool hasValidHeader(const QString& path);
 };
 
 #endif // DBPLUGINSQLITE3_H
@@ -15,7 +15,8 @@ Db *DbPluginStdFileBase::getInstance(const QString &name, const QString &path, c
         return nullptr;
     }
 
-    SqlQueryPtr results = db->exec("SELECT * FROM sqlite_master");
+    // Reading schema version is enough to verify the database header, without reading whole schema.
+    SqlQueryPtr results = db->exec("PRAGMA schema_version");
     if (results->isError())
     {
         delete db;
@@ -26,6 +27,12 @@ Db *DbPluginStdFileBase::getInstance(const QString &name, const QString &path, c
     return db;
 }
 
+Db *DbPluginStdFileBase::getInstanceWithoutProbing(const QString &name, const QString &path, const QHash<QString, QVariant> &options, QString *errorMessage)
+{
+    UNUSED(errorMessage);
+    return newInstance(name, path, options);
+}
+
 QString DbPluginStdFileBase::generateDbName(const QVariant &baseValue)
 {
     QFileInfo file(baseValue.toString());
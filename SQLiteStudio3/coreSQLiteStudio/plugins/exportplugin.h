@@ -187,6 +187,8 @@ class ExportPlugin : virtual public Plugin
          * @return true for success, or false in case of a fatal error.
          *
          * It's called for each data row returned from the query.
+         *
+         * The row object is reused for consecutive rows, so copy its values if you need them after this method returns.
          */
         virtual bool exportQueryResultsRow(SqlResultsRowPtr row) = 0;
 
@@ -239,6 +241,8 @@ class ExportPlugin : virtual public Plugin
          * @return true for success, or false in case of a fatal error.
          *
          * This method will be called only if StandardExportConfig::exportData in initBeforeExport() was true.
+         *
+         * The row object is reused for consecutive rows, so copy its values if you need them after this method returns.
          */
         virtual bool exportTableRow(SqlResultsRowPtr data) = 0;
 
@@ -361,6 +365,20 @@ class ExportPlugin : virtual public Plugin
          */
         virtual bool afterExport() = 0;
 
+        /**
+         * @brief Writes out all the data that the plugin still keeps in its buffers.
+         * @return true for success, or false if the data could not be written.
+         *
+         * It's called after afterExport(), or after any failed export step, but always before cleanupAfterExport().
+         * After this call the output device contains everything that was exported so far.
+         *
+         * Default implementation does nothing, which is enough for plugins writing directly to the output device.
+         */
+        virtual bool flushOutput()
+        {
+            return true;
+        }
+
         /**
          * @brief Called after every export, even failed one.
          *
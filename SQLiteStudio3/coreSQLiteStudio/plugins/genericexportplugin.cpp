@@ -2,9 +2,16 @@
 #include "common/utils.h"
 #include "services/notifymanager.h"
 #include "common/unused.h"
+#include "common/global.h"
 #include "config_builder.h"
+#include "exportoutputwriter.h"
 #include <QTextCodec>
 
+GenericExportPlugin::~GenericExportPlugin()
+{
+    safe_delete(writer);
+}
+
 bool GenericExportPlugin::initBeforeExport(Db* db, QIODevice* output, const ExportManager::StandardExportConfig& config)
 {
     this->db = db;
@@ -21,6 +28,10 @@ bool GenericExportPlugin::initBeforeExport(Db* db, QIODevice* output, const Expo
         }
     }
 
+    // Anything left from previous export (if it was never flushed) belongs to the old output device
+    safe_delete(writer);
+    writer = new ExportOutputWriter(output, codec);
+
     return beforeExport();
 }
 
@@ -87,12 +98,12 @@ bool GenericExportPlugin::initBeforeExport()
 
 void GenericExportPlugin::write(const QString& str)
 {
-    output->write(codec->fromUnicode(str));
+    writer->write(str);
 }
 
 void GenericExportPlugin::writeln(const QString& str)
 {
-    write(str + "\n");
+    writer->writeln(str);
 }
 
 bool GenericExportPlugin::isTableExport() const
@@ -150,6 +161,16 @@ bool GenericExportPlugin::afterExport()
     return true;
 }
 
+bool GenericExportPlugin::flushOutput()
+{
+    if (!writer)
+        return true;
+
+    bool res = writer->flush();
+    safe_delete(writer);
+    return res;
+}
+
 void GenericExportPlugin::cleanupAfterExport()
 {
 }
@@ -4,11 +4,15 @@
 #include "exportplugin.h"
 #include "genericplugin.h"
 
+class ExportOutputWriter;
+
 class API_EXPORT GenericExportPlugin : virtual public GenericPlugin, public ExportPlugin
 {
         Q_OBJECT
 
     public:
+        ~GenericExportPlugin();
+
         bool initBeforeExport(Db* db, QIODevice* output, const ExportManager::StandardExportConfig& config);
         ExportManager::ExportModes getSupportedModes() const;
         ExportManager::ExportProviderFlags getProviderFlags() const;
@@ -31,6 +35,7 @@ class API_EXPORT GenericExportPlugin : virtual public GenericPlugin, public Expo
         bool afterExportViews();
         bool afterExportDatabase();
         bool afterExport();
+        bool flushOutput();
         void cleanupAfterExport();
 
         /**
@@ -53,6 +58,9 @@ class API_EXPORT GenericExportPlugin : virtual public GenericPlugin, public Expo
         const ExportManager::StandardExportConfig* config = nullptr;
         QTextCodec* codec = nullptr;
         ExportManager::ExportMode exportMode = ExportManager::UNDEFINED;
+
+    private:
+        ExportOutputWriter* writer = nullptr;
 };
 
 #endif // GENERICEXPORTPLUGIN_H
@@ -90,6 +90,18 @@ class ImportPlugin : virtual public Plugin
          */
         virtual QList<QVariant> next() = 0;
 
+        /**
+         * @brief Provides number of bytes read from the data source so far.
+         * @return Number of bytes, or -1 if it's unknown.
+         *
+         * It's used only to report the import speed, so it doesn't have to be precise
+         * (for example it can include data that was buffered, but not yet returned from next()).
+         */
+        virtual qint64 getReadBytes() const
+        {
+            return -1;
+        }
+
         /**
          * @brief Provides config object that holds configuration for importing.
          * @return Config object, or null if the importing with this plugin is not configurable.
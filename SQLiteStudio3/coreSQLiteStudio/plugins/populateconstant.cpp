@@ -28,6 +28,22 @@ QVariant PopulateConstantEngine::nextValue(bool& nextValueError)
     return cfg.PopulateConstant.Value.get();
 }
 
+void PopulateConstantEngine::nextValues(int count, QList<QVariant>& values, bool& nextValueError)
+{
+    UNUSED(nextValueError);
+
+    // The value is implicitly shared by all entries, so it's read from config only once
+    QVariant value = cfg.PopulateConstant.Value.get();
+    values.reserve(values.size() + count);
+    for (int i = 0; i < count; i++)
+        values << value;
+}
+
+bool PopulateConstantEngine::supportsParallelGeneration() const
+{
+    return true;
+}
+
 void PopulateConstantEngine::afterPopulating()
 {
 }
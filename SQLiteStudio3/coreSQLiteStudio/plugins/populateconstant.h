@@ -32,6 +32,8 @@ class PopulateConstantEngine : public PopulateEngine
     public:
         bool beforePopulating(Db* db, const QString& table);
         QVariant nextValue(bool& nextValueError);
+        void nextValues(int count, QList<QVariant>& values, bool& nextValueError);
+        bool supportsParallelGeneration() const;
         void afterPopulating();
         CfgMain* getConfig();
         QString getPopulateConfigFormName() const;
@@ -44,8 +44,13 @@ bool PopulateDictionaryEngine::beforePopulating(Db* db, const QString& table)
 
     dictionaryPos = 0;
     dictionarySize = dictionary.size();
-    if (cfg.PopulateDictionary.Random.get())
-        qsrand(QDateTime::currentDateTime().toTime_t());
+    random = cfg.PopulateDictionary.Random.get();
+    if (random)
+    {
+        // Each engine has its own generator, so it can generate values in any thread
+        generator.seed(getRandomSeed());
+        distribution = std::uniform_int_distribution<int>(0, dictionarySize - 1);
+    }
 
     return true;
 }
@@ -53,10 +58,9 @@ bool PopulateDictionaryEngine::beforePopulating(Db* db, const QString& table)
 QVariant PopulateDictionaryEngine::nextValue(bool& nextValueError)
 {
     UNUSED(nextValueError);
-    if (cfg.PopulateDictionary.Random.get())
+    if (random)
     {
-        int r = qrand() % dictionarySize;
-        return dictionary[r];
+        return dictionary[distribution(generator)];
     }
     else
     {
@@ -67,6 +71,32 @@ QVariant PopulateDictionaryEngine::nextValue(bool& nextValueError)
     }
 }
 
+void PopulateDictionaryEngine::nextValues(int count, QList<QVariant>& values, bool& nextValueError)
+{
+    UNUSED(nextValueError);
+    values.reserve(values.size() + count);
+    if (random)
+    {
+        for (int i = 0; i < count; i++)
+            values << dictionary[distribution(generator)];
+
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (dictionaryPos >= dictionarySize)
+            dictionaryPos = 0;
+
+        values << dictionary[dictionaryPos++];
+    }
+}
+
+bool PopulateDictionaryEngine::supportsParallelGeneration() const
+{
+    return true;
+}
+
 void PopulateDictionaryEngine::afterPopulating()
 {
     dictionary.clear();
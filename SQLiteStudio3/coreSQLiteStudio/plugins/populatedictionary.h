@@ -4,6 +4,7 @@
 #include "builtinplugin.h"
 #include "populateplugin.h"
 #include "config_builder.h"
+#include <random>
 
 class QFile;
 class QTextStream;
@@ -37,6 +38,8 @@ class PopulateDictionaryEngine : public PopulateEngine
     public:
         bool beforePopulating(Db* db, const QString& table);
         QVariant nextValue(bool& nextValueError);
+        void nextValues(int count, QList<QVariant>& values, bool& nextValueError);
+        bool supportsParallelGeneration() const;
         void afterPopulating();
         CfgMain* getConfig();
         QString getPopulateConfigFormName() const;
@@ -47,6 +50,9 @@ class PopulateDictionaryEngine : public PopulateEngine
         QStringList dictionary;
         int dictionarySize = 0;
         int dictionaryPos = 0;
+        bool random = false;
+        std::mt19937 generator;
+        std::uniform_int_distribution<int> distribution;
 };
 
 #endif // POPULATEDICTIONARY_H
@@ -3,6 +3,7 @@
 
 #include "coreSQLiteStudio_global.h"
 #include "plugins/plugin.h"
+#include "common/utils.h"
 
 class CfgMain;
 class PopulateEngine;
@@ -23,6 +24,35 @@ class API_EXPORT PopulateEngine
         virtual QVariant nextValue(bool& nextValueError) = 0;
         virtual void afterPopulating() = 0;
 
+        /**
+         * @brief Generates many values at once.
+         * @param count Number of values to generate.
+         * @param values List to append generated values to.
+         * @param nextValueError Set to true in case of error, just like in nextValue().
+         *
+         * Default implementation calls nextValue() for every value. Engines that can generate values
+         * cheaper in bulk should reimplement it.
+         */
+        virtual void nextValues(int count, QList<QVariant>& values, bool& nextValueError)
+        {
+            values.reserve(values.size() + count);
+            for (int i = 0; i < count && !nextValueError; i++)
+                values << nextValue(nextValueError);
+        }
+
+        /**
+         * @brief Tells if values can be generated in other thread than the populating one.
+         * @return true if nextValues() can be called from any thread.
+         *
+         * When true, the PopulateWorker may generate values for this column in parallel with other columns.
+         * The engine is never called from two threads at the same time. Engines keeping thread dependent
+         * resources (like a scripting context) should return false, which is the default.
+         */
+        virtual bool supportsParallelGeneration() const
+        {
+            return false;
+        }
+
         /**
          * @brief Provides config object that holds configuration for populating.
          * @return Config object, or null if the importing with this plugin is not configurable.
@@ -64,6 +94,35 @@ class API_EXPORT PopulateEngine
          * is currently configured correctly, without going into details, without handling signals from POPULATE_MANAGER.
          */
         virtual bool validateOptions() = 0;
+
+        /**
+         * @brief Sets seed for random values generated by this engine.
+         * @param seed Seed to use.
+         *
+         * It's called by the PopulateWorker before beforePopulating(). Engines seeded with the same seed
+         * and configured the same way generate the same values.
+         */
+        void setRandomSeed(uint seed)
+        {
+            this->seed = seed;
+            seedSet = true;
+        }
+
+    protected:
+        /**
+         * @brief Provides seed for the random number generator of this engine.
+         * @return Seed set with setRandomSeed(), or seed based on current time if none was set.
+         *
+         * Engines generating random values should seed their generators with it in beforePopulating().
+         */
+        uint getRandomSeed() const
+        {
+            return seedSet ? seed : randomSeed();
+        }
+
+    private:
+        uint seed = 0;
+        bool seedSet = false;
 };
 
 
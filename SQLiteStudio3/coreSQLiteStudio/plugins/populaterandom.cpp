@@ -1,7 +1,6 @@
 #include "populaterandom.h"
 #include "services/populatemanager.h"
 #include "common/unused.h"
-#include <QDateTime>
 
 PopulateRandom::PopulateRandom()
 {
@@ -21,16 +20,44 @@ bool PopulateRandomEngine::beforePopulating(Db* db, const QString& table)
 {
     UNUSED(db);
     UNUSED(table);
-    qsrand(QDateTime::currentDateTime().toTime_t());
-    range = cfg.PopulateRandom.MaxValue.get() - cfg.PopulateRandom.MinValue.get() + 1;
-    return (range > 0);
+    int minValue = cfg.PopulateRandom.MinValue.get();
+    int maxValue = cfg.PopulateRandom.MaxValue.get();
+    if (minValue > maxValue)
+        return false;
+
+    // Each engine has its own generator, so it can generate values in any thread
+    generator.seed(getRandomSeed());
+    distribution = std::uniform_int_distribution<int>(minValue, maxValue);
+    prefix = cfg.PopulateRandom.Prefix.get();
+    suffix = cfg.PopulateRandom.Suffix.get();
+    return true;
 }
 
 QVariant PopulateRandomEngine::nextValue(bool& nextValueError)
 {
     UNUSED(nextValueError);
-    QString randValue = QString::number((qrand() % range) + cfg.PopulateRandom.MinValue.get());
-    return (cfg.PopulateRandom.Prefix.get() + randValue + cfg.PopulateRandom.Suffix.get());
+    return (prefix + QString::number(distribution(generator)) + suffix);
+}
+
+void PopulateRandomEngine::nextValues(int count, QList<QVariant>& values, bool& nextValueError)
+{
+    UNUSED(nextValueError);
+    values.reserve(values.size() + count);
+    if (prefix.isEmpty() && suffix.isEmpty())
+    {
+        for (int i = 0; i < count; i++)
+            values << QString::number(distribution(generator));
+
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+        values << (prefix + QString::number(distribution(generator)) + suffix);
+}
+
+bool PopulateRandomEngine::supportsParallelGeneration() const
+{
+    return true;
 }
 
 void PopulateRandomEngine::afterPopulating()
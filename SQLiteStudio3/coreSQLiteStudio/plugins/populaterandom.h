@@ -4,6 +4,7 @@
 #include "builtinplugin.h"
 #include "populateplugin.h"
 #include "config_builder.h"
+#include <random>
 
 CFG_CATEGORIES(PopulateRandomConfig,
     CFG_CATEGORY(PopulateRandom,
@@ -30,11 +31,13 @@ class PopulateRandom : public BuiltInPlugin, public PopulatePlugin
         PopulateEngine* createEngine();
 };
 
-class PopulateRandomEngine : public PopulateEngine
+class API_EXPORT PopulateRandomEngine : public PopulateEngine
 {
     public:
         bool beforePopulating(Db* db, const QString& table);
         QVariant nextValue(bool& nextValueError);
+        void nextValues(int count, QList<QVariant>& values, bool& nextValueError);
+        bool supportsParallelGeneration() const;
         void afterPopulating();
         CfgMain* getConfig();
         QString getPopulateConfigFormName() const;
@@ -42,6 +45,9 @@ class PopulateRandomEngine : public PopulateEngine
 
     private:
         CFG_LOCAL(PopulateRandomConfig, cfg)
-        int range;
+        std::mt19937 generator;
+        std::uniform_int_distribution<int> distribution;
+        QString prefix;
+        QString suffix;
 };
 #endif // POPULATERANDOM_H
@@ -21,8 +21,10 @@ bool PopulateRandomTextEngine::beforePopulating(Db* db, const QString& table)
 {
     UNUSED(db);
     UNUSED(table);
-    qsrand(QDateTime::currentDateTime().toTime_t());
-    range = cfg.PopulateRandomText.MaxLength.get() - cfg.PopulateRandomText.MinLength.get() + 1;
+    int minLength = cfg.PopulateRandomText.MinLength.get();
+    int maxLength = cfg.PopulateRandomText.MaxLength.get();
+    if (minLength > maxLength)
+        return false;
 
     chars = "";
 
@@ -47,14 +49,45 @@ bool PopulateRandomTextEngine::beforePopulating(Db* db, const QString& table)
             chars += QStringLiteral(" \t\n");
     }
 
-    return !chars.isEmpty();
+    if (chars.isEmpty())
+        return false;
+
+    // Each engine has its own generator, so it can generate values in any thread
+    generator.seed(getRandomSeed());
+    lengthDistribution = std::uniform_int_distribution<int>(minLength, maxLength);
+    charDistribution = std::uniform_int_distribution<int>(0, chars.size() - 1);
+    return true;
 }
 
 QVariant PopulateRandomTextEngine::nextValue(bool& nextValueError)
 {
     UNUSED(nextValueError);
-    int lgt = (qrand() % range) + cfg.PopulateRandomText.MinLength.get();
-    return randStr(lgt, chars);
+    return randomText();
+}
+
+void PopulateRandomTextEngine::nextValues(int count, QList<QVariant>& values, bool& nextValueError)
+{
+    UNUSED(nextValueError);
+    values.reserve(values.size() + count);
+    for (int i = 0; i < count; i++)
+        values << randomText();
+}
+
+bool PopulateRandomTextEngine::supportsParallelGeneration() const
+{
+    return true;
+}
+
+QString PopulateRandomTextEngine::randomText()
+{
+    int length = lengthDistribution(generator);
+    QString text(length, Qt::Uninitialized);
+    QChar* data = text.data();
+    const QChar* charData = chars.constData();
+    for (int i = 0; i < length; i++)
+        data[i] = charData[charDistribution(generator)];
+
+    return text;
 }
 
 void PopulateRandomTextEngine::afterPopulating()
@@ -4,6 +4,7 @@
 #include "builtinplugin.h"
 #include "populateplugin.h"
 #include "config_builder.h"
+#include <random>
 
 CFG_CATEGORIES(PopulateRandomTextConfig,
     CFG_CATEGORY(PopulateRandomText,
@@ -33,20 +34,26 @@ class PopulateRandomText : public BuiltInPlugin, public PopulatePlugin
         PopulateEngine* createEngine();
 };
 
-class PopulateRandomTextEngine : public PopulateEngine
+class API_EXPORT PopulateRandomTextEngine : public PopulateEngine
 {
     public:
         bool beforePopulating(Db* db, const QString& table);
         QVariant nextValue(bool& nextValueError);
+        void nextValues(int count, QList<QVariant>& values, bool& nextValueError);
+        bool supportsParallelGeneration() const;
         void afterPopulating();
         CfgMain* getConfig();
         QString getPopulateConfigFormName() const;
         bool validateOptions();
 
     private:
+        QString randomText();
+
         CFG_LOCAL(PopulateRandomTextConfig, cfg)
-        int range;
         QString chars;
+        std::mt19937 generator;
+        std::uniform_int_distribution<int> lengthDistribution;
+        std::uniform_int_distribution<int> charDistribution;
 };
 
 #endif // POPULATERANDOMTEXT_H
@@ -33,6 +33,19 @@ QVariant PopulateSequenceEngine::nextValue(bool& nextValueError)
     return seq += step;
 }
 
+void PopulateSequenceEngine::nextValues(int count, QList<QVariant>& values, bool& nextValueError)
+{
+    UNUSED(nextValueError);
+    values.reserve(values.size() + count);
+    for (int i = 0; i < count; i++)
+        values << (seq += step);
+}
+
+bool PopulateSequenceEngine::supportsParallelGeneration() const
+{
+    return true;
+}
+
 void PopulateSequenceEngine::afterPopulating()
 {
 }
@@ -28,11 +28,13 @@ class PopulateSequence : public BuiltInPlugin, public PopulatePlugin
         PopulateEngine* createEngine();
 };
 
-class PopulateSequenceEngine : public PopulateEngine
+class API_EXPORT PopulateSequenceEngine : public PopulateEngine
 {
     public:
         bool beforePopulating(Db* db, const QString& table);
         QVariant nextValue(bool& nextValueError);
+        void nextValues(int count, QList<QVariant>& values, bool& nextValueError);
+        bool supportsParallelGeneration() const;
         void afterPopulating();
         CfgMain* getConfig();
         QString getPopulateConfigFormName() const;
@@ -24,6 +24,19 @@ class ScriptingPlugin : virtual public Plugin
         virtual QVariant evaluate(Context* context, const QString& code, const QList<QVariant>& args = QList<QVariant>()) = 0;
         virtual bool hasError(Context* context) const = 0;
         virtual QString getErrorMessage(Context* context) const = 0;
+
+        /**
+         * @brief Evaluates code without explicit context.
+         * @param code Code to evaluate.
+         * @param args Arguments passed to the code.
+         * @param errorMessage If not null, it gets the error message in case of evaluation error.
+         * @return Result of evaluation.
+         *
+         * Such evaluations (i.e. SQL functions) may be called by many threads at the same time, so implementations
+         * can use a separate engine per thread. In that case global variables set by the code are kept only
+         * for later evaluations in the same thread, not for all evaluations. Code that needs a state shared
+         * between evaluations should use explicit context.
+         */
         virtual QVariant evaluate(const QString& code, const QList<QVariant>& args = QList<QVariant>(), QString* errorMessage = nullptr) = 0;
         virtual QString getIconPath() const = 0;
 };
@@ -3,8 +3,6 @@
 #include "common/global.h"
 #include "scriptingqtdbproxy.h"
 #include <QScriptEngine>
-#include <QMutex>
-#include <QMutexLocker>
 #include <QDebug>
 
 static QScriptValue scriptingQtDebug(QScriptContext *context, QScriptEngine *engine)
@@ -20,12 +18,10 @@ static QScriptValue scriptingQtDebug(QScriptContext *context, QScriptEngine *eng
 
 ScriptingQt::ScriptingQt()
 {
-    mainEngineMutex = new QMutex();
 }
 
 ScriptingQt::~ScriptingQt()
 {
-    safe_delete(mainEngineMutex);
 }
 
 QString ScriptingQt::getLanguage() const
@@ -63,20 +59,14 @@ void ScriptingQt::resetContext(ScriptingPlugin::Context* context)
 
 QVariant ScriptingQt::evaluate(const QString& code, const QList<QVariant>& args, Db* db, bool locking, QString* errorMessage)
 {
-    QMutexLocker locker(mainEngineMutex);
+    ContextQt* ctx = getThreadContext();
 
-    // Enter a new context
-    QScriptContext* engineContext = mainContext->engine->pushContext();
-
-    // Call the function
-    QVariant result = evaluate(mainContext, engineContext, code, args, db, locking);
+    // Fresh "this" object for every call, so nothing set on it is carried over to the next call
+    QVariant result = evaluate(ctx, ctx->engine->newObject(), getCachedFunctionValue(ctx, code), args, db, locking);
 
     // Handle errors
-    if (!mainContext->error.isEmpty())
-        *errorMessage = mainContext->error;
-
-    // Leave the context to reset "this".
-    mainContext->engine->popContext();
+    if (errorMessage && !ctx->error.isEmpty())
+        *errorMessage = ctx->error;
 
     return result;
 }
@@ -87,32 +77,35 @@ QVariant ScriptingQt::evaluate(ScriptingPlugin::Context* context, const QString&
     if (!ctx)
         return QVariant();
 
-    return evaluate(ctx, ctx->engine->currentContext(), code, args, db, locking);
+    return evaluate(ctx, ctx->engine->currentContext()->activationObject(), getFunctionValue(ctx, code), args, db, locking);
 }
 
-QVariant ScriptingQt::evaluate(ContextQt* ctx, QScriptContext* engineContext, const QString& code, const QList<QVariant>& args, Db* db, bool locking)
+QVariant ScriptingQt::evaluate(ContextQt* ctx, const QScriptValue& thisObject, const QScriptValue& functionValue, const QList<QVariant>& args, Db* db,
+                               bool locking)
 {
-    // Define function to call
-    QScriptValue functionValue = getFunctionValue(ctx, code);
-
-    // Db for this evaluation
+    // Db for this evaluation. Previous one is restored afterwards, in case the function was called
+    // from a query executed by another function evaluated in this context.
+    Db* previousDb = ctx->dbProxy->getDb();
+    bool previousLocking = ctx->dbProxy->getUseDbLocking();
     ctx->dbProxy->setDb(db);
     ctx->dbProxy->setUseDbLocking(locking);
 
+    // Arguments are converted one by one, without wrapping them in a script array first
+    QScriptValueList argValues;
+    argValues.reserve(args.size());
+    for (const QVariant& arg : args)
+        argValues << ctx->engine->toScriptValue(arg);
+
     // Call the function
-    QScriptValue result;
-    if (args.size() > 0)
-        result = functionValue.call(engineContext->activationObject(), ctx->engine->toScriptValue(args));
-    else
-        result = functionValue.call(engineContext->activationObject());
+    QScriptValue result = functionValue.call(thisObject, argValues);
 
     // Handle errors
     ctx->error.clear();
     if (ctx->engine->hasUncaughtException())
         ctx->error = ctx->engine->uncaughtException().toString();
 
-    ctx->dbProxy->setDb(nullptr);
-    ctx->dbProxy->setUseDbLocking(false);
+    ctx->dbProxy->setDb(previousDb);
+    ctx->dbProxy->setUseDbLocking(previousLocking);
 
     return convertVariant(result.toVariant());
 }
@@ -214,8 +207,6 @@ QString ScriptingQt::getIconPath() const
 
 bool ScriptingQt::init()
 {
-    QMutexLocker locker(mainEngineMutex);
-    mainContext = new ContextQt;
     return true;
 }
 
@@ -226,8 +217,9 @@ void ScriptingQt::deinit()
 
     contexts.clear();
 
-    QMutexLocker locker(mainEngineMutex);
-    safe_delete(mainContext);
+    // Contexts of other threads are released when these threads finish
+    if (threadContexts.hasLocalData())
+        threadContexts.setLocalData(nullptr);
 }
 
 ScriptingQt::ContextQt* ScriptingQt::getContext(ScriptingPlugin::Context* context) const
@@ -239,6 +231,14 @@ ScriptingQt::ContextQt* ScriptingQt::getContext(ScriptingPlugin::Context* contex
     return ctx;
 }
 
+ScriptingQt::ContextQt* ScriptingQt::getThreadContext()
+{
+    if (!threadContexts.hasLocalData())
+        threadContexts.setLocalData(new ContextQt);
+
+    return threadContexts.localData();
+}
+
 QScriptValue ScriptingQt::getFunctionValue(ContextQt* ctx, const QString& code)
 {
     static const QString fnDef = QStringLiteral("(function () {%1\n})");
@@ -256,6 +256,21 @@ QScriptValue ScriptingQt::getFunctionValue(ContextQt* ctx, const QString& code)
     return ctx->engine->evaluate(*prog);
 }
 
+QScriptValue ScriptingQt::getCachedFunctionValue(ContextQt* ctx, const QString& code)
+{
+    // Thread contexts never enter nested engine contexts, so the function object can be created once
+    // in the global context and reused, instead of evaluating its definition for every call.
+    QScriptValue* cachedFunction = ctx->functionCache.object(code);
+    if (cachedFunction)
+        return *cachedFunction;
+
+    QScriptValue functionValue = getFunctionValue(ctx, code);
+    if (functionValue.isFunction())
+        ctx->functionCache.insert(code, new QScriptValue(functionValue));
+
+    return functionValue;
+}
+
 ScriptingQt::ContextQt::ContextQt()
 {
     engine = new QScriptEngine();
@@ -267,10 +282,14 @@ ScriptingQt::ContextQt::ContextQt()
     engine->globalObject().setProperty("db", dbProxyScriptValue);
 
     scriptCache.setMaxCost(cacheSize);
+    functionCache.setMaxCost(cacheSize);
 }
 
 ScriptingQt::ContextQt::~ContextQt()
 {
+    // Cached values belong to the engine, so they have to go first
+    functionCache.clear();
+    scriptCache.clear();
     safe_delete(engine);
     safe_delete(dbProxy);
 }
@@ -8,10 +8,9 @@
 #include <QCache>
 #include <QScriptValue>
 #include <QScriptProgram>
+#include <QThreadStorage>
 
 class QScriptEngine;
-class QMutex;
-class QScriptContext;
 class ScriptingQtDbProxy;
 
 class ScriptingQt : public BuiltInPlugin, public DbAwareScriptingPlugin
@@ -52,21 +51,35 @@ class ScriptingQt : public BuiltInPlugin, public DbAwareScriptingPlugin
 
                 QScriptEngine* engine = nullptr;
                 QCache<QString,QScriptProgram> scriptCache;
+                QCache<QString,QScriptValue> functionCache;
                 QString error;
                 ScriptingQtDbProxy* dbProxy = nullptr;
                 QScriptValue dbProxyScriptValue;
         };
 
         ContextQt* getContext(ScriptingPlugin::Context* context) const;
+        ContextQt* getThreadContext();
         QScriptValue getFunctionValue(ContextQt* ctx, const QString& code);
-        QVariant evaluate(ContextQt* ctx, QScriptContext* engineContext, const QString& code, const QList<QVariant>& args, Db* db, bool locking);
+        QScriptValue getCachedFunctionValue(ContextQt* ctx, const QString& code);
+        QVariant evaluate(ContextQt* ctx, const QScriptValue& thisObject, const QScriptValue& functionValue, const QList<QVariant>& args, Db* db,
+                          bool locking);
         QVariant convertVariant(const QVariant& value, bool wrapStrings = false);
 
         static const constexpr int cacheSize = 5;
 
-        ContextQt* mainContext = nullptr;
         QList<Context*> contexts;
-        QMutex* mainEngineMutex = nullptr;
+
+        /**
+         * @brief Contexts used by evaluations without explicit context (i.e. SQL functions), one per thread.
+         *
+         * QScriptEngine can be used only by a single thread, so instead of sharing one engine guarded by a mutex,
+         * every thread gets its own. Evaluations from different threads (i.e. queries on different databases)
+         * can run in parallel. Context of a thread is deleted when the thread finishes.
+         *
+         * This also means that global variables set by one evaluation are visible only to later evaluations
+         * in the same thread, not to all evaluations, as it was with a single shared engine.
+         */
+        QThreadStorage<ContextQt*> threadContexts;
 };
 
 #endif // SCRIPTINGQT_H
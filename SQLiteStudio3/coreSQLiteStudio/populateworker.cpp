@@ -4,6 +4,10 @@
 #include "db/sqlquery.h"
 #include "plugins/populateplugin.h"
 #include "services/notifymanager.h"
+#include "services/config.h"
+#include "common/global.h"
+#include <QThread>
+#include <QtConcurrent/QtConcurrentMap>
 
 PopulateWorker::PopulateWorker(Db* db, const QString& table, const QStringList& columns, const QList<PopulateEngine*>& engines, qint64 rows, QObject* parent) :
     QObject(parent), db(db), table(table), columns(columns), engines(engines), rows(rows)
@@ -16,8 +20,6 @@ PopulateWorker::~PopulateWorker()
 
 void PopulateWorker::run()
 {
-    static const QString insertSql = QStringLiteral("INSERT INTO %1 (%2) VALUES (%3);");
-
     if (!db->begin())
     {
         notifyError(tr("Could not start transaction in order to perform table populating. Error details: %1").arg(db->getErrorText()));
@@ -25,62 +27,55 @@ void PopulateWorker::run()
         return;
     }
 
-    Dialect dialect = db->getDialect();
-    QString wrappedTable = wrapObjIfNeeded(table, dialect);
+    if (rows > 0 && !beforePopulating())
+        return;
 
-    QStringList cols;
-    QStringList argList;
-    for (const QString& column : columns)
+    int rowsPerInsert = getRowsPerInsert();
+    SqlQueryPtr batchQuery = prepareInsert(rowsPerInsert);
+
+    columnValues.resize(engines.size());
+    parallelColumns.clear();
+    for (int i = 0, total = engines.size(); i < total; i++)
     {
-        cols << wrapObjIfNeeded(column, dialect);
-        argList << "?";
+        if (engines[i]->supportsParallelGeneration())
+            parallelColumns << i;
     }
 
-    QString finalSql = insertSql.arg(wrappedTable, cols.join(", "), argList.join(", "));
-    SqlQueryPtr query = db->prepare(finalSql);
+    // Single column is generated in this thread, there would be nothing to do in parallel with it
+    if (parallelColumns.size() < 2 || QThread::idealThreadCount() < 2)
+        parallelColumns.clear();
 
-    QList<QVariant> args;
-    bool nextValueError = false;
-    for (qint64 i = 0; i < rows; i++)
+    progressTimer.start();
+    int blockRows = 0;
+    for (qint64 doneRows = 0; doneRows < rows; doneRows += blockRows)
     {
-        if (i == 0 && !beforePopulating())
-            return;
-
         if (isInterrupted())
         {
-            db->rollback();
-            emit finished(false);
+            fail();
             return;
         }
 
-        args.clear();
-        for (PopulateEngine* engine : engines)
-            args << engine->nextValue(nextValueError);
-
-        if (nextValueError)
+        blockRows = static_cast<int>(qMin<qint64>(ROWS_PER_BLOCK, rows - doneRows));
+        if (!generateValues(blockRows) || !insertRows(blockRows, rowsPerInsert, batchQuery))
         {
-            db->rollback();
-            emit finished(false);
+            fail();
             return;
         }
 
-        query->setArgs(args);
-        if (!query->execute())
+        if (progressTimer.elapsed() >= PROGRESS_REPORT_INTERVAL)
         {
-            notifyError(tr("Error while populating table: %1").arg(query->getErrorText()));
-            db->rollback();
-            emit finished(false);
-            return;
+            emit finishedStep(doneRows + blockRows);
+            progressTimer.restart();
         }
-
-        emit finishedStep(i + 1);
     }
 
+    if (rows > 0)
+        emit finishedStep(rows);
+
     if (!db->commit())
     {
         notifyError(tr("Could not commit transaction after table populating. Error details: %1").arg(db->getErrorText()));
-        db->rollback();
-        emit finished(false);
+        fail();
         return;
     }
 
@@ -88,6 +83,118 @@ void PopulateWorker::run()
     emit finished(true);
 }
 
+int PopulateWorker::getRowsPerInsert() const
+{
+    // Multi-row VALUES clause is not supported by SQLite 2
+    if (db->getDialect() == Dialect::Sqlite2)
+        return 1;
+
+    return qMax(1, MAX_BIND_PARAMS / qMax(1, columns.size()));
+}
+
+SqlQueryPtr PopulateWorker::prepareInsert(int rows)
+{
+    static_qstring(insertTemplate, "INSERT INTO %1 (%2) VALUES %3;");
+
+    Dialect dialect = db->getDialect();
+    QStringList cols;
+    QStringList argList;
+    for (const QString& column : columns)
+    {
+        cols << wrapObjIfNeeded(column, dialect);
+        argList << "?";
+    }
+
+    QString rowValues = "(" + argList.join(", ") + ")";
+    QStringList rowList;
+    for (int i = 0; i < rows; i++)
+        rowList << rowValues;
+
+    QString finalSql = insertTemplate.arg(wrapObjIfNeeded(table, dialect), cols.join(", "), rowList.join(", "));
+    SqlQueryPtr query = db->prepare(finalSql);
+    query->setFlags(Db::Flag::SKIP_DROP_DETECTION|Db::Flag::SKIP_PARAM_COUNTING);
+    return query;
+}
+
+bool PopulateWorker::generateValues(int rows)
+{
+    bool nextValueError = false;
+    for (int i = 0, total = engines.size(); i < total; i++)
+    {
+        columnValues[i].clear();
+        if (parallelColumns.contains(i))
+            continue;
+
+        engines[i]->nextValues(rows, columnValues[i], nextValueError);
+        if (nextValueError)
+            return false;
+    }
+
+    if (parallelColumns.isEmpty())
+        return true;
+
+    // Each engine fills only its own column, so no synchronization is needed
+    QVector<bool> errors(engines.size(), false);
+    bool* errorFlags = errors.data();
+    QList<QVariant>* values = columnValues.data();
+    const QList<PopulateEngine*>& theEngines = engines;
+    QtConcurrent::blockingMap(parallelColumns, [&theEngines, rows, values, errorFlags](int col)
+    {
+        theEngines.at(col)->nextValues(rows, values[col], errorFlags[col]);
+    });
+
+    return !errors.contains(true);
+}
+
+bool PopulateWorker::insertRows(int rowCount, int rowsPerInsert, SqlQueryPtr batchQuery)
+{
+    int colCount = engines.size();
+    int statementRows = 0;
+    SqlQueryPtr query;
+    QList<QVariant> args;
+    for (int row = 0; row < rowCount; row += statementRows)
+    {
+        statementRows = qMin(rowsPerInsert, rowCount - row);
+
+        args.clear();
+        args.reserve(statementRows * colCount);
+        for (int r = row, end = row + statementRows; r < end; r++)
+        {
+            for (int c = 0; c < colCount; c++)
+                args << columnValues[c][r];
+        }
+
+        if (statementRows == rowsPerInsert)
+        {
+            query = batchQuery;
+        }
+        else
+        {
+            // All full blocks end with the same number of rows, only the last block can be different
+            if (statementRows != tailQueryRows)
+            {
+                tailQuery = prepareInsert(statementRows);
+                tailQueryRows = statementRows;
+            }
+            query = tailQuery;
+        }
+
+        query->setArgs(args);
+        if (!query->execute())
+        {
+            notifyError(tr("Error while populating table: %1").arg(query->getErrorText()));
+            return false;
+        }
+    }
+    return true;
+}
+
+void PopulateWorker::fail()
+{
+    db->rollback();
+    emit finished(false);
+}
+
 bool PopulateWorker::isInterrupted()
 {
     QMutexLocker locker(&interruptMutex);
@@ -96,9 +203,14 @@ bool PopulateWorker::isInterrupted()
 
 bool PopulateWorker::beforePopulating()
 {
-    for (PopulateEngine* engine : engines)
+    // Seed of each column depends only on the base seed and the column name, so populating with the same base seed
+    // generates the same values, no matter the order of columns, or which thread generates them. Zero means no base seed.
+    int configuredSeed = CFG_CORE.General.PopulateRandomSeed.get();
+    uint baseSeed = (configuredSeed != 0) ? static_cast<uint>(configuredSeed) : randomSeed();
+    for (int i = 0, total = engines.size(); i < total; i++)
     {
-        if (!engine->beforePopulating(db, table))
+        engines[i]->setRandomSeed(deriveSeed(baseSeed, qHash(columns[i])));
+        if (!engines[i]->beforePopulating(db, table))
         {
             db->rollback();
             emit finished(false);
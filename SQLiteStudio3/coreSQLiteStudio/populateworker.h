@@ -1,15 +1,18 @@
 #ifndef POPULATEWORKER_H
 #define POPULATEWORKER_H
 
+#include "db/sqlquery.h"
 #include <QMutex>
 #include <QObject>
 #include <QRunnable>
 #include <QStringList>
+#include <QElapsedTimer>
+#include <QVector>
 
 class Db;
 class PopulateEngine;
 
-class PopulateWorker : public QObject, public QRunnable
+class API_EXPORT PopulateWorker : public QObject, public QRunnable
 {
         Q_OBJECT
     public:
@@ -22,6 +25,28 @@ class PopulateWorker : public QObject, public QRunnable
         bool isInterrupted();
         bool beforePopulating();
         void afterPopulating();
+        int getRowsPerInsert() const;
+        SqlQueryPtr prepareInsert(int rows);
+        bool generateValues(int rows);
+        bool insertRows(int rowCount, int rowsPerInsert, SqlQueryPtr batchQuery);
+        void fail();
+
+        /**
+         * @brief Maximum number of bind parameters in a single query.
+         *
+         * This is default value of SQLITE_MAX_VARIABLE_NUMBER for SQLite versions before 3.32.0.
+         */
+        static const int MAX_BIND_PARAMS = 999;
+
+        /**
+         * @brief Number of rows generated at once.
+         *
+         * Values are generated for all columns of this number of rows (possibly in parallel)
+         * and then inserted with as many multi-row INSERT statements as needed.
+         */
+        static const int ROWS_PER_BLOCK = 10000;
+
+        static const int PROGRESS_REPORT_INTERVAL = 200;
 
         Db* db = nullptr;
         QString table;
@@ -30,6 +55,11 @@ class PopulateWorker : public QObject, public QRunnable
         qint64 rows;
         bool interrupted = false;
         QMutex interruptMutex;
+        QVector<QList<QVariant>> columnValues;
+        QList<int> parallelColumns;
+        QElapsedTimer progressTimer;
+        SqlQueryPtr tailQuery;
+        int tailQueryRows = 0;
 
     public slots:
         void interrupt();
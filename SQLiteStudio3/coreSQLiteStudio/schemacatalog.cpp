@@ -0,0 +1,158 @@
+#include "schemacatalog.h"
+#include "parser/token.h"
+
+SchemaCatalog::SchemaState::SchemaState()
+{
+}
+
+SchemaCatalog::SchemaState::SchemaState(int version, const QString& file) :
+    version(version), file(file)
+{
+}
+
+bool SchemaCatalog::SchemaState::isValid() const
+{
+    return version > -1;
+}
+
+bool SchemaCatalog::SchemaState::operator==(const SchemaState& other) const
+{
+    return version == other.version && file == other.file;
+}
+
+bool SchemaCatalog::SchemaState::operator!=(const SchemaState& other) const
+{
+    return !(*this == other);
+}
+
+QString SchemaCatalog::getDdl(Db* db, const QString& schema, const SchemaState& state, const QString& objectKey)
+{
+    QMutexLocker locker(&mutex);
+    return getEntry(db, schema, state).ddls.value(objectKey);
+}
+
+void SchemaCatalog::putDdl(Db* db, const QString& schema, const SchemaState& state, const QString& objectKey, const QString& ddl)
+{
+    QMutexLocker locker(&mutex);
+    getEntry(db, schema, state).ddls[objectKey] = ddl;
+}
+
+SqliteQueryPtr SchemaCatalog::getParsedDdl(Db* db, const QString& schema, const SchemaState& state, const QString& ddl)
+{
+    QMutexLocker locker(&mutex);
+    return getEntry(db, schema, state).parsedDdls.value(ddl);
+}
+
+void SchemaCatalog::putParsedDdl(Db* db, const QString& schema, const SchemaState& state, const QString& ddl, SqliteQueryPtr query)
+{
+    QMutexLocker locker(&mutex);
+    getEntry(db, schema, state).parsedDdls[ddl] = query;
+}
+
+bool SchemaCatalog::getTableColumns(Db* db, const QString& schema, const SchemaState& state, const QString& table, QStringList& columns)
+{
+    QMutexLocker locker(&mutex);
+    SchemaEntry& entry = getEntry(db, schema, state);
+    if (!entry.tableColumns.contains(table))
+        return false;
+
+    columns = entry.tableColumns[table];
+    return true;
+}
+
+void SchemaCatalog::putTableColumns(Db* db, const QString& schema, const SchemaState& state, const QString& table, const QStringList& columns)
+{
+    QMutexLocker locker(&mutex);
+    getEntry(db, schema, state).tableColumns[table] = columns;
+}
+
+void SchemaCatalog::invalidate(Db* db)
+{
+    QMutexLocker locker(&mutex);
+    entries.remove(db);
+    schemaFiles.remove(db);
+}
+
+void SchemaCatalog::invalidate(Db* db, const QString& schema)
+{
+    QMutexLocker locker(&mutex);
+    if (entries.contains(db))
+        entries[db].remove(schema.toLower());
+
+    schemaFiles.remove(db);
+}
+
+bool SchemaCatalog::getSchemaFile(Db* db, const QString& schema, QString& file)
+{
+    QMutexLocker locker(&mutex);
+    if (!schemaFiles.contains(db))
+        return false;
+
+    file = schemaFiles[db].value(schema.toLower());
+    return true;
+}
+
+void SchemaCatalog::putSchemaFiles(Db* db, const QHash<QString, QString>& files)
+{
+    QMutexLocker locker(&mutex);
+    schemaFiles[db] = files;
+}
+
+void SchemaCatalog::invalidateSchemaFiles(Db* db)
+{
+    QMutexLocker locker(&mutex);
+    schemaFiles.remove(db);
+}
+
+SqliteQueryPtr SchemaCatalog::copyOf(const SqliteQueryPtr& query)
+{
+    SqliteQuery* copy = dynamic_cast<SqliteQuery*>(query->clone());
+    QHash<Token*, TokenPtr> copiedTokens;
+    copyTokens(copy, copiedTokens);
+    return SqliteQueryPtr(copy);
+}
+
+SchemaCatalog::SchemaEntry& SchemaCatalog::getEntry(Db* db, const QString& schema, const SchemaState& state)
+{
+    SchemaEntry& entry = entries[db][schema.toLower()];
+    if (entry.state != state)
+    {
+        entry = SchemaEntry();
+        entry.state = state;
+    }
+    return entry;
+}
+
+void SchemaCatalog::copyTokens(SqliteStatement* statement, QHash<Token*, TokenPtr>& copiedTokens)
+{
+    statement->tokens = copyTokens(statement->tokens, copiedTokens);
+
+    QMutableHashIterator<QString, TokenList> it(statement->tokensMap);
+    while (it.hasNext())
+    {
+        it.next();
+        it.setValue(copyTokens(it.value(), copiedTokens));
+    }
+
+    for (SqliteStatement* child : statement->childStatements())
+        copyTokens(child, copiedTokens);
+}
+
+TokenList SchemaCatalog::copyTokens(const TokenList& tokens, QHash<Token*, TokenPtr>& copiedTokens)
+{
+    // Same token is usually referenced by the statement, its parent statements and tokens maps,
+    // so every token is copied only once and the copy is reused for all references.
+    TokenList copiedList;
+    TokenPtr copiedToken;
+    for (const TokenPtr& token : tokens)
+    {
+        copiedToken = copiedTokens.value(token.data());
+        if (!copiedToken)
+        {
+            copiedToken = token->clone();
+            copiedTokens[token.data()] = copiedToken;
+        }
+        copiedList << copiedToken;
+    }
+    return copiedList;
+}
@@ -0,0 +1,99 @@
+#ifndef SCHEMACATALOG_H
+#define SCHEMACATALOG_H
+
+#include "parser/ast/sqlitequery.h"
+#include "coreSQLiteStudio_global.h"
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+class Db;
+
+/**
+ * @brief Shared cache of schema objects used by the SchemaResolver.
+ *
+ * For every database connection and every schema in it ("main", "temp" or attached one) the catalog keeps
+ * object DDLs, parsed DDLs and table column lists. SQLite increments PRAGMA schema_version
+ * on every schema modification, so all entries of the schema are valid for as long as this version doesn't change
+ * and the schema name still points to the same database file. Each call provides the current SchemaState
+ * and entries stored with any other state are dropped.
+ *
+ * The catalog is used only for connections with the SchemaResolver::USE_SCHEMA_CACHING option enabled.
+ *
+ * Parsed statements stored in the catalog are never modified. Whoever needs to modify the parsed statement
+ * should work on a copy made with copyOf(). With that the catalog is safe to use from many threads.
+ */
+class API_EXPORT SchemaCatalog
+{
+    public:
+        /**
+         * @brief State of the schema that cached entries were read from.
+         *
+         * The schema version alone is not enough for attached databases. The same attach name can be detached
+         * and attached again to another file (also with plain ATTACH/DETACH statements typed by the user),
+         * while the other file may have the same schema version. Therefore the file path is part of the state too.
+         */
+        struct API_EXPORT SchemaState
+        {
+            SchemaState();
+            SchemaState(int version, const QString& file);
+
+            bool isValid() const;
+            bool operator==(const SchemaState& other) const;
+            bool operator!=(const SchemaState& other) const;
+
+            int version = -1;
+            QString file;
+        };
+
+        QString getDdl(Db* db, const QString& schema, const SchemaState& state, const QString& objectKey);
+        void putDdl(Db* db, const QString& schema, const SchemaState& state, const QString& objectKey, const QString& ddl);
+        SqliteQueryPtr getParsedDdl(Db* db, const QString& schema, const SchemaState& state, const QString& ddl);
+        void putParsedDdl(Db* db, const QString& schema, const SchemaState& state, const QString& ddl, SqliteQueryPtr query);
+        bool getTableColumns(Db* db, const QString& schema, const SchemaState& state, const QString& table, QStringList& columns);
+        void putTableColumns(Db* db, const QString& schema, const SchemaState& state, const QString& table, const QStringList& columns);
+        void invalidate(Db* db);
+        void invalidate(Db* db, const QString& schema);
+
+        /**
+         * @brief Provides database file of given schema from the list of databases cached for the connection.
+         * @param db Database connection.
+         * @param schema Schema name ("main", "temp" or the attach name).
+         * @param file Database file of the schema. Empty for unknown schema and for in-memory and temporary databases.
+         * @return true if the list is cached, or false if it has to be read with PRAGMA database_list and put with putSchemaFiles().
+         *
+         * The list is changed only by ATTACH and DETACH, so it's cached until it's dropped with invalidateSchemaFiles().
+         */
+        bool getSchemaFile(Db* db, const QString& schema, QString& file);
+        void putSchemaFiles(Db* db, const QHash<QString, QString>& files);
+        void invalidateSchemaFiles(Db* db);
+
+        /**
+         * @brief Creates deep copy of the parsed statement.
+         * @param query Statement to copy.
+         * @return Copy that doesn't share anything with the original statement, including tokens.
+         *
+         * Regular SqliteStatement::clone() shares tokens with the original statement, while some code modifies
+         * token values in place, so the tokens are copied as well.
+         */
+        static SqliteQueryPtr copyOf(const SqliteQueryPtr& query);
+
+    private:
+        struct SchemaEntry
+        {
+            SchemaState state;
+            QHash<QString, QString> ddls;
+            QHash<QString, SqliteQueryPtr> parsedDdls;
+            QHash<QString, QStringList> tableColumns;
+        };
+
+        SchemaEntry& getEntry(Db* db, const QString& schema, const SchemaState& state);
+        static void copyTokens(SqliteStatement* statement, QHash<Token*, TokenPtr>& copiedTokens);
+        static TokenList copyTokens(const TokenList& tokens, QHash<Token*, TokenPtr>& copiedTokens);
+
+        QHash<Db*, QHash<QString, SchemaEntry>> entries;
+        QHash<Db*, QHash<QString, QString>> schemaFiles;
+        QMutex mutex;
+};
+
+#endif // SCHEMACATALOG_H
@@ -16,6 +16,7 @@ const char* sqliteTempMasterDdl =
     "CREATE TABLE sqlite_temp_master (type text, name text, tbl_name text, rootpage integer, sql text)";
 
 ExpiringCache<SchemaResolver::ObjectCacheKey,QVariant> SchemaResolver::cache;
+SchemaCatalog SchemaResolver::catalog;
 
 SchemaResolver::SchemaResolver(Db *db)
     : db(db)
@@ -78,7 +79,7 @@ StrHash< QStringList> SchemaResolver::getGroupedObjects(const QString &database,
 
     for (QString object : inputList)
     {
-        parsedQuery = getParsedObject(database, object, ANY);
+        parsedQuery = getSharedParsedObject(database, object, ANY);
         if (!parsedQuery)
         {
             qWarning() << "Could not get parsed object for " << strType << ":" << object;
@@ -127,7 +128,13 @@ QStringList SchemaResolver::getTableColumns(const QString &database, const QStri
 {
     QStringList columns; // result
 
-    SqliteQueryPtr query = getParsedObject(database, table, TABLE);
+    QString dbName = getPrefixDb(database, db->getDialect());
+    QString lowerTable = stripObjName(table, db->getDialect()).toLower();
+    SchemaCatalog::SchemaState schemaState = getSchemaState(dbName);
+    if (schemaState.isValid() && catalog.getTableColumns(db, dbName, schemaState, lowerTable, columns))
+        return columns;
+
+    SqliteQueryPtr query = getSharedParsedObject(database, table, TABLE);
     if (!query)
         return columns;
 
@@ -153,6 +160,9 @@ QStringList SchemaResolver::getTableColumns(const QString &database, const QStri
     for (SqliteCreateTable::Column* column : createTable->columns)
         columns << column->name;
 
+    if (schemaState.isValid())
+        catalog.putTableColumns(db, dbName, schemaState, lowerTable, columns);
+
     return columns;
 }
 
@@ -164,7 +174,7 @@ QList<DataType> SchemaResolver::getTableColumnDataTypes(const QString& table, in
 QList<DataType> SchemaResolver::getTableColumnDataTypes(const QString& database, const QString& table, int expectedNumberOfTypes)
 {
     QList<DataType> dataTypes;
-    SqliteCreateTablePtr createTable = getParsedObject(database, table, TABLE).dynamicCast<SqliteCreateTable>();
+    SqliteCreateTablePtr createTable = getSharedParsedObject(database, table, TABLE).dynamicCast<SqliteCreateTable>();
     if (!createTable)
     {
         for (int i = 0; i < expectedNumberOfTypes; i++)
@@ -277,6 +287,13 @@ QString SchemaResolver::getObjectDdl(const QString& name, ObjectType type)
 
 QString SchemaResolver::getObjectDdl(const QString &database, const QString &name, ObjectType type)
 {
+    SchemaCatalog::SchemaState schemaState;
+    return getObjectDdl(database, name, type, schemaState);
+}
+
+QString SchemaResolver::getObjectDdl(const QString& database, const QString& name, ObjectType type, SchemaCatalog::SchemaState& schemaState)
+{
+    schemaState = SchemaCatalog::SchemaState();
     if (name.isNull())
         return QString();
 
@@ -296,12 +313,15 @@ QString SchemaResolver::getObjectDdl(const QString &database, const QString &nam
     if (database.toLower() == "temp")
         targetTable = "sqlite_temp_master";
 
-    // Cache
-    QString typeStr = objectTypeToString(type);
-    bool useCache = usesCache();
-    ObjectCacheKey key(ObjectCacheKey::OBJECT_DDL, db, dbName, lowerName, typeStr);
-    if (useCache && cache.contains(key))
-        return cache.object(key, true)->toString();
+    // Catalog
+    QString objectKey = objectTypeToString(type) + "." + lowerName;
+    schemaState = getSchemaState(dbName);
+    if (schemaState.isValid())
+    {
+        QString cachedDdl = catalog.getDdl(db, dbName, schemaState, objectKey);
+        if (!cachedDdl.isNull())
+            return cachedDdl;
+    }
 
     // Get the DDL
     QString resStr = getObjectDdlWithSimpleName(dbName, lowerName, targetTable, type);
@@ -312,8 +332,8 @@ QString SchemaResolver::getObjectDdl(const QString &database, const QString &nam
     if (!resStr.trimmed().endsWith(";"))
         resStr += ";";
 
-    if (useCache)
-        cache.insert(key, new QVariant(resStr));
+    if (schemaState.isValid())
+        catalog.putDdl(db, dbName, schemaState, objectKey, resStr);
 
     // Return the DDL
     return resStr;
@@ -490,14 +510,25 @@ SqliteQueryPtr SchemaResolver::getParsedObject(const QString &name, ObjectType t
 }
 
 SqliteQueryPtr SchemaResolver::getParsedObject(const QString &database, const QString &name, ObjectType type)
+{
+    return getParsedObject(database, name, type, true);
+}
+
+SqliteQueryPtr SchemaResolver::getSharedParsedObject(const QString& database, const QString& name, ObjectType type)
+{
+    return getParsedObject(database, name, type, false);
+}
+
+SqliteQueryPtr SchemaResolver::getParsedObject(const QString& database, const QString& name, ObjectType type, bool copy)
 {
     // Get DDL
-    QString ddl = getObjectDdl(database, name, type);
+    SchemaCatalog::SchemaState schemaState;
+    QString ddl = getObjectDdl(database, name, type, schemaState);
     if (ddl.isNull())
         return SqliteQueryPtr();
 
     // Parse DDL
-    return getParsedDdl(ddl);
+    return getCachedParsedDdl(getPrefixDb(database, db->getDialect()), schemaState, ddl, copy);
 }
 
 StrHash< SqliteQueryPtr> SchemaResolver::getAllParsedObjects()
@@ -573,6 +604,25 @@ SqliteQueryPtr SchemaResolver::getParsedDdl(const QString& ddl)
     return queries[0];
 }
 
+SqliteQueryPtr SchemaResolver::getCachedParsedDdl(const QString& dbName, const SchemaCatalog::SchemaState& schemaState, const QString& ddl, bool copy)
+{
+    if (!schemaState.isValid())
+        return getParsedDdl(ddl);
+
+    SqliteQueryPtr query = catalog.getParsedDdl(db, dbName, schemaState, ddl);
+    if (!query)
+    {
+        query = getParsedDdl(ddl);
+        if (!query)
+            return query;
+
+        catalog.putParsedDdl(db, dbName, schemaState, ddl, query);
+    }
+
+    // Statement kept in the catalog must not be modified, so whoever needs to modify it gets a copy
+    return copy ? SchemaCatalog::copyOf(query) : query;
+}
+
 QStringList SchemaResolver::getObjects(const QString &type)
 {
     return getObjects(QString(), type);
@@ -951,6 +1001,65 @@ void SchemaResolver::staticInit()
     cache.setExpireTime(3000);
 }
 
+void SchemaResolver::invalidateCatalog(Db* db)
+{
+    catalog.invalidate(db);
+}
+
+void SchemaResolver::invalidateCatalog(Db* db, const QString& database)
+{
+    catalog.invalidate(db, getPrefixDb(database, db->getDialect()));
+}
+
+void SchemaResolver::invalidateDatabaseList(Db* db)
+{
+    catalog.invalidateSchemaFiles(db);
+}
+
+SchemaCatalog::SchemaState SchemaResolver::getSchemaState(const QString& dbName)
+{
+    static_qstring(versionSql, "PRAGMA %1.schema_version");
+    static_qstring(databaseListSql, "PRAGMA database_list");
+
+    // Invalid state makes all lookups skip the catalog
+    if (!usesCache())
+        return SchemaCatalog::SchemaState();
+
+    SqlQueryPtr results = db->exec(versionSql.arg(dbName), dbFlags);
+    if (results->isError())
+        return SchemaCatalog::SchemaState();
+
+    bool ok;
+    int version = results->getSingleCell().toInt(&ok);
+    if (!ok)
+        return SchemaCatalog::SchemaState();
+
+    // The same schema name may point to another file after it was detached and attached again.
+    // The list of databases is read again only after ATTACH or DETACH (see AbstractDb::changesDatabaseList()).
+    QString strippedName = stripObjName(dbName, db->getDialect()).toLower();
+    QString file;
+    if (catalog.getSchemaFile(db, strippedName, file))
+        return SchemaCatalog::SchemaState(version, file);
+
+    results = db->exec(databaseListSql, dbFlags);
+    if (results->isError())
+        return SchemaCatalog::SchemaState();
+
+    QHash<QString, QString> files;
+    SqlResultsRowPtr row;
+    while (results->hasNext())
+    {
+        row = results->next();
+        files[row->value("name").toString().toLower()] = row->value("file").toString();
+    }
+    catalog.putSchemaFiles(db, files);
+
+    if (!files.contains(strippedName))
+        return SchemaCatalog::SchemaState();
+
+    return SchemaCatalog::SchemaState(version, files[strippedName]);
+}
+
 bool SchemaResolver::usesCache()
 {
     return db->getConnectionOptions().contains(USE_SCHEMA_CACHING) && db->getConnectionOptions()[USE_SCHEMA_CACHING].toBool();
@@ -1005,7 +1114,7 @@ bool SchemaResolver::isWithoutRowIdTable(const QString& table)
 
 bool SchemaResolver::isWithoutRowIdTable(const QString& database, const QString& table)
 {
-    SqliteQueryPtr query = getParsedObject(database, table, TABLE);
+    SqliteQueryPtr query = getSharedParsedObject(database, table, TABLE);
     if (!query)
         return false;
 
@@ -1018,7 +1127,7 @@ bool SchemaResolver::isWithoutRowIdTable(const QString& database, const QString&
 
 bool SchemaResolver::isVirtualTable(const QString& database, const QString& table)
 {
-    SqliteQueryPtr query = getParsedObject(database, table, TABLE);
+    SqliteQueryPtr query = getSharedParsedObject(database, table, TABLE);
     if (!query)
         return false;
 
@@ -1050,7 +1159,7 @@ QStringList SchemaResolver::getWithoutRowIdTableColumns(const QString& database,
 {
     QStringList columns;
 
-    SqliteQueryPtr query = getParsedObject(database, table, TABLE);
+    SqliteQueryPtr query = getSharedParsedObject(database, table, TABLE);
     if (!query)
         return columns;
 
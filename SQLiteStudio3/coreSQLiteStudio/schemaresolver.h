@@ -15,12 +15,11 @@
 #include "db/db.h"
 #include "common/strhash.h"
 #include "common/expiringcache.h"
+#include "schemacatalog.h"
 #include <QStringList>
 
 class SqliteCreateTable;
 
-// TODO add cache
-
 class API_EXPORT SchemaResolver
 {
     public:
@@ -44,8 +43,7 @@ class API_EXPORT SchemaResolver
             enum Type
             {
                 OBJECT_NAMES,
-                OBJECT_DETAILS,
-                OBJECT_DDL
+                OBJECT_DETAILS
             };
 
             ObjectCacheKey(Type type, Db* db, const QString& value1 = QString(), const QString& value2 = QString(), const QString& value3 = QString());
@@ -190,11 +188,40 @@ class API_EXPORT SchemaResolver
         static ObjectType stringToObjectType(const QString& type);
         static void staticInit();
 
+        /**
+         * @brief Drops all schema objects cached for given database.
+         * @param db Database to drop cached objects for.
+         *
+         * Cached objects are dropped automatically when the schema version or the database file of the schema changes,
+         * so this is only to release memory of connections that are closed or schemas that are detached.
+         */
+        static void invalidateCatalog(Db* db);
+
+        /**
+         * @brief Drops schema objects cached for given schema of the database.
+         * @param db Database to drop cached objects for.
+         * @param database Schema name (the attach name of the database).
+         */
+        static void invalidateCatalog(Db* db, const QString& database);
+
+        /**
+         * @brief Drops the list of databases (main, temp and attached ones) cached for given database.
+         * @param db Database that attached or detached another database.
+         *
+         * Cached schema objects are kept. They are dropped by the next lookup if the schema name points to another file now.
+         */
+        static void invalidateDatabaseList(Db* db);
+
         static_char* USE_SCHEMA_CACHING = "useSchemaCaching";
 
     private:
         bool usesCache();
+        SchemaCatalog::SchemaState getSchemaState(const QString& dbName);
+        QString getObjectDdl(const QString& database, const QString& name, ObjectType type, SchemaCatalog::SchemaState& schemaState);
+        SqliteQueryPtr getParsedObject(const QString& database, const QString& name, ObjectType type, bool copy);
+        SqliteQueryPtr getSharedParsedObject(const QString& database, const QString& name, ObjectType type);
         SqliteQueryPtr getParsedDdl(const QString& ddl);
+        SqliteQueryPtr getCachedParsedDdl(const QString& dbName, const SchemaCatalog::SchemaState& schemaState, const QString& ddl, bool copy);
         SqliteCreateTablePtr virtualTableAsRegularTable(const QString& database, const QString& table);
         StrHash< QStringList> getGroupedObjects(const QString &database, const QStringList& inputList, SqliteQueryType type);
         bool isFilteredOut(const QString& value, const QString& type);
@@ -212,6 +239,7 @@ class API_EXPORT SchemaResolver
         Db::Flags dbFlags;
 
         static ExpiringCache<ObjectCacheKey,QVariant> cache;
+        static SchemaCatalog catalog;
 };
 
 int qHash(const SchemaResolver::ObjectCacheKey& key);
@@ -223,6 +251,7 @@ StrHash<QSharedPointer<T>> SchemaResolver::getAllParsedObjectsForType(const QStr
      StrHash< QSharedPointer<T>> parsedObjects;
 
      QString dbName = getPrefixDb(database, db->getDialect());
+     SchemaCatalog::SchemaState schemaState = getSchemaState(dbName);
 
      SqlQueryPtr results;
 
@@ -237,7 +266,7 @@ StrHash<QSharedPointer<T>> SchemaResolver::getAllParsedObjectsForType(const QStr
      for (SqlResultsRowPtr row : results->getAll())
      {
          name = row->value("name").toString();
-         parsedObject = getParsedDdl(row->value("sql").toString());
+         parsedObject = getCachedParsedDdl(dbName, schemaState, row->value("sql").toString(), true);
          if (!parsedObject)
              continue;
 
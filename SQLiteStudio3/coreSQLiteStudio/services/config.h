@@ -22,6 +22,7 @@ CFG_CATEGORIES(Core,
         CFG_ENTRY(int,          DdlHistorySize,          1000)
         CFG_ENTRY(int,          BindParamsCacheSize,     1000)
         CFG_ENTRY(int,          PopulateHistorySize,     100)
+        CFG_ENTRY(int,          PopulateRandomSeed,      0)
         CFG_ENTRY(QString,      LoadedPlugins,           "")
         CFG_ENTRY(QVariantHash, ActiveCodeFormatter,     QVariantHash())
         CFG_ENTRY(bool,         CheckUpdatesOnStartup,   true)
@@ -142,6 +143,20 @@ class API_EXPORT Config : public QObject
         virtual QList<CfgDbPtr> dbList() = 0;
         virtual CfgDbPtr getDb(const QString& dbName) = 0;
 
+        /**
+         * @brief Provides name of the plugin that was found to handle the database file.
+         * @param path Path to the database file.
+         * @param modified Set to the last modification time of the file (in milliseconds since epoch) when it was probed.
+         * @param size Set to the size of the file in bytes when it was probed.
+         * @return Name of the plugin, or null string if the file wasn't probed yet.
+         *
+         * Probing databases with plugins requires opening every database, which is slow for big number
+         * of databases (especially on network drives), therefore results are remembered with file modification time and size.
+         * The result is valid only if the file has still the same modification time and size.
+         */
+        virtual QString getDbProbeResult(const QString& path, qint64& modified, qint64& size) = 0;
+        virtual void storeDbProbeResult(const QString& path, qint64 modified, qint64 size, const QString& pluginName) = 0;
+
         virtual void storeGroups(const QList<DbGroupPtr>& groups) = 0;
         virtual QList<DbGroupPtr> getGroups() = 0;
         virtual DbGroupPtr getDbGroup(const QString& dbName) = 0;
@@ -144,6 +144,19 @@ class API_EXPORT ExportManager : public PluginServiceBase
              * Default is true.
              */
             bool exportTableTriggers = true;
+
+            /**
+             * @brief When exporting table or database, this indicates if all data should be read from a single snapshot of the database.
+             *
+             * The export opens its own connection to the database and reads everything in a single read transaction,
+             * so changes committed by other connections during the export are not visible to it. In WAL journal mode
+             * this doesn't block writers. In other journal modes writers cannot commit until the export is finished.
+             *
+             * Tables are read sequentially in this mode. It has no effect for in-memory databases.
+             *
+             * Default is false.
+             */
+            bool consistentSnapshot = false;
         };
 
         /**
@@ -17,6 +17,52 @@ class API_EXPORT FunctionManager : public QObject
     Q_OBJECT
 
     public:
+        /**
+         * @brief Per-statement storage for data derived from function arguments.
+         *
+         * When SQLite evaluates a function with the same argument value for all rows of the statement
+         * (usually a literal, like the pattern of REGEXP), data derived from that value (a compiled pattern,
+         * a parsed format, etc.) can be stored here and it will be available to next calls of the function
+         * within the same statement, as long as the argument value doesn't change.
+         *
+         * For SQLite 3 databases it's backed by sqlite3_get_auxdata() and sqlite3_set_auxdata().
+         * Other database types provide no cache at all.
+         */
+        class API_EXPORT ArgumentCache
+        {
+            public:
+                virtual ~ArgumentCache() {}
+
+                /**
+                 * @brief Gets data cached for the given argument.
+                 * @param argIndex Index of the argument.
+                 * @return Cached data, or null if there is nothing cached (yet, or anymore).
+                 */
+                template <class T>
+                T* get(int argIndex) const
+                {
+                    return static_cast<T*>(getData(argIndex));
+                }
+
+                /**
+                 * @brief Stores data for the given argument.
+                 * @param argIndex Index of the argument.
+                 * @param data Data to store. The cache takes ownership of it.
+                 *
+                 * SQLite may decide not to keep the data and delete it immediately,
+                 * therefore the data must not be used after this call.
+                 */
+                template <class T>
+                void set(int argIndex, T* data)
+                {
+                    setData(argIndex, data, [](void* ptr) {delete static_cast<T*>(ptr);});
+                }
+
+            protected:
+                virtual void* getData(int argIndex) const = 0;
+                virtual void setData(int argIndex, void* data, void (*deleter)(void*)) = 0;
+        };
+
         struct API_EXPORT FunctionBase
         {
             enum Type
@@ -53,7 +99,16 @@ class API_EXPORT FunctionManager : public QObject
         {
             typedef std::function<QVariant(const QList<QVariant>& args, Db* db, bool& ok)> ImplementationFunction;
 
+            typedef std::function<QVariant(const QList<QVariant>& args, Db* db, bool& ok, ArgumentCache* argCache)> CachingImplementationFunction;
+
             ImplementationFunction functionPtr;
+
+            /**
+             * @brief Implementation that can make use of the ArgumentCache.
+             *
+             * If defined, it's used instead of the functionPtr. The cache passed to it may be null.
+             */
+            CachingImplementationFunction cachingFunctionPtr;
         };
 
         virtual void setScriptFunctions(const QList<ScriptFunction*>& newFunctions) = 0;
@@ -61,7 +116,8 @@ class API_EXPORT FunctionManager : public QObject
         virtual QList<ScriptFunction*> getScriptFunctionsForDatabase(const QString& dbName) const = 0;
         virtual QList<NativeFunction*> getAllNativeFunctions() const = 0;
 
-        virtual QVariant evaluateScalar(const QString& name, int argCount, const QList<QVariant>& args, Db* db, bool& ok) = 0;
+        virtual QVariant evaluateScalar(const QString& name, int argCount, const QList<QVariant>& args, Db* db, bool& ok,
+                                        ArgumentCache* argCache = nullptr) = 0;
         virtual void evaluateAggregateInitial(const QString& name, int argCount, Db* db, QHash<QString, QVariant>& aggregateStorage) = 0;
         virtual void evaluateAggregateStep(const QString& name, int argCount, const QList<QVariant>& args, Db* db,
                                            QHash<QString, QVariant>& aggregateStorage) = 0;
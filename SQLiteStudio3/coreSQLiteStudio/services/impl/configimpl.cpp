@@ -165,6 +165,7 @@ bool ConfigImpl::addDb(const QString& name, const QString& path, const QHash<QSt
 bool ConfigImpl::updateDb(const QString &name, const QString &newName, const QString &path, const QHash<QString,QVariant> &options)
 {
     QByteArray optBytes = hashToBytes(options);
+    db->exec("DELETE FROM db_probe_cache WHERE path = (SELECT path FROM dblist WHERE name = ?)", {name});
     SqlQueryPtr results = db->exec("UPDATE dblist SET name = ?, path = ?, options = ? WHERE name = ?",
                                      {newName, path, optBytes, name});
 
@@ -173,6 +174,7 @@ bool ConfigImpl::updateDb(const QString &name, const QString &newName, const QSt
 
 bool ConfigImpl::removeDb(const QString &name)
 {
+    db->exec("DELETE FROM db_probe_cache WHERE path = (SELECT path FROM dblist WHERE name = ?)", {name});
     SqlQueryPtr results = db->exec("DELETE FROM dblist WHERE name = ?", {name});
     return (!storeErrorAndReturn(results) && results->rowsAffected() > 0);
 }
@@ -232,6 +234,37 @@ ConfigImpl::CfgDbPtr ConfigImpl::getDb(const QString& dbName)
     return cfgDb;
 }
 
+QString ConfigImpl::getDbProbeResult(const QString& path, qint64& modified, qint64& size)
+{
+    static_qstring(query, "SELECT plugin, modified, size FROM db_probe_cache WHERE path = ?");
+
+    modified = -1;
+    size = -1;
+    SqlQueryPtr results = db->exec(query, {path});
+    if (results->isError())
+    {
+        qWarning() << "Error while getting database probing result:" << db->getErrorText();
+        return QString();
+    }
+
+    if (!results->hasNext())
+        return QString();
+
+    SqlResultsRowPtr row = results->next();
+    modified = row->value("modified").toLongLong();
+    size = row->value("size").toLongLong();
+    return row->value("plugin").toString();
+}
+
+void ConfigImpl::storeDbProbeResult(const QString& path, qint64 modified, qint64 size, const QString& pluginName)
+{
+    static_qstring(query, "INSERT OR REPLACE INTO db_probe_cache (path, modified, size, plugin) VALUES (?, ?, ?, ?)");
+
+    SqlQueryPtr results = db->exec(query, {path, modified, size, pluginName});
+    if (results->isError())
+        qWarning() << "Error while storing database probing result:" << db->getErrorText();
+}
+
 void ConfigImpl::storeGroups(const QList<DbGroupPtr>& groups)
 {
     db->begin();
@@ -672,6 +705,9 @@ void ConfigImpl::initTables()
     if (!tables.contains("dblist"))
         db->exec("CREATE TABLE dblist (name TEXT PRIMARY KEY, path TEXT UNIQUE, options TEXT)");
 
+    if (!tables.contains("db_probe_cache"))
+        db->exec("CREATE TABLE db_probe_cache (path TEXT PRIMARY KEY, modified INTEGER, size INTEGER, plugin TEXT)");
+
     if (!tables.contains("groups"))
         db->exec("CREATE TABLE groups (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT, parent INTEGER REFERENCES groups(id), "
                  "[order] INTEGER, open INTEGER DEFAULT 0, dbname TEXT UNIQUE REFERENCES dblist(name) ON UPDATE CASCADE ON DELETE CASCADE, "
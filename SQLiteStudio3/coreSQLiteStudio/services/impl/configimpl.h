@@ -50,6 +50,8 @@ class API_EXPORT ConfigImpl : public Config
          */
         QList<CfgDbPtr> dbList();
         CfgDbPtr getDb(const QString& dbName);
+        QString getDbProbeResult(const QString& path, qint64& modified, qint64& size);
+        void storeDbProbeResult(const QString& path, qint64 modified, qint64 size, const QString& pluginName);
 
         void storeGroups(const QList<DbGroupPtr>& groups);
         QList<DbGroupPtr> getGroups();
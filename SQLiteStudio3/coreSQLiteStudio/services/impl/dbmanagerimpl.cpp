@@ -13,6 +13,8 @@
 #include <QDebug>
 #include <QUrl>
 #include <QDir>
+#include <QDateTime>
+#include <QtConcurrent/QtConcurrentRun>
 #include <db/invaliddb.h>
 
 DbManagerImpl::DbManagerImpl(QObject *parent) :
@@ -398,26 +400,42 @@ void DbManagerImpl::rescanInvalidDatabasesForPlugin(DbPlugin* dbPlugin)
         return;
     }
 
-    Db* db = nullptr;
-
-    QUrl url;
-    QString errorMessages;
+    // Databases are probed in parallel, as each probing opens the database file, which might take a while
+    // (especially on network drives). Results are then applied one by one in this thread.
+    QList<DbPlugin*> plugins = PLUGINS->getLoadedPlugins<DbPlugin>();
+    QList<Db*> probedDatabases;
+    QList<QFuture<ProbeResult>> probes;
+    ProbeRequest request;
     for (Db* invalidDb : getInvalidDatabases())
     {
         if (invalidDb->getConnectionOptions().contains(DB_PLUGIN) && invalidDb->getConnectionOptions()[DB_PLUGIN].toString() != dbPlugin->getName())
             continue;
 
-        url = QUrl::fromUserInput(invalidDb->getPath());
-        if (url.isLocalFile() && !QFile::exists(invalidDb->getPath()))
+        request.name = invalidDb->getName();
+        request.path = invalidDb->getPath();
+        request.options = invalidDb->getConnectionOptions();
+        request.cachedPluginName = CFG->getDbProbeResult(request.path, request.cachedModified, request.cachedSize);
+
+        probedDatabases << invalidDb;
+        probes << QtConcurrent::run(&DbManagerImpl::probeDb, request, dbPlugin, plugins);
+    }
+
+    Db* db = nullptr;
+    Db* invalidDb = nullptr;
+    ProbeResult result;
+    for (int i = 0; i < probes.size(); i++)
+    {
+        invalidDb = probedDatabases[i];
+        result = probes[i].result();
+        if (result.fileMissing)
             continue;
 
-        errorMessages = QString();
-        db = createDb(invalidDb->getName(), invalidDb->getPath(), invalidDb->getConnectionOptions(), &errorMessages);
+        db = result.db;
         if (!db)
         {
-            if (!errorMessages.isNull())
+            if (!result.errorMessages.isNull())
             {
-                dynamic_cast<InvalidDb*>(invalidDb)->setError(errorMessages);
+                dynamic_cast<InvalidDb*>(invalidDb)->setError(result.errorMessages);
             }
             continue; // For this db driver was not loaded yet.
         }
@@ -431,6 +449,9 @@ void DbManagerImpl::rescanInvalidDatabasesForPlugin(DbPlugin* dbPlugin)
             continue;
         }
 
+        if (!result.fromCache && result.fileSize > -1)
+            CFG->storeDbProbeResult(invalidDb->getPath(), result.fileModified, result.fileSize, dbPlugin->getName());
+
         removeDbInternal(invalidDb, false);
         delete invalidDb;
 
@@ -495,19 +516,63 @@ Db* DbManagerImpl::tryToLoadDb(InvalidDb* invalidDb, bool emitNotifySignal)
     return db;
 }
 
+DbManagerImpl::ProbeResult DbManagerImpl::probeDb(const ProbeRequest& request, DbPlugin* dbPlugin, const QList<DbPlugin*>& dbPlugins)
+{
+    ProbeResult result;
+    QUrl url = QUrl::fromUserInput(request.path);
+    if (url.isLocalFile())
+    {
+        QFileInfo fileInfo(request.path);
+        if (!fileInfo.exists())
+        {
+            result.fileMissing = true;
+            return result;
+        }
+
+        result.fileModified = fileInfo.lastModified().toMSecsSinceEpoch();
+        result.fileSize = fileInfo.size();
+        if (request.cachedPluginName == dbPlugin->getName() && request.cachedModified == result.fileModified && request.cachedSize == result.fileSize)
+        {
+            // The plugin has already accepted this file and the file was not modified since then
+            result.db = dbPlugin->getInstanceWithoutProbing(request.name, normalizeDbPath(request.path), request.options, &result.errorMessages);
+            if (result.db && !result.db->initAfterCreated())
+                safe_delete(result.db);
+
+            result.fromCache = (result.db != nullptr);
+        }
+    }
+
+    if (!result.db)
+        result.db = createDb(request.name, request.path, request.options, &result.errorMessages, dbPlugins);
+
+    // Database object is created in the pool thread, but it will be used by the main thread
+    if (result.db)
+        result.db->moveToThread(QCoreApplication::instance()->thread());
+
+    return result;
+}
+
+QString DbManagerImpl::normalizeDbPath(const QString& path)
+{
+    QUrl url(path);
+    if (url.scheme().isEmpty() || url.scheme() == "file")
+        return QDir(path).absolutePath();
+
+    return path;
+}
+
 Db* DbManagerImpl::createDb(const QString &name, const QString &path, const QHash<QString,QVariant> &options, QString* errorMessages)
 {
-    QList<DbPlugin*> dbPlugins = PLUGINS->getLoadedPlugins<DbPlugin>();
+    return createDb(name, path, options, errorMessages, PLUGINS->getLoadedPlugins<DbPlugin>());
+}
+
+Db* DbManagerImpl::createDb(const QString &name, const QString &path, const QHash<QString,QVariant> &options, QString* errorMessages,
+                            const QList<DbPlugin*>& dbPlugins)
+{
     Db* db = nullptr;
     QStringList messages;
     QString message;
-
-    QString normalizedPath;
-    QUrl url(path);
-    if (url.scheme().isEmpty() || url.scheme() == "file")
-        normalizedPath = QDir(path).absolutePath();
-    else
-        normalizedPath = path;
+    QString normalizedPath = normalizeDbPath(path);
 
     for (DbPlugin* dbPlugin : dbPlugins)
     {
@@ -56,6 +56,32 @@ class API_EXPORT DbManagerImpl : public DbManager
         void setInMemDbCreatorPlugin(DbPlugin* plugin);
 
     private:
+        /**
+         * @brief Database to probe in the pool thread, together with its probe cache entry read in the main thread.
+         */
+        struct ProbeRequest
+        {
+            QString name;
+            QString path;
+            QHash<QString, QVariant> options;
+            QString cachedPluginName;
+            qint64 cachedModified = -1;
+            qint64 cachedSize = -1;
+        };
+
+        /**
+         * @brief Result of probing single database in the pool thread.
+         */
+        struct ProbeResult
+        {
+            Db* db = nullptr;
+            QString errorMessages;
+            bool fileMissing = false;
+            bool fromCache = false;
+            qint64 fileModified = -1;
+            qint64 fileSize = -1;
+        };
+
         /**
          * @brief Internal manager initialization.
          *
@@ -112,6 +138,23 @@ class API_EXPORT DbManagerImpl : public DbManager
          * First plugin that provides database object is accepted and its result is returned from the method.
          */
         static Db* createDb(const QString &name, const QString &path, const QHash<QString, QVariant> &options, QString* errorMessages = nullptr);
+        static Db* createDb(const QString &name, const QString &path, const QHash<QString, QVariant> &options, QString* errorMessages,
+                            const QList<DbPlugin*>& dbPlugins);
+
+        /**
+         * @brief Creates database object for the database that is about to be loaded by the newly loaded plugin.
+         * @param request Database to probe, with its entry from the probe cache.
+         * @param dbPlugin Plugin that was just loaded.
+         * @param dbPlugins All loaded database plugins.
+         * @return Created database (if any) and details of the probed file.
+         *
+         * This is called from the thread pool. If the file was already accepted by the plugin and it wasn't modified since,
+         * then the database object is created without opening the file. Otherwise it works like createDb().
+         * The configuration is not thread-safe, so the probe cache is read before and written after, in the main thread.
+         */
+        static ProbeResult probeDb(const ProbeRequest& request, DbPlugin* dbPlugin, const QList<DbPlugin*>& dbPlugins);
+
+        static QString normalizeDbPath(const QString& path);
 
         /**
          * @brief Registered databases list. Both permanent and transient databases.
@@ -48,7 +48,7 @@ QList<FunctionManager::ScriptFunction*> FunctionManagerImpl::getScriptFunctionsF
     return results;
 }
 
-QVariant FunctionManagerImpl::evaluateScalar(const QString& name, int argCount, const QList<QVariant>& args, Db* db, bool& ok)
+QVariant FunctionManagerImpl::evaluateScalar(const QString& name, int argCount, const QList<QVariant>& args, Db* db, bool& ok, ArgumentCache* argCache)
 {
     Key key;
     key.name = name;
@@ -62,7 +62,7 @@ QVariant FunctionManagerImpl::evaluateScalar(const QString& name, int argCount,
     else if (nativeFunctionsByKey.contains(key))
     {
         NativeFunction* function = nativeFunctionsByKey[key];
-        return evaluateNativeScalar(function, args, db, ok);
+        return evaluateNativeScalar(function, args, db, ok, argCache);
     }
 
     ok = false;
@@ -226,7 +226,7 @@ QList<FunctionManager::NativeFunction*> FunctionManagerImpl::getAllNativeFunctio
     return nativeFunctions;
 }
 
-QVariant FunctionManagerImpl::evaluateNativeScalar(NativeFunction* func, const QList<QVariant>& args, Db* db, bool& ok)
+QVariant FunctionManagerImpl::evaluateNativeScalar(NativeFunction* func, const QList<QVariant>& args, Db* db, bool& ok, ArgumentCache* argCache)
 {
     if (!func->undefinedArgs && args.size() != func->arguments.size())
     {
@@ -235,6 +235,9 @@ QVariant FunctionManagerImpl::evaluateNativeScalar(NativeFunction* func, const Q
                                                                                                 QString::number(args.size()));
     }
 
+    if (func->cachingFunctionPtr)
+        return func->cachingFunctionPtr(args, db, ok, argCache);
+
     return func->functionPtr(args, db, ok);
 }
 
@@ -247,7 +250,7 @@ void FunctionManagerImpl::init()
 
 void FunctionManagerImpl::initNativeFunctions()
 {
-    registerNativeFunction("regexp", {"pattern", "arg"}, FunctionManagerImpl::nativeRegExp);
+    registerNativeCachingFunction("regexp", {"pattern", "arg"}, FunctionManagerImpl::nativeRegExp);
     registerNativeFunction("sqlfile", {"file"}, FunctionManagerImpl::nativeSqlFile);
     registerNativeFunction("readfile", {"file"}, FunctionManagerImpl::nativeReadFile);
     registerNativeFunction("writefile", {"file", "data"}, FunctionManagerImpl::nativeWriteFile);
@@ -354,7 +357,7 @@ QString FunctionManagerImpl::langUnsupportedError(const QString& name, int argCo
             .arg(name).arg(argMarkers.join(",")).arg(lang);
 }
 
-QVariant FunctionManagerImpl::nativeRegExp(const QList<QVariant>& args, Db* db, bool& ok)
+QVariant FunctionManagerImpl::nativeRegExp(const QList<QVariant>& args, Db* db, bool& ok, ArgumentCache* argCache)
 {
     UNUSED(db);
 
@@ -364,15 +367,28 @@ QVariant FunctionManagerImpl::nativeRegExp(const QList<QVariant>& args, Db* db,
         return QVariant();
     }
 
-    QRegularExpression re(args[0].toString());
-    if (!re.isValid())
+    // The pattern is usually the same for all rows of the statement, so it's compiled only once
+    // and then taken from the cache, for as long as SQLite keeps it.
+    QRegularExpression* cachedRe = argCache ? argCache->get<QRegularExpression>(0) : nullptr;
+    if (cachedRe)
+        return cachedRe->match(args[1].toString()).hasMatch();
+
+    QRegularExpression* re = new QRegularExpression(args[0].toString());
+    if (!re->isValid())
     {
+        delete re;
         ok = false;
         return tr("Invalid regular expression pattern: %1").arg(args[0].toString());
     }
 
-    QRegularExpressionMatch match = re.match(args[1].toString());
-    return match.hasMatch();
+    re->optimize();
+    bool matched = re->match(args[1].toString()).hasMatch();
+    if (argCache)
+        argCache->set(0, re);
+    else
+        delete re;
+
+    return matched;
 }
 
 QVariant FunctionManagerImpl::nativeSqlFile(const QList<QVariant>& args, Db* db, bool& ok)
@@ -781,6 +797,17 @@ void FunctionManagerImpl::registerNativeFunction(const QString& name, const QStr
     nativeFunctions << nf;
 }
 
+void FunctionManagerImpl::registerNativeCachingFunction(const QString& name, const QStringList& args, FunctionManager::NativeFunction::CachingImplementationFunction funcPtr)
+{
+    NativeFunction* nf = new NativeFunction();
+    nf->name = name;
+    nf->arguments = args;
+    nf->type = FunctionBase::SCALAR;
+    nf->undefinedArgs = false;
+    nf->cachingFunctionPtr = funcPtr;
+    nativeFunctions << nf;
+}
+
 int qHash(const FunctionManagerImpl::Key& key)
 {
     return qHash(key.name) ^ key.argCount ^ static_cast<int>(key.type);
@@ -19,7 +19,7 @@ class API_EXPORT FunctionManagerImpl : public FunctionManager
         QList<ScriptFunction*> getAllScriptFunctions() const;
         QList<ScriptFunction*> getScriptFunctionsForDatabase(const QString& dbName) const;
         QList<NativeFunction*> getAllNativeFunctions() const;
-        QVariant evaluateScalar(const QString& name, int argCount, const QList<QVariant>& args, Db* db, bool& ok);
+        QVariant evaluateScalar(const QString& name, int argCount, const QList<QVariant>& args, Db* db, bool& ok, ArgumentCache* argCache = nullptr);
         void evaluateAggregateInitial(const QString& name, int argCount, Db* db, QHash<QString, QVariant>& aggregateStorage);
         void evaluateAggregateStep(const QString& name, int argCount, const QList<QVariant>& args, Db* db, QHash<QString, QVariant>& aggregateStorage);
         QVariant evaluateAggregateFinal(const QString& name, int argCount, Db* db, bool& ok, QHash<QString, QVariant>& aggregateStorage);
@@ -30,7 +30,7 @@ class API_EXPORT FunctionManagerImpl : public FunctionManager
                                          QHash<QString, QVariant>& aggregateStorage);
         QVariant evaluateScriptAggregateFinal(ScriptFunction* func, const QString& name, int argCount, Db* db, bool& ok,
                                               QHash<QString, QVariant>& aggregateStorage);
-        QVariant evaluateNativeScalar(NativeFunction* func, const QList<QVariant>& args, Db* db, bool& ok);
+        QVariant evaluateNativeScalar(NativeFunction* func, const QList<QVariant>& args, Db* db, bool& ok, ArgumentCache* argCache = nullptr);
 
     private:
         struct Key
@@ -56,9 +56,10 @@ class API_EXPORT FunctionManagerImpl : public FunctionManager
         QString cannotFindFunctionError(const QString& name, int argCount);
         QString langUnsupportedError(const QString& name, int argCount, const QString& lang);
         void registerNativeFunction(const QString& name, const QStringList& args, NativeFunction::ImplementationFunction funcPtr);
+        void registerNativeCachingFunction(const QString& name, const QStringList& args, NativeFunction::CachingImplementationFunction funcPtr);
 
         static QStringList getArgMarkers(int argCount);
-        static QVariant nativeRegExp(const QList<QVariant>& args, Db* db, bool& ok);
+        static QVariant nativeRegExp(const QList<QVariant>& args, Db* db, bool& ok, ArgumentCache* argCache);
         static QVariant nativeSqlFile(const QList<QVariant>& args, Db* db, bool& ok);
         static QVariant nativeReadFile(const QList<QVariant>& args, Db* db, bool& ok);
         static QVariant nativeWriteFile(const QList<QVariant>& args, Db* db, bool& ok);
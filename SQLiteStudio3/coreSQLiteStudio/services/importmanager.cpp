@@ -65,10 +65,14 @@ void ImportManager::importToTable(Db* db, const QString& table, bool async)
     }
 
     importInProgress = true;
+    importedRows = 0;
+    importedBytes = -1;
+    importTimer.start();
 
     ImportWorker* worker = new ImportWorker(plugin, &importConfig, db, table);
     connect(worker, SIGNAL(finished(bool)), this, SLOT(finalizeImport(bool)));
     connect(worker, SIGNAL(createdTable(Db*,QString)), this, SLOT(handleTableCreated(Db*,QString)));
+    connect(worker, SIGNAL(progress(qint64,qint64)), this, SLOT(handleProgress(qint64,qint64)));
     connect(this, SIGNAL(orderWorkerToInterrupt()), worker, SLOT(interrupt()));
 
     if (async)
@@ -87,19 +91,35 @@ bool ImportManager::isAnyPluginAvailable()
     return PLUGINS->getLoadedPlugins<ImportPlugin>().size() > 0;
 }
 
+qint64 ImportManager::perSecond(qint64 value) const
+{
+    qint64 elapsed = importTimer.elapsed();
+    if (elapsed <= 0)
+        return value;
+
+    return value * 1000 / elapsed;
+}
+
 void ImportManager::finalizeImport(bool result)
 {
     importInProgress = false;
     emit importFinished();
     if (result)
     {
-        notifyInfo(tr("Imported data to the table '%1' successfully.").arg(table));
+        notifyInfo(tr("Imported data to the table '%1' successfully. Number of imported rows: %2").arg(table, QString::number(importedRows)));
         emit importSuccessful();
     }
     else
         emit importFailed();
 }
 
+void ImportManager::handleProgress(qint64 rows, qint64 bytes)
+{
+    importedRows = rows;
+    importedBytes = bytes;
+    emit importProgress(rows, bytes, perSecond(rows), bytes > -1 ? perSecond(bytes) : -1);
+}
+
 void ImportManager::handleTableCreated(Db* db, const QString& table)
 {
     UNUSED(table);
@@ -5,6 +5,7 @@
 #include "coreSQLiteStudio_global.h"
 #include <QFlags>
 #include <QStringList>
+#include <QElapsedTimer>
 
 class ImportPlugin;
 class Db;
@@ -39,6 +40,26 @@ class API_EXPORT ImportManager : public PluginServiceBase
 
             bool ignoreErrors = false;
             bool skipTransaction = false;
+
+            /**
+             * @brief Number of rows imported between transaction commits.
+             *
+             * When it's greater than zero, the transaction is committed (and a new one started) after approximately this many rows
+             * were imported, so the rollback journal doesn't grow with the whole imported data. Rows committed this way
+             * stay in the table even if the import fails later on.
+             *
+             * Zero means that all the data is imported in a single transaction. Ignored if skipTransaction is true.
+             */
+            int commitInterval = 0;
+
+            /**
+             * @brief Relaxes database durability for the time of the import.
+             *
+             * If enabled, the journal is kept in memory, disk synchronization is disabled and the page cache is increased
+             * while importing. Original values of those pragmas are restored once the import is finished.
+             * Ignored if skipTransaction is true.
+             */
+            bool fastImportPragmas = false;
         };
 
         enum StandardConfigFlag
@@ -60,11 +81,16 @@ class API_EXPORT ImportManager : public PluginServiceBase
         static bool isAnyPluginAvailable();
 
     private:
+        qint64 perSecond(qint64 value) const;
+
         StandardImportConfig importConfig;
         ImportPlugin* plugin = nullptr;
         bool importInProgress = false;
         Db* db = nullptr;
         QString table;
+        qint64 importedRows = 0;
+        qint64 importedBytes = -1;
+        QElapsedTimer importTimer;
 
     public slots:
         void interrupt();
@@ -72,6 +98,7 @@ class API_EXPORT ImportManager : public PluginServiceBase
     private slots:
         void finalizeImport(bool result);
         void handleTableCreated(Db* db, const QString& table);
+        void handleProgress(qint64 rows, qint64 bytes);
 
     signals:
         void importFinished();
@@ -79,6 +106,15 @@ class API_EXPORT ImportManager : public PluginServiceBase
         void importFailed();
         void orderWorkerToInterrupt();
         void schemaModified(Db* db);
+
+        /**
+         * @brief Reports progress of the import being currently executed.
+         * @param rows Number of rows imported so far.
+         * @param bytes Number of bytes read from the data source so far, or -1 if the import plugin cannot tell it.
+         * @param rowsPerSecond Average import speed in rows.
+         * @param bytesPerSecond Average import speed in bytes, or -1 if the number of bytes is unknown.
+         */
+        void importProgress(qint64 rows, qint64 bytes, qint64 rowsPerSecond, qint64 bytesPerSecond);
 };
 
 #define IMPORT_MANAGER SQLITESTUDIO->getImportManager()
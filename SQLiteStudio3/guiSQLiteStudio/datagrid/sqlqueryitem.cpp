@@ -7,8 +7,7 @@
 #include <QDate>
 #include <QDebug>
 
-SqlQueryItem::SqlQueryItem(QObject *parent) :
-    QObject(parent)
+SqlQueryItem::SqlQueryItem()
 {
     setUncommitted(false);
     setCommittingError(false);
@@ -17,7 +16,7 @@ SqlQueryItem::SqlQueryItem(QObject *parent) :
 }
 
 SqlQueryItem::SqlQueryItem(const SqlQueryItem &item)
-    : QObject(item.QObject::parent()), QStandardItem(item)
+    : QStandardItem(item)
 {
 }
 
@@ -5,12 +5,19 @@
 #include "db/sqlquery.h"
 #include "guiSQLiteStudio_global.h"
 #include <QStandardItem>
+#include <QCoreApplication>
 
 class SqlQueryModel;
 
-class GUI_API_EXPORT SqlQueryItem : public QObject, public QStandardItem
+/**
+ * @brief Single cell of the data grid.
+ *
+ * There is one item per every cell of loaded page of data, so it's intentionally not a QObject,
+ * as QObject would double the memory and time needed to load big pages.
+ */
+class GUI_API_EXPORT SqlQueryItem : public QStandardItem
 {
-    Q_OBJECT
+    Q_DECLARE_TR_FUNCTIONS(SqlQueryItem)
 
     public:
         struct GUI_API_EXPORT DataRole // not 'enum class' because we need autocasting to int for this one
@@ -31,7 +38,7 @@ class GUI_API_EXPORT SqlQueryItem : public QObject, public QStandardItem
             };
         };
 
-        explicit SqlQueryItem(QObject *parent = 0);
+        SqlQueryItem();
         SqlQueryItem(const SqlQueryItem& item);
 
         QStandardItem* clone() const;
@@ -18,6 +18,7 @@
 #include <QMutableListIterator>
 #include <QInputDialog>
 #include <QTime>
+#include <QElapsedTimer>
 #include <QtMath>
 #include <QMessageBox>
 #include <QThread>
@@ -159,6 +160,11 @@ qint64 SqlQueryModel::getTotalRowsReturned()
     return totalRowsReturned;
 }
 
+QueryExecutor::RowCountAccuracy SqlQueryModel::getTotalRowsAccuracy() const
+{
+    return totalRowsAccuracy;
+}
+
 qint64 SqlQueryModel::getTotalRowsAffected()
 {
     return rowsAffected;
@@ -769,73 +775,96 @@ bool SqlQueryModel::loadData(SqlQueryPtr results)
     readColumns();
 
     // Load data
-    SqlResultsRowPtr row;
+    SqlResultsBlock block;
     int rowIdx = 0;
     int rowsPerPage = getRowsPerPage();
     rowNumBase = getCurrentPage() * rowsPerPage + 1;
 
     updateColumnHeaderLabels();
     QList<QList<QStandardItem*>> rowList;
-    while (results->hasNext() && rowIdx < rowsPerPage)
+    rowList.reserve(rowsPerPage);
+    QElapsedTimer eventsTimer;
+    eventsTimer.start();
+    while (rowIdx < rowsPerPage && results->nextBatch(qMin(rowsPerLoadBatch, rowsPerPage - rowIdx), block) > 0)
     {
-        row = results->next();
-        if (!row)
-            break;
+        for (int i = 0; i < block.rowCount(); i++)
+            rowList << loadRow(block, i);
 
-        rowList << loadRow(row);
+        rowIdx += block.rowCount();
 
-        if ((rowIdx % 50) == 0)
+        if (eventsTimer.elapsed() >= eventsProcessingInterval)
         {
             qApp->processEvents();
             if (!existingModels.contains(this))
                 return false;
-        }
 
-        rowIdx++;
+            eventsTimer.restart();
+        }
     }
 
+    // Remembering where the next page starts, so it can be queried by key, instead of OFFSET
+    QString keysetColumn = queryExecutor->getKeysetColumnAlias();
+    if (!block.isEmpty() && rowIdx == rowsPerPage && !keysetColumn.isNull())
+        queryExecutor->setPageSeekKey(getCurrentPage() + 1, block.value(block.rowCount() - 1, keysetColumn));
+
+    // Inserting rows one by one would notify views about each row separately,
+    // which gets very slow for big pages. Views are reset once instead.
+    beginResetModel();
+    blockSignals(true);
     rowIdx = 0;
     for (const QList<QStandardItem*>& row : rowList)
         insertRow(rowIdx++, row);
 
+    blockSignals(false);
+    endResetModel();
+
     allDataLoaded = true;
     return true;
 }
 
-QList<QStandardItem*> SqlQueryModel::loadRow(SqlResultsRowPtr row)
+QList<QStandardItem*> SqlQueryModel::loadRow(const SqlResultsBlock& block, int row)
 {
     QList<QStandardItem*> itemList;
     SqlQueryItem* item = nullptr;
-    RowId rowId;
-    int colIdx = 0;
-    for (const QVariant& value : row->valueList().mid(0, resultColumnCount))
+    int colCount = qMin(block.columnCount(), resultColumnCount);
+    itemList.reserve(colCount);
+
+    // RowId is the same for all columns of the same table, so it's resolved once per table
+    // and all items of the table share the same (implicitly shared) hash.
+    QHash<AliasedTable,RowId> rowIdsForTables;
+    for (int colIdx = 0; colIdx < colCount; colIdx++)
     {
+        const AliasedTable& table = tablesForColumns[colIdx];
+        if (!rowIdsForTables.contains(table))
+            rowIdsForTables[table] = getRowIdValue(block, row, colIdx);
+
         item = new SqlQueryItem();
-        rowId = getRowIdValue(row, colIdx);
-        updateItem(item, value, colIdx, rowId);
+        updateItem(item, block.value(row, colIdx), colIdx, rowIdsForTables[table]);
         itemList << item;
-        colIdx++;
     }
 
     return itemList;
 }
 
-RowId SqlQueryModel::getRowIdValue(SqlResultsRowPtr row, int columnIdx)
+RowId SqlQueryModel::getRowIdValue(const SqlResultsBlock& block, int row, int columnIdx)
 {
     RowId rowId;
     AliasedTable table = tablesForColumns[columnIdx];
     QHash<QString,QString> rowIdColumns = tableToRowIdColumn[table];
     QHashIterator<QString,QString> it(rowIdColumns);
+    SqlResultsColumnsPtr resultsColumns = block.getColumns();
     QString col;
+    int valueIdx;
     while (it.hasNext())
     {
         // Check if the result row contains QueryExecutor's column alias for this RowId column
         col = it.next().key();
-        if (row->contains(col))
+        valueIdx = resultsColumns ? resultsColumns->indexOf(col) : -1;
+        if (valueIdx > -1)
         {
             // It does, do let's put the actual column name into the RowId and assign the RowId value to it.
             // Using the actucal column name as a key will let create a proper query for updates, etc, later on.
-            rowId[it.value()] = row->value(col);
+            rowId[it.value()] = block.value(row, valueIdx);
         }
         else if (columnEditionStatus[columnIdx])
         {
@@ -1236,10 +1265,17 @@ void SqlQueryModel::resultsCountingFinished(quint64 rowsAffected, quint64 rowsRe
 
     this->rowsAffected = rowsAffected;
     this->totalRowsReturned = rowsReturned;
+    this->totalRowsAccuracy = queryExecutor->getRowCountAccuracy();
     this->totalPages = (int)qCeil(((double)totalRowsReturned) / ((double)getRowsPerPage()));
-    detachDatabases();
+
+    // Progressive row counting reports partial totals and still needs attached databases for the next round
+    bool countingFinished = !queryExecutor->isRowCountingInProgress();
+    if (countingFinished)
+        detachDatabases();
+
     emit totalRowsAndPagesAvailable();
-    emit storeExecutionInHistory();
+    if (countingFinished)
+        emit storeExecutionInHistory();
 }
 
 void SqlQueryModel::itemValueEdited(SqlQueryItem* item)
@@ -1364,6 +1400,7 @@ void SqlQueryModel::storeStep1NumbersFromExecution()
         if (!queryExecutor->isRowCountingRequired())
             totalRowsReturned = queryExecutor->getTotalRowsReturned();
 
+        totalRowsAccuracy = QueryExecutor::RowCountAccuracy::EXACT;
         totalPages = (int)qCeil(((double)totalRowsReturned) / ((double)getRowsPerPage()));
     }
 }
@@ -1539,6 +1576,8 @@ QString SqlQueryModel::getDatabaseForCommit(const QString& database)
 void SqlQueryModel::recalculateRowsAndPages(int rowsDelta)
 {
     totalRowsReturned += rowsDelta;
+    if (rowsDelta != 0)
+        queryExecutor->clearPageSeekKeys(); // page boundaries have moved
 
     int rowsPerPage = getRowsPerPage();
     totalPages = (int)qCeil(((double)totalRowsReturned) / ((double)rowsPerPage));
@@ -47,6 +47,7 @@ class GUI_API_EXPORT SqlQueryModel : public QStandardItemModel
         void setDb(Db* value);
         qint64 getExecutionTime();
         qint64 getTotalRowsReturned();
+        QueryExecutor::RowCountAccuracy getTotalRowsAccuracy() const;
         qint64 getTotalRowsAffected();
         qint64 getTotalPages();
         QList<SqlQueryModelColumnPtr> getColumns();
@@ -284,6 +285,18 @@ class GUI_API_EXPORT SqlQueryModel : public QStandardItemModel
          */
         static const int cellDataLengthLimit = 100;
 
+        /**
+         * @brief Interval (in milliseconds) of processing application events while loading data.
+         */
+        static const int eventsProcessingInterval = 100;
+
+        /**
+         * @brief Maximum number of rows read from the results at once while loading data.
+         *
+         * Application events are processed between batches, so it shouldn't be too big.
+         */
+        static const int rowsPerLoadBatch = 100;
+
     private:
         struct TableDetails
         {
@@ -304,8 +317,8 @@ class GUI_API_EXPORT SqlQueryModel : public QStandardItemModel
          */
         bool loadData(SqlQueryPtr results);
 
-        QList<QStandardItem*> loadRow(SqlResultsRowPtr row);
-        RowId getRowIdValue(SqlResultsRowPtr row, int columnIdx);
+        QList<QStandardItem*> loadRow(const SqlResultsBlock& block, int row);
+        RowId getRowIdValue(const SqlResultsBlock& block, int row, int columnIdx);
         void readColumns();
         void readColumnDetails();
         void updateColumnsHeader();
@@ -371,6 +384,12 @@ class GUI_API_EXPORT SqlQueryModel : public QStandardItemModel
          */
         quint64 totalRowsReturned = 0;
 
+        /**
+         * @brief totalRowsAccuracy
+         * Tells if totalRowsReturned is exact, or just estimated by the row counting mode of the database.
+         */
+        QueryExecutor::RowCountAccuracy totalRowsAccuracy = QueryExecutor::RowCountAccuracy::EXACT;
+
         /**
          * @brief rowsAffected
          * Keeps number of rows affected by recently successfully executed query.
@@ -11,6 +11,7 @@
 SqlTableModel::SqlTableModel(QObject *parent) :
     SqlQueryModel(parent)
 {
+    queryExecutor->setKeysetPaging(true);
 }
 
 QString SqlTableModel::getDatabase() const
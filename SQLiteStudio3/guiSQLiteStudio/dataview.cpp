@@ -640,7 +640,19 @@ void DataView::updateResultsCount(int resultsCount)
 {
     if (resultsCount >= 0)
     {
-        QString msg = QObject::tr("Total rows loaded: %1").arg(resultsCount);
+        QString msg;
+        switch (model->getTotalRowsAccuracy())
+        {
+            case QueryExecutor::RowCountAccuracy::EXACT:
+                msg = QObject::tr("Total rows loaded: %1").arg(resultsCount);
+                break;
+            case QueryExecutor::RowCountAccuracy::ESTIMATED:
+                msg = tr("Total rows (estimated): ~%1").arg(resultsCount);
+                break;
+            case QueryExecutor::RowCountAccuracy::AT_LEAST:
+                msg = tr("Total rows: at least %1").arg(resultsCount);
+                break;
+        }
         rowCountLabel->setText(msg);
         formViewRowCountLabel->setText(msg);
         rowCountLabel->setToolTip(QString());
@@ -107,6 +107,7 @@ void DbTree::init()
 
     treeModel = new DbTreeModel();
     treeModel->setTreeView(ui->treeView);
+    connect(treeModel, SIGNAL(schemaApplied(Db*)), this, SLOT(updateActionsForCurrent()));
 
     new UserInputFilter(ui->nameFilter, treeModel, SLOT(applyFilter(QString)));
 
@@ -1030,8 +1031,8 @@ void DbTree::refreshSchema(Db* db)
     if (!db->isOpen())
         return;
 
+    // Actions are updated once the schema is loaded and applied
     treeModel->refreshSchema(db);
-    updateActionsForCurrent();
 }
 
 void DbTree::copy()
@@ -1733,8 +1734,6 @@ void DbTree::refreshSchemas()
 {
     for (Db* db : DBLIST->getDbList())
         treeModel->refreshSchema(db);
-
-    updateActionsForCurrent();
 }
 
 void DbTree::interrupt()
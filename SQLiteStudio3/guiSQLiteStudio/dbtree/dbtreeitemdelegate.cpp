@@ -113,9 +113,11 @@ void DbTreeItemDelegate::paintTableLabel(QPainter* painter, const QStyleOptionVi
     if (!CFG_UI.General.ShowRegularTableLabels.get())
         return;
 
-    int columnsCount = item->child(0)->rowCount();
-    int indexesCount = item->child(1)->rowCount();
-    int triggersCount = item->child(2)->rowCount();
+    // Child items are created when the table is expanded, so counts are taken from the model
+    DbTreeModel* model = DBTREE->getModel();
+    int columnsCount = model->getChildObjectNames(item, DbTreeItem::Type::COLUMN).size();
+    int indexesCount = model->getChildObjectNames(item, DbTreeItem::Type::INDEX).size();
+    int triggersCount = model->getChildObjectNames(item, DbTreeItem::Type::TRIGGER).size();
     paintLabel(painter, option, index, item, QString("(%1, %2, %3)").arg(columnsCount).arg(indexesCount).arg(triggersCount));
 }
 
@@ -23,6 +23,8 @@
 #include <QCheckBox>
 #include <QWidgetAction>
 #include <QClipboard>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 const QString DbTreeModel::toolTipTableTmp = "<table>%1</table>";
 const QString DbTreeModel::toolTipHdrRowTmp = "<tr><th><img src=\"%1\"/></th><th colspan=2>%2</th></tr>";
@@ -46,6 +48,8 @@ DbTreeModel::DbTreeModel()
 
 DbTreeModel::~DbTreeModel()
 {
+    for (Db* db : schemaLoaders.keys())
+        waitForSchemaLoader(db);
 }
 
 void DbTreeModel::connectDbManagerSignals()
@@ -137,16 +141,18 @@ bool DbTreeModel::applyFilter(QStandardItem *parentItem, const QString &filter)
     bool empty = filter.isEmpty();
     bool visibilityForParent = false;
     DbTreeItem* item = nullptr;
-    QModelIndex index;
+    QModelIndex parentIndex = parentItem->index();
     bool subFilterResult;
     bool matched;
     for (int i = 0; i < parentItem->rowCount(); i++)
     {
          item = dynamic_cast<DbTreeItem*>(parentItem->child(i));
-         index = item->index();
          subFilterResult = applyFilter(item, filter);
-         matched = empty || subFilterResult || item->text().contains(filter, Qt::CaseInsensitive);
-         treeView->setRowHidden(index.row(), index.parent(), !matched);
+         matched = empty || subFilterResult || matchesFilter(item, filter);
+
+         // Changing hidden state makes the view to relayout, so it's done only when the state really changes
+         if (treeView->isRowHidden(i, parentIndex) == matched)
+             treeView->setRowHidden(i, parentIndex, !matched);
 
          if (matched)
              visibilityForParent = true;
@@ -154,6 +160,18 @@ bool DbTreeModel::applyFilter(QStandardItem *parentItem, const QString &filter)
     return visibilityForParent;
 }
 
+bool DbTreeModel::matchesFilter(DbTreeItem* item, const QString& filter) const
+{
+    if (item->text().contains(filter, Qt::CaseInsensitive))
+        return true;
+
+    // Child items of tables and views are created on demand, so their names are checked in the schema index
+    if (!isLazyItem(item))
+        return false;
+
+    return schemas.constFind(item->getDb()).value().childNamesIndex.value(item->text()).contains(filter, Qt::CaseInsensitive);
+}
+
 void DbTreeModel::storeGroups()
 {
     QList<Config::DbGroupPtr> groups = childsToConfig(invisibleRootItem());
@@ -274,6 +292,10 @@ void DbTreeModel::restoreGroup(const Config::DbGroupPtr& group, QList<Db*>* dbLi
 
 void DbTreeModel::expanded(const QModelIndex &index)
 {
+    // The view doesn't fetch child items when it expands the item before its layout was done
+    if (canFetchMore(index))
+        fetchMore(index);
+
     QStandardItem* item = itemFromIndex(index);
     if (!item->hasChildren())
     {
@@ -315,6 +337,7 @@ void DbTreeModel::dbUpdated(const QString& oldName, Db* db)
 
 void DbTreeModel::dbRemoved(Db* db)
 {
+    waitForSchemaLoader(db);
     dbRemoved(db->getName());
 }
 
@@ -353,8 +376,7 @@ void DbTreeModel::refreshSchema(Db* db)
         qWarning() << "Refreshing schema of db that couldn't be found in the model:" << db->getName();
         return;
     }
-    refreshSchema(db, item);
-    applyFilter(item, currentFilter);
+    loadSchema(db);
 }
 
 QList<DbTreeItem*> DbTreeModel::getAllItemsAsFlatList() const
@@ -448,25 +470,13 @@ QString DbTreeModel::getTableToolTip(DbTreeItem* item) const
 
     rows << toolTipHdrRowTmp.arg(ICONS.TABLE.getPath()).arg(tr("Table : %1", "dbtree tooltip").arg(item->text()));
 
-    QStandardItem* columnsItem = item->child(0);
-    QStandardItem* indexesItem = item->child(1);
-    QStandardItem* triggersItem = item->child(2);
-
-    int columnCnt = columnsItem->rowCount();
-    int indexesCount = indexesItem->rowCount();
-    int triggersCount = triggersItem->rowCount();
-
-    QStringList columns;
-    for (int i = 0; i < columnCnt; i++)
-        columns << columnsItem->child(i)->text();
-
-    QStringList indexes;
-    for (int i = 0; i < indexesCount; i++)
-        indexes << indexesItem->child(i)->text();
-
-    QStringList triggers;
-    for (int i = 0; i < triggersCount; i++)
-        triggers << triggersItem->child(i)->text();
+    // Child items might not be created yet, so names are taken from the schema
+    QStringList columns = getChildObjectNames(item, DbTreeItem::Type::COLUMN);
+    QStringList indexes = getChildObjectNames(item, DbTreeItem::Type::INDEX);
+    QStringList triggers = getChildObjectNames(item, DbTreeItem::Type::TRIGGER);
+    int columnCnt = columns.size();
+    int indexesCount = indexes.size();
+    int triggersCount = triggers.size();
 
     rows << toolTipIconRowTmp.arg(ICONS.COLUMN.getPath())
                              .arg(tr("Columns (%1):", "dbtree tooltip").arg(columnCnt))
@@ -481,204 +491,330 @@ QString DbTreeModel::getTableToolTip(DbTreeItem* item) const
     return toolTipTableTmp.arg(rows.join(""));
 }
 
-void DbTreeModel::refreshSchema(Db* db, QStandardItem *item)
+void DbTreeModel::loadSchema(Db* db)
 {
     if (!db->isOpen())
         return;
 
-    // Remember expanded state of this branch
-    QHash<QString, bool> expandedState;
-    collectExpandedState(expandedState, item);
-
-    // Delete child nodes
-    while (item->rowCount() > 0)
-        item->removeRow(0);
+    if (schemaLoaders.contains(db))
+    {
+        // Schema might have changed after the loader has read it, so it will be read again once the loader finishes.
+        schemaReloadPending << db;
+        return;
+    }
 
-    // Now prepare to create new branch
-    SchemaResolver resolver(db);
-    resolver.setIgnoreSystemObjects(!CFG_UI.General.ShowSystemObjects.get());
+    bool showSystemObjects = CFG_UI.General.ShowSystemObjects.get();
+    bool sortObjects = CFG_UI.General.SortObjects.get();
+    bool sortColumns = CFG_UI.General.SortColumns.get();
 
-    // Collect all db objects and build the db branch
-    bool sort = CFG_UI.General.SortObjects.get();
-    QStringList tables = resolver.getTables();
-    QStringList virtualTables;
-    for (const QString& table : tables)
+    QFutureWatcher<SchemaSnapshot>* watcher = new QFutureWatcher<SchemaSnapshot>();
+    schemaLoaders[db] = watcher;
+    connect(watcher, &QFutureWatcher<SchemaSnapshot>::finished, [this, db, watcher]()
     {
-        if (resolver.isVirtualTable(table))
-            virtualTables << table;
-    }
+        schemaLoaders.remove(db);
+        watcher->deleteLater();
+        applySchema(db, watcher->result());
 
-    QList<QStandardItem*> tableItems = refreshSchemaTables(tables, virtualTables, sort);
-    StrHash<QList<QStandardItem*>> allTableColumns = refreshSchemaTableColumns(resolver.getAllTableColumns());
-    StrHash<QList<QStandardItem*>> indexItems = refreshSchemaIndexes(resolver.getGroupedIndexes(), sort);
-    StrHash<QList<QStandardItem*>> triggerItems = refreshSchemaTriggers(resolver.getGroupedTriggers(), sort);
-    QList<QStandardItem*> viewItems = refreshSchemaViews(resolver.getViews(), sort);
-    refreshSchemaBuild(item, tableItems, indexItems, triggerItems, viewItems, allTableColumns);
-    populateChildItemsWithDb(item, db);
-    restoreExpandedState(expandedState, item);
+        if (schemaReloadPending.remove(db))
+            loadSchema(db);
+    });
+    watcher->setFuture(QtConcurrent::run(&DbTreeModel::readSchema, db, showSystemObjects, sortObjects, sortColumns));
 }
 
-void DbTreeModel::collectExpandedState(QHash<QString, bool> &state, QStandardItem *parentItem)
+void DbTreeModel::waitForSchemaLoader(Db* db)
 {
-    if (!parentItem)
-        parentItem = root();
-
-    DbTreeItem* dbTreeItem = dynamic_cast<DbTreeItem*>(parentItem);
-    if (dbTreeItem)
-        state[dbTreeItem->signature()] = treeView->isExpanded(dbTreeItem->index());
+    schemaReloadPending.remove(db);
+    expandAfterLoad.remove(db);
+    schemas.remove(db);
+    if (!schemaLoaders.contains(db))
+        return;
 
-    for (int i = 0; i < parentItem->rowCount(); i++)
-        collectExpandedState(state, parentItem->child(i));
+    // Deleting the watcher drops its pending "finished" notification, so the results are not applied.
+    QFutureWatcher<SchemaSnapshot>* watcher = schemaLoaders.take(db);
+    watcher->waitForFinished();
+    delete watcher;
 }
 
-QList<QStandardItem *> DbTreeModel::refreshSchemaTables(const QStringList &tables, const QStringList& virtualTables, bool sort)
+DbTreeModel::SchemaSnapshot DbTreeModel::readSchema(Db* db, bool showSystemObjects, bool sortObjects, bool sortColumns)
 {
-    QStringList sortedTables = tables;
-    if (sort)
-        sortedTables.sort(Qt::CaseInsensitive);
+    SchemaSnapshot schema;
+    SchemaResolver resolver(db);
+    resolver.setIgnoreSystemObjects(!showSystemObjects);
 
-    QList<QStandardItem *> items;
-    for (const QString& table : sortedTables)
+    schema.tables = resolver.getTables();
+    for (const QString& table : schema.tables)
     {
-        if (virtualTables.contains(table))
-            items += DbTreeItemFactory::createVirtualTable(table, this);
-        else
-            items += DbTreeItemFactory::createTable(table, this);
+        if (resolver.isVirtualTable(table))
+            schema.virtualTables << table;
     }
 
-    return items;
-}
+    schema.views = resolver.getViews();
+    schema.tableColumns = resolver.getAllTableColumns();
+    schema.indexes = resolver.getGroupedIndexes();
+    schema.triggers = resolver.getGroupedTriggers();
 
-StrHash<QList<QStandardItem*>> DbTreeModel::refreshSchemaTableColumns(const StrHash<QStringList> &columns)
-{
-    QStringList sortedColumns;
-    bool sort = CFG_UI.General.SortColumns.get();
-    StrHash<QList<QStandardItem*>> items;
-    for (const QString& key : columns.keys())
+    if (sortObjects)
     {
-        sortedColumns = columns[key];
-        if (sort)
-            qSort(sortedColumns);
+        schema.tables.sort(Qt::CaseInsensitive);
+        schema.views.sort(Qt::CaseInsensitive);
+        for (const QString& table : schema.indexes.keys())
+            schema.indexes[table].sort(Qt::CaseInsensitive);
 
-        for (const QString& column : sortedColumns)
-            items[key] += DbTreeItemFactory::createColumn(column, this);
+        for (const QString& object : schema.triggers.keys())
+            schema.triggers[object].sort(Qt::CaseInsensitive);
     }
-    return items;
-}
 
-StrHash<QList<QStandardItem *> > DbTreeModel::refreshSchemaIndexes(const StrHash<QStringList> &indexes, bool sort)
-{
-    StrHash<QList<QStandardItem *> > items;
-    QStringList sortedIndexes;
-    for (const QString& key : indexes.keys())
+    if (sortColumns)
     {
-        sortedIndexes = indexes[key];
-        if (sort)
-            sortedIndexes.sort(Qt::CaseInsensitive);
+        for (const QString& table : schema.tableColumns.keys())
+            schema.tableColumns[table].sort();
+    }
 
-        for (const QString& index : sortedIndexes)
-            items[key] += DbTreeItemFactory::createIndex(index, this);
+    for (const QString& table : schema.tables)
+    {
+        schema.childNamesIndex[table] = (schema.tableColumns.value(table, Qt::CaseInsensitive) +
+                                         schema.indexes.value(table, Qt::CaseInsensitive) +
+                                         schema.triggers.value(table, Qt::CaseInsensitive)).join("\n");
     }
-    return items;
+
+    for (const QString& view : schema.views)
+        schema.childNamesIndex[view] = schema.triggers.value(view, Qt::CaseInsensitive).join("\n");
+
+    return schema;
 }
 
-StrHash<QList<QStandardItem*>> DbTreeModel::refreshSchemaTriggers(const StrHash<QStringList> &triggers, bool sort)
+void DbTreeModel::applySchema(Db* db, const SchemaSnapshot& schema)
 {
-    StrHash<QList<QStandardItem*>> items;
-    QStringList sortedTriggers;
-    for (const QString& key : triggers.keys())
+    DbTreeItem* dbItem = findItem(DbTreeItem::Type::DB, db);
+    if (!dbItem || !db->isOpen())
+        return;
+
+    schemas[db] = schema;
+
+    DbTreeItem* tablesItem = findChildItem(dbItem, DbTreeItem::Type::TABLES);
+    DbTreeItem* viewsItem = findChildItem(dbItem, DbTreeItem::Type::VIEWS);
+    if (!tablesItem || !viewsItem)
     {
-        sortedTriggers = triggers[key];
-        if (sort)
-            sortedTriggers.sort(Qt::CaseInsensitive);
+        while (dbItem->rowCount() > 0)
+            dbItem->removeRow(0);
+
+        tablesItem = DbTreeItemFactory::createTables(this);
+        viewsItem = DbTreeItemFactory::createViews(this);
+        tablesItem->setDb(db);
+        viewsItem->setDb(db);
+        dbItem->appendRow(tablesItem);
+        dbItem->appendRow(viewsItem);
+    }
+
+    // Only differences between the current items and the new schema are applied, so the expanded state
+    // and selection of items that still exist are preserved.
+    QList<DbTreeItem::Type> tableTypes;
+    for (const QString& table : schema.tables)
+        tableTypes << (schema.virtualTables.contains(table) ? DbTreeItem::Type::VIRTUAL_TABLE : DbTreeItem::Type::TABLE);
+
+    QList<DbTreeItem::Type> viewTypes;
+    for (int i = 0; i < schema.views.size(); i++)
+        viewTypes << DbTreeItem::Type::VIEW;
+
+    syncChildItems(tablesItem, schema.tables, tableTypes, db);
+    syncChildItems(viewsItem, schema.views, viewTypes, db);
 
-        for (const QString& trigger : sortedTriggers)
-            items[key] += DbTreeItemFactory::createTrigger(trigger, this);
+    // Items that were expanded at least once have their child items already, so these are refreshed as well.
+    for (QStandardItem* objectsItem : {tablesItem, viewsItem})
+    {
+        for (int i = 0; i < objectsItem->rowCount(); i++)
+        {
+            DbTreeItem* objectItem = dynamic_cast<DbTreeItem*>(objectsItem->child(i));
+            if (objectItem->rowCount() > 0)
+                refreshObjectChildren(objectItem, schema);
+        }
     }
-    return items;
-}
 
-QList<QStandardItem *> DbTreeModel::refreshSchemaViews(const QStringList &views, bool sort)
-{
-    QStringList sortedViews = views;
-    if (sort)
-        sortedViews.sort(Qt::CaseInsensitive);
+    applyFilter(dbItem, currentFilter);
 
-    QList<QStandardItem *> items;
-    for (const QString& view : sortedViews)
-        items += DbTreeItemFactory::createView(view, this);
+    if (expandAfterLoad.remove(db))
+    {
+        treeView->expand(dbItem->index());
+        if (CFG_UI.General.ExpandTables.get())
+            treeView->expand(tablesItem->index());
 
-    return items;
+        if (CFG_UI.General.ExpandViews.get())
+            treeView->expand(viewsItem->index());
+    }
+
+    emit schemaApplied(db);
 }
 
-void DbTreeModel::populateChildItemsWithDb(QStandardItem *parentItem, Db* db)
+void DbTreeModel::refreshObjectChildren(DbTreeItem* objectItem, const SchemaSnapshot& schema)
 {
-    QStandardItem* childItem = nullptr;
-    for (int i = 0; i < parentItem->rowCount(); i++)
+    Db* db = objectItem->getDb();
+    QString name = objectItem->text();
+    DbTreeItem* groupItem = nullptr;
+    QStringList names;
+    static const QList<QPair<DbTreeItem::Type, DbTreeItem::Type>> groupTypes = {
+        {DbTreeItem::Type::COLUMNS, DbTreeItem::Type::COLUMN},
+        {DbTreeItem::Type::INDEXES, DbTreeItem::Type::INDEX},
+        {DbTreeItem::Type::TRIGGERS, DbTreeItem::Type::TRIGGER}
+    };
+    for (const QPair<DbTreeItem::Type, DbTreeItem::Type>& groupType : groupTypes)
     {
-        childItem = parentItem->child(i);
-        dynamic_cast<DbTreeItem*>(childItem)->setDb(db);
-        populateChildItemsWithDb(childItem, db);
+        groupItem = findChildItem(objectItem, groupType.first);
+        if (!groupItem)
+            continue;
+
+        switch (groupType.second)
+        {
+            case DbTreeItem::Type::COLUMN:
+                names = schema.tableColumns.value(name, Qt::CaseInsensitive);
+                break;
+            case DbTreeItem::Type::INDEX:
+                names = schema.indexes.value(name, Qt::CaseInsensitive);
+                break;
+            default:
+                names = schema.triggers.value(name, Qt::CaseInsensitive);
+                break;
+        }
+
+        QList<DbTreeItem::Type> types;
+        for (int i = 0; i < names.size(); i++)
+            types << groupType.second;
+
+        syncChildItems(groupItem, names, types, db);
     }
 }
 
-void DbTreeModel::refreshSchemaBuild(QStandardItem *dbItem,
-                                     QList<QStandardItem*> tables,
-                                     StrHash<QList<QStandardItem*> > indexes,
-                                     StrHash<QList<QStandardItem*> > triggers,
-                                     QList<QStandardItem*> views,
-                                     StrHash<QList<QStandardItem*> > allTableColumns)
+void DbTreeModel::fetchObjectChildren(DbTreeItem* objectItem)
 {
-    DbTreeItem* tablesItem = DbTreeItemFactory::createTables(this);
-    DbTreeItem* viewsItem = DbTreeItemFactory::createViews(this);
+    Db* db = objectItem->getDb();
+    if (!db || !schemas.contains(db))
+        return;
 
-    dbItem->appendRow(tablesItem);
-    dbItem->appendRow(viewsItem);
+    const SchemaSnapshot& schema = schemas[db];
+    QList<QStandardItem*> groupItems;
+    DbTreeItem* groupItem = nullptr;
+    if (objectItem->getType() != DbTreeItem::Type::VIEW)
+    {
+        groupItem = DbTreeItemFactory::createColumns(this);
+        groupItem->setDb(db);
+        groupItems << groupItem;
 
-    DbTreeItem* columnsItem = nullptr;
-    DbTreeItem* indexesItem = nullptr;
-    DbTreeItem* triggersItem = nullptr;
-    for (QStandardItem* tableItem : tables)
+        groupItem = DbTreeItemFactory::createIndexes(this);
+        groupItem->setDb(db);
+        groupItems << groupItem;
+    }
+
+    groupItem = DbTreeItemFactory::createTriggers(this);
+    groupItem->setDb(db);
+    groupItems << groupItem;
+
+    objectItem->appendRows(groupItems);
+    refreshObjectChildren(objectItem, schema);
+}
+
+void DbTreeModel::syncChildItems(QStandardItem* parentItem, const QStringList& names, const QList<DbTreeItem::Type>& types, Db* db)
+{
+    if (parentItem->rowCount() == 0)
     {
-        tablesItem->appendRow(tableItem);
+        QList<QStandardItem*> items;
+        for (int i = 0; i < names.size(); i++)
+            items << createObjectItem(types[i], names[i], db);
 
-        columnsItem = DbTreeItemFactory::createColumns(this);
-        indexesItem = DbTreeItemFactory::createIndexes(this);
-        triggersItem = DbTreeItemFactory::createTriggers(this);
+        parentItem->appendRows(items);
+        return;
+    }
 
-        tableItem->appendRow(columnsItem);
-        tableItem->appendRow(indexesItem);
-        tableItem->appendRow(triggersItem);
+    QHash<QString, DbTreeItem::Type> expectedTypes;
+    for (int i = 0; i < names.size(); i++)
+        expectedTypes[names[i]] = types[i];
 
-        for (QStandardItem* columnItem : allTableColumns[tableItem->text()])
-            columnsItem->appendRow(columnItem);
+    // Remove items of objects that no longer exist (or changed their type)
+    QHash<QString, DbTreeItem*> existingItems;
+    DbTreeItem* item = nullptr;
+    for (int row = parentItem->rowCount() - 1; row >= 0; row--)
+    {
+        item = dynamic_cast<DbTreeItem*>(parentItem->child(row));
+        if (!expectedTypes.contains(item->text()) || expectedTypes[item->text()] != item->getType())
+        {
+            parentItem->removeRow(row);
+            continue;
+        }
+        existingItems[item->text()] = item;
+    }
 
-        for (QStandardItem* indexItem : indexes[tableItem->text()])
-            indexesItem->appendRow(indexItem);
+    // Add new items and move existing ones, so they follow the order of names
+    for (int i = 0; i < names.size(); i++)
+    {
+        item = existingItems.value(names[i]);
+        if (item && item->row() == i)
+            continue;
 
-        for (QStandardItem* triggerItem : triggers[tableItem->text()])
-            triggersItem->appendRow(triggerItem);
+        if (item)
+            parentItem->insertRow(i, parentItem->takeRow(item->row()));
+        else
+            parentItem->insertRow(i, createObjectItem(types[i], names[i], db));
     }
-    for (QStandardItem* viewItem : views)
+}
+
+DbTreeItem* DbTreeModel::createObjectItem(DbTreeItem::Type type, const QString& name, Db* db)
+{
+    DbTreeItem* item = nullptr;
+    switch (type)
     {
-        viewsItem->appendRow(viewItem);
+        case DbTreeItem::Type::TABLE:
+            item = DbTreeItemFactory::createTable(name, this);
+            break;
+        case DbTreeItem::Type::VIRTUAL_TABLE:
+            item = DbTreeItemFactory::createVirtualTable(name, this);
+            break;
+        case DbTreeItem::Type::VIEW:
+            item = DbTreeItemFactory::createView(name, this);
+            break;
+        case DbTreeItem::Type::COLUMN:
+            item = DbTreeItemFactory::createColumn(name, this);
+            break;
+        case DbTreeItem::Type::INDEX:
+            item = DbTreeItemFactory::createIndex(name, this);
+            break;
+        case DbTreeItem::Type::TRIGGER:
+            item = DbTreeItemFactory::createTrigger(name, this);
+            break;
+        default:
+            qCritical() << "Unsupported db object type in DbTreeModel::createObjectItem():" << static_cast<int>(type);
+            return nullptr;
+    }
+    item->setDb(db);
+    return item;
+}
 
-        triggersItem = DbTreeItemFactory::createTriggers(this);
-        viewItem->appendRow(triggersItem);
-        for (QStandardItem* triggerItem : triggers[viewItem->text()])
-            triggersItem->appendRow(triggerItem);
+DbTreeItem* DbTreeModel::findChildItem(QStandardItem* parentItem, DbTreeItem::Type type) const
+{
+    DbTreeItem* item = nullptr;
+    for (int i = 0; i < parentItem->rowCount(); i++)
+    {
+        item = dynamic_cast<DbTreeItem*>(parentItem->child(i));
+        if (item->getType() == type)
+            return item;
     }
+    return nullptr;
 }
 
-void DbTreeModel::restoreExpandedState(const QHash<QString, bool>& expandedState, QStandardItem* parentItem)
+bool DbTreeModel::isLazyItem(DbTreeItem* item) const
 {
-    DbTreeItem* parentDbTreeItem = dynamic_cast<DbTreeItem*>(parentItem);
-    QString sig = parentDbTreeItem->signature();
-    if (expandedState.contains(sig) && expandedState[sig])
-        treeView->expand(parentItem->index());
+    switch (item->getType())
+    {
+        case DbTreeItem::Type::TABLE:
+        case DbTreeItem::Type::VIRTUAL_TABLE:
+        case DbTreeItem::Type::VIEW:
+            break;
+        default:
+            return false;
+    }
+
+    if (item->rowCount() > 0)
+        return false;
 
-    for (QStandardItem* child : parentDbTreeItem->childs())
-        restoreExpandedState(expandedState, child);
+    Db* db = item->getDb();
+    return db && schemas.contains(db);
 }
 
 void DbTreeModel::dbConnected(Db* db)
@@ -689,17 +825,15 @@ void DbTreeModel::dbConnected(Db* db)
         qWarning() << "Connected to db that couldn't be found in the model:" << db->getName();
         return;
     }
-    refreshSchema(db, item);
-    treeView->expand(item->index());
-    if (CFG_UI.General.ExpandTables.get())
-        treeView->expand(item->index().child(0, 0)); // also expand tables
 
-    if (CFG_UI.General.ExpandViews.get())
-        treeView->expand(item->index().child(1, 0)); // also expand views
+    // Items get expanded once the schema is loaded
+    expandAfterLoad << db;
+    loadSchema(db);
 }
 
 void DbTreeModel::dbDisconnected(Db* db)
 {
+    waitForSchemaLoader(db);
     QStandardItem* item = findItem(DbTreeItem::Type::DB, db);
     if (!item)
     {
@@ -810,6 +944,11 @@ DbTreeItem *DbTreeModel::findItemBySignature(const QString &signature)
         pair = part.split(".");
         type = static_cast<DbTreeItem::Type>(pair.first().toInt());
         name = QString::fromUtf8(QByteArray::fromBase64(pair.last().toLatin1()));
+
+        // The path may go through a table or view that was not expanded yet
+        if (currItem && canFetchMore(currItem->index()))
+            fetchMore(currItem->index());
+
         currItem = findItem((currItem ? currItem : root()), type, name);
         if (!currItem)
             return nullptr; // not found the target item
@@ -817,6 +956,52 @@ DbTreeItem *DbTreeModel::findItemBySignature(const QString &signature)
     return currItem;
 }
 
+DbTreeItem* DbTreeModel::findOwnerItem(DbTreeItem::Type type, const QString& name)
+{
+    if (type != DbTreeItem::Type::INDEX && type != DbTreeItem::Type::TRIGGER)
+        return nullptr;
+
+    DbTreeItem* dbItem = nullptr;
+    DbTreeItem* objectsItem = nullptr;
+    DbTreeItem* objectItem = nullptr;
+    QString ownerName;
+    for (Db* db : schemas.keys())
+    {
+        const StrHash<QStringList>& objects = (type == DbTreeItem::Type::INDEX) ? schemas[db].indexes : schemas[db].triggers;
+        ownerName = QString();
+        for (const QString& object : objects.keys())
+        {
+            if (objects.value(object).contains(name))
+            {
+                ownerName = object;
+                break;
+            }
+        }
+
+        if (ownerName.isNull())
+            continue;
+
+        dbItem = findItem(DbTreeItem::Type::DB, db);
+        if (!dbItem)
+            continue;
+
+        for (DbTreeItem::Type objectsType : {DbTreeItem::Type::TABLES, DbTreeItem::Type::VIEWS})
+        {
+            objectsItem = findChildItem(dbItem, objectsType);
+            if (!objectsItem)
+                continue;
+
+            for (int i = 0; i < objectsItem->rowCount(); i++)
+            {
+                objectItem = dynamic_cast<DbTreeItem*>(objectsItem->child(i));
+                if (objectItem->text().compare(ownerName, Qt::CaseInsensitive) == 0)
+                    return objectItem;
+            }
+        }
+    }
+    return nullptr;
+}
+
 QList<DbTreeItem*> DbTreeModel::findItems(DbTreeItem::Type type)
 {
     return findItems(root(), type);
@@ -1021,6 +1206,75 @@ QList<DbTreeItem*> DbTreeModel::getItemsForIndexes(const QModelIndexList& indexe
     return items;
 }
 
+bool DbTreeModel::hasChildren(const QModelIndex& parent) const
+{
+    if (canFetchMore(parent))
+        return true;
+
+    return QStandardItemModel::hasChildren(parent);
+}
+
+bool DbTreeModel::canFetchMore(const QModelIndex& parent) const
+{
+    if (!parent.isValid())
+        return false;
+
+    DbTreeItem* item = dynamic_cast<DbTreeItem*>(itemFromIndex(parent));
+    return item && isLazyItem(item);
+}
+
+void DbTreeModel::fetchMore(const QModelIndex& parent)
+{
+    DbTreeItem* item = dynamic_cast<DbTreeItem*>(itemFromIndex(parent));
+    if (!item || !isLazyItem(item))
+        return;
+
+    fetchObjectChildren(item);
+    applyFilter(item, currentFilter);
+}
+
+void DbTreeModel::fetchAll(const QString& dbName)
+{
+    DbTreeItem* dbItem = findItem(DbTreeItem::Type::DB, dbName);
+    if (!dbItem)
+        return;
+
+    DbTreeItem* objectItem = nullptr;
+    for (DbTreeItem::Type type : {DbTreeItem::Type::TABLES, DbTreeItem::Type::VIEWS})
+    {
+        QStandardItem* objectsItem = findChildItem(dbItem, type);
+        if (!objectsItem)
+            continue;
+
+        for (int i = 0; i < objectsItem->rowCount(); i++)
+        {
+            objectItem = dynamic_cast<DbTreeItem*>(objectsItem->child(i));
+            if (isLazyItem(objectItem))
+                fetchMore(objectItem->index());
+        }
+    }
+}
+
+QStringList DbTreeModel::getChildObjectNames(DbTreeItem* item, DbTreeItem::Type type) const
+{
+    QHash<Db*, SchemaSnapshot>::const_iterator it = schemas.constFind(item->getDb());
+    if (it == schemas.constEnd())
+        return QStringList();
+
+    switch (type)
+    {
+        case DbTreeItem::Type::COLUMN:
+            return it.value().tableColumns.value(item->text(), Qt::CaseInsensitive);
+        case DbTreeItem::Type::INDEX:
+            return it.value().indexes.value(item->text(), Qt::CaseInsensitive);
+        case DbTreeItem::Type::TRIGGER:
+            return it.value().triggers.value(item->text(), Qt::CaseInsensitive);
+        default:
+            break;
+    }
+    return QStringList();
+}
+
 void DbTreeModel::staticInit()
 {
 }
@@ -8,6 +8,10 @@
 #include "common/strhash.h"
 #include <QStandardItemModel>
 #include <QObject>
+#include <QSet>
+
+template <class T>
+class QFutureWatcher;
 
 class DbManager;
 class DbTreeView;
@@ -28,6 +32,17 @@ class GUI_API_EXPORT DbTreeModel : public QStandardItemModel
         DbTreeItem* findItem(DbTreeItem::Type type, const QString &name);
         DbTreeItem* findItem(DbTreeItem::Type type, Db* db);
         DbTreeItem* findItemBySignature(const QString& signature);
+
+        /**
+         * @brief Finds table or view item that owns given index or trigger.
+         * @param type Type of the owned object - INDEX or TRIGGER.
+         * @param name Name of the index or trigger.
+         * @return Table, virtual table or view item, or null if there is no such index or trigger.
+         *
+         * The owner is looked up in the most recently loaded schema, so it's found even if child items of the table
+         * or view were not created yet. To get the index or trigger item itself, call fetchMore() on the returned item first.
+         */
+        DbTreeItem* findOwnerItem(DbTreeItem::Type type, const QString& name);
         QList<DbTreeItem*> findItems(DbTreeItem::Type type);
         void move(QStandardItem* itemToMove, QStandardItem* newParentItem, int newRow = -1);
         void move(QStandardItem* itemToMove, int newRow);
@@ -52,6 +67,28 @@ class GUI_API_EXPORT DbTreeModel : public QStandardItemModel
         bool hasDbTreeItem(const QMimeData* data);
         QList<DbTreeItem*> getDragItems(const QMimeData* data);
         QList<DbTreeItem*> getItemsForIndexes(const QModelIndexList& indexes) const;
+        bool hasChildren(const QModelIndex& parent = QModelIndex()) const;
+        bool canFetchMore(const QModelIndex& parent) const;
+        void fetchMore(const QModelIndex& parent);
+
+        /**
+         * @brief Creates child items of all tables and views of the database.
+         * @param dbName Name of the database.
+         *
+         * Child items (columns, indexes and triggers) are normally created when the table or view is expanded.
+         * This method is for code that needs to go through all objects of the database, not only the expanded ones.
+         */
+        void fetchAll(const QString& dbName);
+
+        /**
+         * @brief Provides names of objects that belong to the table or view item.
+         * @param item Table, virtual table or view item.
+         * @param type Type of child objects - COLUMN, INDEX or TRIGGER.
+         * @return Names of child objects, as known from the most recently loaded schema.
+         *
+         * Works also for items which child items were not created yet.
+         */
+        QStringList getChildObjectNames(DbTreeItem* item, DbTreeItem::Type type) const;
 
         static DbTreeItem* findItem(QStandardItem *parentItem, DbTreeItem::Type type, const QString &name);
         static DbTreeItem* findItem(QStandardItem* parentItem, DbTreeItem::Type type, Db* db);
@@ -61,22 +98,38 @@ class GUI_API_EXPORT DbTreeModel : public QStandardItemModel
         static const constexpr char* MIMETYPE = "application/x-sqlitestudio-dbtreeitem";
 
     private:
+        /**
+         * @brief Names of database objects, read from the database in the background.
+         *
+         * All lists are already sorted according to the configuration.
+         * Child names index keeps names of all columns, indexes and triggers of given table or view,
+         * joined into a single string, so the name filter can check the object without its child items being created.
+         */
+        struct SchemaSnapshot
+        {
+            QStringList tables;
+            QSet<QString> virtualTables;
+            QStringList views;
+            StrHash<QStringList> tableColumns;
+            StrHash<QStringList> indexes;
+            StrHash<QStringList> triggers;
+            StrHash<QString> childNamesIndex;
+        };
+
         void readGroups(QList<Db*> dbList);
         QList<Config::DbGroupPtr> childsToConfig(QStandardItem* item);
         void restoreGroup(const Config::DbGroupPtr& group, QList<Db*>* dbList = nullptr, QStandardItem *parent = nullptr);
         bool applyFilter(QStandardItem* parentItem, const QString& filter);
-        void refreshSchema(Db* db, QStandardItem* item);
-        void collectExpandedState(QHash<QString, bool>& state, QStandardItem* parentItem = nullptr);
-        QStandardItem* refreshSchemaDb(Db* db);
-        QList<QStandardItem*> refreshSchemaTables(const QStringList &tables, const QStringList& virtualTables, bool sort);
-        StrHash<QList<QStandardItem*> > refreshSchemaTableColumns(const StrHash<QStringList>& columns);
-        StrHash<QList<QStandardItem*> > refreshSchemaIndexes(const StrHash<QStringList>& indexes, bool sort);
-        StrHash<QList<QStandardItem*> > refreshSchemaTriggers(const StrHash<QStringList>& triggers, bool sort);
-        QList<QStandardItem*> refreshSchemaViews(const QStringList &views, bool sort);
-        void populateChildItemsWithDb(QStandardItem* parentItem, Db* db);
-        void refreshSchemaBuild(QStandardItem* dbItem, QList<QStandardItem*> tables, StrHash<QList<QStandardItem*> > indexes,
-                                StrHash<QList<QStandardItem*> > triggers, QList<QStandardItem*> views, StrHash<QList<QStandardItem*> > allTableColumns);
-        void restoreExpandedState(const QHash<QString, bool>& expandedState, QStandardItem* parentItem);
+        bool matchesFilter(DbTreeItem* item, const QString& filter) const;
+        void loadSchema(Db* db);
+        void waitForSchemaLoader(Db* db);
+        void applySchema(Db* db, const SchemaSnapshot& schema);
+        void refreshObjectChildren(DbTreeItem* objectItem, const SchemaSnapshot& schema);
+        void fetchObjectChildren(DbTreeItem* objectItem);
+        void syncChildItems(QStandardItem* parentItem, const QStringList& names, const QList<DbTreeItem::Type>& types, Db* db);
+        DbTreeItem* createObjectItem(DbTreeItem::Type type, const QString& name, Db* db);
+        DbTreeItem* findChildItem(QStandardItem* parentItem, DbTreeItem::Type type) const;
+        bool isLazyItem(DbTreeItem* item) const;
         QString getToolTip(DbTreeItem *item) const;
         QString getDbToolTip(DbTreeItem *item) const;
         QString getTableToolTip(DbTreeItem *item) const;
@@ -88,6 +141,7 @@ class GUI_API_EXPORT DbTreeModel : public QStandardItemModel
         bool quickAddDroppedDb(const QString& filePath);
         void moveOrCopyDbObjects(const QList<DbTreeItem*>& srcItems, DbTreeItem* dstItem, bool move, bool includeData, bool includeIndexes, bool includeTriggers);
 
+        static SchemaSnapshot readSchema(Db* db, bool showSystemObjects, bool sortObjects, bool sortColumns);
         static bool confirmReferencedTables(const QStringList& tables);
         static bool resolveNameConflict(QString& nameInConflict);
         static bool confirmConversion(const QList<QPair<QString, QString>>& diffs);
@@ -104,6 +158,10 @@ class GUI_API_EXPORT DbTreeModel : public QStandardItemModel
         QList<Interruptable*> interruptables;
         bool ignoreDbLoadedSignal = false;
         QString currentFilter;
+        QHash<Db*, SchemaSnapshot> schemas;
+        QHash<Db*, QFutureWatcher<SchemaSnapshot>*> schemaLoaders;
+        QSet<Db*> schemaReloadPending;
+        QSet<Db*> expandAfterLoad;
 
     private slots:
         void expanded(const QModelIndex &index);
@@ -131,6 +189,14 @@ class GUI_API_EXPORT DbTreeModel : public QStandardItemModel
 
     signals:
         void updateItemHidden(DbTreeItem* item);
+
+        /**
+         * @brief Emitted when the schema read in the background was applied to the tree.
+         * @param db Database which schema was applied.
+         *
+         * Schema loading is asynchronous, so this is the point from which the tree reflects the current schema.
+         */
+        void schemaApplied(Db* db);
 };
 
 #endif // DBTREEMODEL_H
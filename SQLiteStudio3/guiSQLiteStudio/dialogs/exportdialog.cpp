@@ -30,6 +30,7 @@ static const QString EXPORT_DIALOG_CFG_CLIP = "intoClipboard";
 static const QString EXPORT_DIALOG_CFG_DATA = "exportData";
 static const QString EXPORT_DIALOG_CFG_IDX = "exportTableIndexes";
 static const QString EXPORT_DIALOG_CFG_TRIG = "exportTableTriggers";
+static const QString EXPORT_DIALOG_CFG_SNAPSHOT = "consistentSnapshot";
 static const QString EXPORT_DIALOG_CFG_FORMAT = "format";
 
 ExportDialog::ExportDialog(QWidget *parent) :
@@ -630,6 +631,7 @@ void ExportDialog::storeStdConfig(const ExportManager::StandardExportConfig &std
     CFG->set(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_DATA, stdConfig.exportData);
     CFG->set(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_IDX, stdConfig.exportTableIndexes);
     CFG->set(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_TRIG, stdConfig.exportTableTriggers);
+    CFG->set(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_SNAPSHOT, stdConfig.consistentSnapshot);
     CFG->set(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_FORMAT, currentPlugin->getFormatName());
     CFG->commit();
 }
@@ -637,10 +639,17 @@ void ExportDialog::storeStdConfig(const ExportManager::StandardExportConfig &std
 void ExportDialog::readStdConfigForFirstPage()
 {
     bool exportData = CFG->get(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_DATA, true).toBool();
+    bool snapshot = CFG->get(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_SNAPSHOT, false).toBool();
     if (exportMode == ExportManager::DATABASE)
+    {
         ui->exportDbDataCheck->setChecked(exportData);
+        ui->exportDbSnapshotCheck->setChecked(snapshot);
+    }
     else if (exportMode == ExportManager::TABLE)
+    {
         ui->exportTableDataCheck->setChecked(exportData);
+        ui->exportTableSnapshotCheck->setChecked(snapshot);
+    }
 
     ui->exportTableIndexesCheck->setChecked(CFG->get(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_IDX, true).toBool());
     ui->exportTableTriggersCheck->setChecked(CFG->get(EXPORT_DIALOG_CFG_GROUP, EXPORT_DIALOG_CFG_TRIG, true).toBool());
@@ -746,9 +755,15 @@ ExportManager::StandardExportConfig ExportDialog::getExportConfig() const
         stdConfig.outputFileName = ui->exportFileEdit->text();
 
     if (exportMode == ExportManager::DATABASE)
+    {
         stdConfig.exportData = ui->exportDbDataCheck->isChecked();
+        stdConfig.consistentSnapshot = ui->exportDbSnapshotCheck->isChecked();
+    }
     else if (exportMode == ExportManager::TABLE)
+    {
         stdConfig.exportData = ui->exportTableDataCheck->isChecked();
+        stdConfig.consistentSnapshot = ui->exportTableSnapshotCheck->isChecked();
+    }
     else
         stdConfig.exportData = false;
 
@@ -22,6 +22,8 @@ static const QString IMPORT_DIALOG_CFG_GROUP = "ImportDialog";
 static const QString IMPORT_DIALOG_CFG_CODEC = "codec";
 static const QString IMPORT_DIALOG_CFG_FILE = "inputFileName";
 static const QString IMPORT_DIALOG_CFG_IGNORE_ERR = "ignoreErrors";
+static const QString IMPORT_DIALOG_CFG_COMMIT_INTERVAL = "commitInterval";
+static const QString IMPORT_DIALOG_CFG_FAST_IMPORT = "fastImport";
 static const QString IMPORT_DIALOG_CFG_FORMAT = "format";
 
 ImportDialog::ImportDialog(QWidget *parent) :
@@ -66,6 +68,8 @@ void ImportDialog::storeStdConfig(ImportManager::StandardImportConfig &stdConfig
     CFG->set(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_CODEC, stdConfig.codec);
     CFG->set(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_FILE, stdConfig.inputFileName);
     CFG->set(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_IGNORE_ERR, stdConfig.ignoreErrors);
+    CFG->set(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_COMMIT_INTERVAL, stdConfig.commitInterval);
+    CFG->set(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_FAST_IMPORT, stdConfig.fastImportPragmas);
     CFG->set(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_FORMAT, currentPlugin->getDataSourceTypeName());
     CFG->commit();
 }
@@ -79,6 +83,8 @@ void ImportDialog::readStdConfig()
 
     ui->inputFileEdit->setText(CFG->get(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_FILE, QString()).toString());
     ui->ignoreErrorsCheck->setChecked(CFG->get(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_IGNORE_ERR, false).toBool());
+    ui->commitIntervalSpin->setValue(CFG->get(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_COMMIT_INTERVAL, 0).toInt());
+    ui->fastImportCheck->setChecked(CFG->get(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_FAST_IMPORT, false).toBool());
 
     // Encoding
     QString codec = CFG->get(IMPORT_DIALOG_CFG_GROUP, IMPORT_DIALOG_CFG_CODEC).toString();
@@ -395,6 +401,8 @@ void ImportDialog::accept()
         stdConfig.codec = ui->codecCombo->currentText();
 
     stdConfig.ignoreErrors = ui->ignoreErrorsCheck->isChecked();
+    stdConfig.commitInterval = ui->commitIntervalSpin->value();
+    stdConfig.fastImportPragmas = ui->fastImportCheck->isChecked();
 
     storeStdConfig(stdConfig);
     configMapper->saveFromWidget(pluginOptionsWidget);
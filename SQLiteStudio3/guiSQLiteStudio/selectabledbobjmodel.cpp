@@ -69,6 +69,9 @@ QString SelectableDbObjModel::getDbName() const
 
 void SelectableDbObjModel::setDbName(const QString& value)
 {
+    // Checking the table checks its indexes and triggers too, so all of them have to exist in the source model
+    dynamic_cast<DbTreeModel*>(sourceModel())->fetchAll(value);
+
     beginResetModel();
     dbName = value;
     checkedObjects.clear();
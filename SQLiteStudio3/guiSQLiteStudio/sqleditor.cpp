@@ -45,11 +45,9 @@ SqlEditor::~SqlEditor()
     if (objectsInNamedDbFuture.isRunning())
         objectsInNamedDbFuture.waitForFinished();
 
-    if (queryParser)
-    {
-        delete queryParser;
-        queryParser = nullptr;
-    }
+    // Cancelling any parsing in progress, as it refers to the generation counter of this editor
+    parseGeneration.fetchAndAddOrdered(1);
+    parseWatcher->waitForFinished();
 }
 
 void SqlEditor::init()
@@ -87,11 +85,12 @@ void SqlEditor::init()
     connect(autoCompleteTrigger, SIGNAL(triggered()), this, SLOT(checkForAutoCompletion()));
 
     queryParserTrigger = new LazyTrigger(queryParserDelay, this);
-    connect(autoCompleteTrigger, SIGNAL(triggered()), this, SLOT(parseContents()));
+    connect(queryParserTrigger, SIGNAL(triggered()), this, SLOT(parseContents()));
 
     connect(this, SIGNAL(textChanged()), this, SLOT(scheduleQueryParser()));
 
-    queryParser = new Parser(Dialect::Sqlite3);
+    parseWatcher = new QFutureWatcher<ParseResults>(this);
+    connect(parseWatcher, SIGNAL(finished()), this, SLOT(parsingFinished()));
 
     connect(this, &QWidget::customContextMenuRequested, this, &SqlEditor::customContextMenuRequested);
     connect(CFG_UI.Fonts.SqlEditor, SIGNAL(changed(QVariant)), this, SLOT(changeFont(QVariant)));
@@ -220,10 +219,22 @@ bool SqlEditor::handleValidObjectContextMenu(const QPoint& pos)
 
     validObjContextMenu->clear();
 
+    DbTreeModel* treeModel = DBTREE->getModel();
     DbTreeItem* item = nullptr;
+    DbTreeItem* ownerItem = nullptr;
     for (DbTreeItem::Type type : {DbTreeItem::Type::TABLE, DbTreeItem::Type::INDEX, DbTreeItem::Type::TRIGGER, DbTreeItem::Type::VIEW})
     {
-        item = DBTREE->getModel()->findItem(type, objName);
+        item = treeModel->findItem(type, objName);
+        if (item)
+            break;
+
+        // Indexes and triggers are in the tree only after their table or view was expanded
+        ownerItem = treeModel->findOwnerItem(type, objName);
+        if (!ownerItem || !treeModel->canFetchMore(ownerItem->index()))
+            continue;
+
+        treeModel->fetchMore(ownerItem->index());
+        item = ownerItem->findItem(type, objName);
         if (item)
             break;
     }
@@ -529,6 +540,8 @@ void SqlEditor::refreshValidObjects()
     if (!db || !db->isValid())
         return;
 
+    // Validity of all object names may change, so all markers need to be repainted
+    fullRehighlightNeeded = true;
     objectsInNamedDbFuture = QtConcurrent::run([this]()
     {
         QMutexLocker lock(&objectsInNamedDbMutex);
@@ -838,14 +851,29 @@ void SqlEditor::completerRightPressed()
 
 void SqlEditor::parseContents()
 {
-    if (!richFeaturesEnabled)
-        return;
+    Dialect dialect = updateParsingDialect();
+    QString sql = getSqlForParsing();
+    QHash<QString,StatementMarkersPtr> cache = statementCache;
 
-    // Updating dialect according to current database (if any)
-    Dialect dialect = Dialect::Sqlite3;
-    if (db && db->isValid())
-        dialect = db->getDialect();
+    // Increasing the generation cancels any parsing still running for older contents
+    int generation = parseGeneration.fetchAndAddOrdered(1) + 1;
+    parseWatcher->setFuture(QtConcurrent::run([this, sql, dialect, cache, generation]()
+    {
+        return parseStatements(sql, dialect, cache, generation, &parseGeneration);
+    }));
+}
+
+void SqlEditor::parsingFinished()
+{
+    ParseResults results = parseWatcher->result();
+    if (results.cancelled || results.generation != parseGeneration.loadAcquire())
+        return; // contents have changed in the meantime, newer results will follow
 
+    applyParseResults(results);
+}
+
+QString SqlEditor::getSqlForParsing() const
+{
     QString sql = toPlainText();
     if (!virtualSqlExpression.isNull())
     {
@@ -854,80 +882,197 @@ void SqlEditor::parseContents()
 
         sql = virtualSqlExpression.arg(sql);
     }
+    return sql;
+}
+
+Dialect SqlEditor::updateParsingDialect()
+{
+    // Updating dialect according to current database (if any)
+    Dialect dialect = Dialect::Sqlite3;
+    if (db && db->isValid())
+        dialect = db->getDialect();
 
-    queryParser->setDialect(dialect);
-    if (richFeaturesEnabled)
+    if (dialect != statementCacheDialect)
     {
-        queryParser->parse(sql);
-        checkForValidObjects();
-        checkForSyntaxErrors();
-        highlighter->rehighlight();
+        statementCache.clear();
+        statementCacheDialect = dialect;
+        fullRehighlightNeeded = true;
     }
-
+    return dialect;
 }
 
-void SqlEditor::checkForSyntaxErrors()
+SqlEditor::ParseResults SqlEditor::parseStatements(const QString& sql, Dialect dialect, const QHash<QString,StatementMarkersPtr>& cache, int generation,
+                                                   const QAtomicInt* currentGeneration)
 {
-    syntaxValidated = true;
+    ParseResults results;
+    results.generation = generation;
 
-    removeErrorMarkers();
+    Parser parser(dialect);
+    QString statementSql;
+    StatementMarkersPtr markers;
+    int start;
+    int length;
+    for (const TokenList& tokens : splitQueries(Lexer::tokenize(sql, dialect)))
+    {
+        if (currentGeneration->loadAcquire() != generation)
+        {
+            results.cancelled = true;
+            return results;
+        }
+
+        if (tokens.filterWhiteSpaces().isEmpty())
+            continue;
+
+        start = tokens.first()->start;
+        length = tokens.last()->end - start + 1;
+        statementSql = sql.mid(start, length);
+
+        markers = results.cache.value(statementSql);
+        if (!markers)
+            markers = cache.value(statementSql);
+
+        if (!markers)
+            markers = parseStatement(parser, statementSql, dialect);
+
+        results.cache[statementSql] = markers;
+        results.statements << StatementEntry{start, length, markers};
+    }
+    return results;
+}
+
+SqlEditor::StatementMarkersPtr SqlEditor::parseStatement(Parser& parser, const QString& sql, Dialect dialect)
+{
+    StatementMarkers* markers = new StatementMarkers();
+    parser.parse(sql);
 
-    // Marking invalid tokens, like in "SELECT * from test] t" - the "]" token is invalid.
-    // Such tokens don't cause parser to fail.
-    for (SqliteQueryPtr query : queryParser->getQueries())
+    StatementMarkers::Object obj;
+    for (SqliteQueryPtr query : parser.getQueries())
     {
+        // Marking invalid tokens, like in "SELECT * from test] t" - the "]" token is invalid.
+        // Such tokens don't cause parser to fail.
         for (TokenPtr token : query->tokens)
         {
             if (token->type == Token::INVALID)
-                markErrorAt(token->start, token->end, true);
+                markers->errors << StatementMarkers::Error{static_cast<int>(token->start), static_cast<int>(token->end), true};
+        }
+
+        // Object names are validated against the database later, in the GUI thread
+        for (const SqliteStatement::FullObject& fullObj : query->getContextFullObjects())
+        {
+            obj.dbName = fullObj.database ? stripObjName(fullObj.database->value, dialect) : "main";
+            obj.isDatabase = (fullObj.type == SqliteStatement::FullObject::DATABASE);
+            if (obj.isDatabase)
+            {
+                obj.from = fullObj.database->start;
+                obj.to = fullObj.database->end;
+                obj.objectName.clear();
+            }
+            else
+            {
+                obj.from = fullObj.object->start;
+                obj.to = fullObj.object->end;
+                obj.objectName = stripObjName(fullObj.object->value, dialect);
+            }
+            markers->objects << obj;
         }
     }
 
-    if (queryParser->isSuccessful())
+    markers->successful = parser.isSuccessful();
+    if (!markers->successful)
     {
-        emit errorsChecked(false);
-        return;
+        for (ParserError* error : parser.getErrors())
+            markers->errors << StatementMarkers::Error{static_cast<int>(error->getFrom()), static_cast<int>(error->getTo()), false};
     }
 
-    // Setting new markers when errors were detected
-    for (ParserError* error : queryParser->getErrors())
-        markErrorAt(sqlIndex(error->getFrom()), sqlIndex(error->getTo()));
-
-    emit errorsChecked(true);
+    return StatementMarkersPtr(markers);
 }
 
-void SqlEditor::checkForValidObjects()
+void SqlEditor::applyParseResults(const ParseResults& results)
 {
+    // Markers of statements parsed before are already painted, unless the statement has moved.
+    QHash<const StatementMarkers*,int> previousStarts;
+    for (const StatementEntry& entry : statementIndex)
+        previousStarts[entry.markers.data()] = entry.start;
+
+    // Positions in the virtual SQL expression don't map to blocks one-to-one. It's always a small contents anyway.
+    bool fullRehighlight = fullRehighlightNeeded || !virtualSqlExpression.isNull();
+
+    removeErrorMarkers();
     clearDbObjects();
-    if (!db || !db->isValid())
-        return;
 
+    bool validateObjects = db && db->isValid();
+    bool successful = true;
+    QList<QPair<int,int>> rangesToRehighlight;
+    int start;
     QMutexLocker lock(&objectsInNamedDbMutex);
-    Dialect dialect = db->getDialect();
-    QList<SqliteStatement::FullObject> fullObjects;
-    QString dbName;
-    for (SqliteQueryPtr query : queryParser->getQueries())
+    for (const StatementEntry& entry : results.statements)
     {
-        fullObjects = query->getContextFullObjects();
-        for (const SqliteStatement::FullObject& fullObj : fullObjects)
-        {
-            dbName = fullObj.database ? stripObjName(fullObj.database->value, dialect) : "main";
-            if (!objectsInNamedDb.contains(dbName))
-                continue;
+        start = entry.start;
+        for (const StatementMarkers::Error& error : entry.markers->errors)
+            markErrorAt(sqlIndex(start + error.from), sqlIndex(start + error.to), error.limitedDamage);
+
+        if (!entry.markers->successful)
+            successful = false;
 
-            if (fullObj.type == SqliteStatement::FullObject::DATABASE)
+        if (validateObjects)
+        {
+            for (const StatementMarkers::Object& obj : entry.markers->objects)
             {
-                // Valid db name
-                addDbObject(sqlIndex(fullObj.database->start), sqlIndex(fullObj.database->end), QString());
-                continue;
-            }
+                if (!objectsInNamedDb.contains(obj.dbName))
+                    continue;
+
+                if (obj.isDatabase)
+                {
+                    // Valid db name
+                    addDbObject(sqlIndex(start + obj.from), sqlIndex(start + obj.to), QString());
+                    continue;
+                }
 
-            if (!objectsInNamedDb[dbName].contains(stripObjName(fullObj.object->value, dialect)))
-                continue;
+                if (!objectsInNamedDb[obj.dbName].contains(obj.objectName))
+                    continue;
 
-            // Valid object name
-            addDbObject(sqlIndex(fullObj.object->start), sqlIndex(fullObj.object->end), dbName);
+                // Valid object name
+                addDbObject(sqlIndex(start + obj.from), sqlIndex(start + obj.to), obj.dbName);
+            }
         }
+
+        if (fullRehighlight)
+            continue;
+
+        // Statement without any markers looks the same wherever it is moved
+        if (previousStarts.value(entry.markers.data(), -1) == start ||
+                (previousStarts.contains(entry.markers.data()) && entry.markers->errors.isEmpty() && entry.markers->objects.isEmpty()))
+            continue;
+
+        rangesToRehighlight << QPair<int,int>(start, start + entry.length);
+    }
+    lock.unlock();
+
+    statementCache = results.cache;
+    statementIndex = results.statements;
+    syntaxValidated = true;
+
+    if (fullRehighlight)
+    {
+        highlighter->rehighlight();
+        fullRehighlightNeeded = false;
+    }
+    else
+    {
+        for (const QPair<int,int>& range : rangesToRehighlight)
+            rehighlightRange(range.first, range.second);
+    }
+
+    emit errorsChecked(!successful);
+}
+
+void SqlEditor::rehighlightRange(int from, int to)
+{
+    QTextBlock block = document()->findBlock(from);
+    while (block.isValid() && block.position() <= to)
+    {
+        highlighter->rehighlightBlock(block);
+        block = block.next();
     }
 }
 
@@ -1050,7 +1195,7 @@ void SqlEditor::checkContentSize()
     if (document()->characterCount() > SqliteSyntaxHighlighter::MAX_QUERY_LENGTH)
     {
         if (richFeaturesEnabled)
-            notifyWarn(tr("Contents of the SQL editor are huge, so errors detecting and existing objects highlighting are temporarily disabled."));
+            notifyWarn(tr("Contents of the SQL editor are huge, so code assistant and parenthesis matching are temporarily disabled."));
 
         richFeaturesEnabled = false;
     }
@@ -1561,7 +1706,10 @@ void SqlEditor::setShowLineNumbers(bool value)
 void SqlEditor::checkSyntaxNow()
 {
     queryParserTrigger->cancel();
-    parseContents();
+
+    Dialect dialect = updateParsingDialect();
+    int generation = parseGeneration.fetchAndAddOrdered(1) + 1;
+    applyParseResults(parseStatements(getSqlForParsing(), dialect, statementCache, generation, &parseGeneration));
 }
 
 void SqlEditor::saveSelection()
@@ -11,6 +11,9 @@
 #include <QHash>
 #include <QMutex>
 #include <QFuture>
+#include <QFutureWatcher>
+#include <QSharedPointer>
+#include <QAtomicInt>
 
 class CompleterWindow;
 class Parser;
@@ -147,6 +150,69 @@ class GUI_API_EXPORT SqlEditor : public QPlainTextEdit, public ExtActionContaine
             QString dbName;
         };
 
+        /**
+         * @brief Markers found by parsing a single statement.
+         * All positions are relative to the beginning of the statement, so parsing results
+         * can be reused as long as the statement text doesn't change, wherever the statement is moved.
+         */
+        struct StatementMarkers
+        {
+            struct Error
+            {
+                int from;
+                int to;
+                bool limitedDamage;
+            };
+
+            struct Object
+            {
+                int from;
+                int to;
+                bool isDatabase;
+                QString dbName;
+                QString objectName;
+            };
+
+            QList<Error> errors;
+            QList<Object> objects;
+            bool successful = true;
+        };
+
+        typedef QSharedPointer<const StatementMarkers> StatementMarkersPtr;
+
+        /**
+         * @brief Entry of the statement-boundary index of the editor contents.
+         */
+        struct StatementEntry
+        {
+            int start;
+            int length;
+            StatementMarkersPtr markers;
+        };
+
+        struct ParseResults
+        {
+            int generation = 0;
+            bool cancelled = false;
+            QList<StatementEntry> statements;
+            QHash<QString,StatementMarkersPtr> cache;
+        };
+
+        /**
+         * @brief Splits SQL into statements and parses those not found in the cache.
+         * @param sql Contents to parse.
+         * @param dialect SQLite dialect to parse with.
+         * @param cache Results of previous parsing, keyed by statement text.
+         * @param generation Generation of this parsing request.
+         * @param currentGeneration Generation of the most recent request. Parsing is cancelled as soon as it differs from \p generation.
+         * @return Statement index with markers and a cache containing only statements present in \p sql.
+         *
+         * It doesn't touch any editor state, so it's safe to call it from a worker thread.
+         */
+        static ParseResults parseStatements(const QString& sql, Dialect dialect, const QHash<QString,StatementMarkersPtr>& cache, int generation,
+                                            const QAtomicInt* currentGeneration);
+        static StatementMarkersPtr parseStatement(Parser& parser, const QString& sql, Dialect dialect);
+
         void setupMenu();
         void updateCompleterPosition();
         void init();
@@ -163,8 +229,10 @@ class GUI_API_EXPORT SqlEditor : public QPlainTextEdit, public ExtActionContaine
         void markErrorAt(int start, int end, bool limitedDamage = false);
         void deletePreviousChars(int length = 1);
         void refreshValidObjects();
-        void checkForSyntaxErrors();
-        void checkForValidObjects();
+        QString getSqlForParsing() const;
+        Dialect updateParsingDialect();
+        void applyParseResults(const ParseResults& results);
+        void rehighlightRange(int from, int to);
         Dialect getDialect();
         void setObjectLinks(bool enabled);
         void addDbObject(int from, int to, const QString& dbName);
@@ -209,7 +277,12 @@ class GUI_API_EXPORT SqlEditor : public QPlainTextEdit, public ExtActionContaine
         bool autoCompletion = true;
         bool deletionKeyPressed = false;
         LazyTrigger* queryParserTrigger = nullptr;
-        Parser* queryParser = nullptr;
+        QFutureWatcher<ParseResults>* parseWatcher = nullptr;
+        QAtomicInt parseGeneration;
+        QHash<QString,StatementMarkersPtr> statementCache;
+        Dialect statementCacheDialect = Dialect::Sqlite3;
+        QList<StatementEntry> statementIndex;
+        bool fullRehighlightNeeded = true;
         QHash<QString,QStringList> objectsInNamedDb;
         QMutex objectsInNamedDbMutex;
         bool objectLinksEnabled = false;
@@ -267,6 +340,7 @@ class GUI_API_EXPORT SqlEditor : public QPlainTextEdit, public ExtActionContaine
         void completerLeftPressed();
         void completerRightPressed();
         void parseContents();
+        void parsingFinished();
         void scheduleQueryParser(bool force = false);
         void updateLineNumberAreaWidth();
         void highlightCurrentLine();
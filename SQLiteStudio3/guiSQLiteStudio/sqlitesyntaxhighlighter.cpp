@@ -2,22 +2,33 @@
 #include "parser/lexer.h"
 #include "uiconfig.h"
 #include "services/config.h"
+#include "common/global.h"
 #include <QTextDocument>
 #include <QDebug>
 #include <QPlainTextEdit>
+#include <algorithm>
 
 SqliteSyntaxHighlighter::SqliteSyntaxHighlighter(QTextDocument *parent) :
     QSyntaxHighlighter(parent)
 {
     setupFormats();
     setupMapping();
-    setCurrentBlockState(regulartTextBlockState);
+    lexer = new Lexer(Dialect::Sqlite3);
+    lexer->setTolerantMode(true);
     connect(CFG, SIGNAL(massSaveCommitted()), this, SLOT(setupFormats()));
 }
 
+SqliteSyntaxHighlighter::~SqliteSyntaxHighlighter()
+{
+    safe_delete(lexer);
+}
+
 void SqliteSyntaxHighlighter::setSqliteVersion(int version)
 {
     this->sqliteVersion = version;
+    safe_delete(lexer);
+    lexer = new Lexer(version == 2 ? Dialect::Sqlite2 : Dialect::Sqlite3);
+    lexer->setTolerantMode(true);
     rehighlight();
 }
 
@@ -94,94 +105,54 @@ void SqliteSyntaxHighlighter::setupMapping()
     tokenTypeMapping[Token::KEYWORD] = State::KEYWORD;
 }
 
-QString SqliteSyntaxHighlighter::getPreviousStatePrefix(TextBlockState textBlockState)
-{
-    QString prefix = "";
-    switch (textBlockState)
-    {
-        case SqliteSyntaxHighlighter::TextBlockState::REGULAR:
-            break;
-        case SqliteSyntaxHighlighter::TextBlockState::BLOB:
-            prefix = "x'";
-            break;
-        case SqliteSyntaxHighlighter::TextBlockState::STRING:
-            prefix = "'";
-            break;
-        case SqliteSyntaxHighlighter::TextBlockState::COMMENT:
-            prefix = "/*";
-            break;
-        case SqliteSyntaxHighlighter::TextBlockState::ID_1:
-            prefix = "[";
-            break;
-        case SqliteSyntaxHighlighter::TextBlockState::ID_2:
-            prefix = "\"";
-            break;
-        case SqliteSyntaxHighlighter::TextBlockState::ID_3:
-            prefix = "`";
-            break;
-    }
-    return prefix;
-}
-
 void SqliteSyntaxHighlighter::highlightBlock(const QString &text)
 {
-    if (text.length() <= 0 || document()->characterCount() > MAX_QUERY_LENGTH)
-        return;
+    // Previous block state is -1 if it wasn't highlighted yet, or if this is the first block
+    int previousState = qMax(previousBlockState(), 0);
+    Lexer::OpenToken openToken = static_cast<Lexer::OpenToken>(previousState & OPEN_TOKEN_MASK);
+    bool errorCarriedIn = previousState & CARRIED_ERROR_FLAG;
 
-    // Reset to default
-    QSyntaxHighlighter::setFormat(0, text.length(), formats[State::STANDARD]);
-
-    qint32 idxModifier = 0;
-    QString statePrefix = "";
-    if (previousBlockState() != regulartTextBlockState)
+    TextBlockData* data = new TextBlockData();
+    if (text.isEmpty())
     {
-        statePrefix = getPreviousStatePrefix(static_cast<TextBlockState>(previousBlockState()));
-        idxModifier += statePrefix.size();
+        // Empty line doesn't change anything for the next one
+        setCurrentBlockState(previousState);
+        setCurrentBlockUserData(data);
+        return;
     }
 
-    Lexer lexer(sqliteVersion == 2 ? Dialect::Sqlite2 : Dialect::Sqlite3);
-    lexer.setTolerantMode(true);
-    lexer.prepare(statePrefix+text);
-
-    // Previous error state.
-    // Empty lines have no userData, so we will look for any previous paragraph that is
-    // valid and has a data, so it has any logical meaning to highlighter.
-    QTextBlock prevBlock = currentBlock().previous();
-    while ((!prevBlock.isValid() || !prevBlock.userData() || prevBlock.text().isEmpty()) && prevBlock.position() > 0)
-        prevBlock = prevBlock.previous();
+    // Reset to default
+    QSyntaxHighlighter::setFormat(0, text.length(), formats[State::STANDARD]);
 
-    TextBlockData* prevData = nullptr;
-    if (prevBlock.isValid())
-        prevData = dynamic_cast<TextBlockData*>(prevBlock.userData());
+    lexer->prepare(text, openToken);
 
-    TextBlockData* data = new TextBlockData();
     int errorStart = -1;
-    TokenPtr token = lexer.getToken();
+    TokenPtr token = lexer->getToken();
     while (token)
     {
-        if (handleToken(token, idxModifier, errorStart, data, prevData))
+        if (handleToken(token, errorStart, data, errorCarriedIn))
             errorStart = token->start + currentBlock().position();
 
         if (data->getEndsWithQuerySeparator())
             errorStart = -1;
 
         handleParenthesis(token, data);
-        token = lexer.getToken();
+        token = lexer->getToken();
     }
 
+    int state = static_cast<int>(lexer->getOpenToken());
+    if (data->getEndsWithError() && !data->getEndsWithQuerySeparator())
+        state |= CARRIED_ERROR_FLAG;
+
+    lexer->cleanUp();
+    setCurrentBlockState(state);
     setCurrentBlockUserData(data);
 }
 
-bool SqliteSyntaxHighlighter::handleToken(TokenPtr token, qint32 idxModifier, int errorStart, TextBlockData* currBlockData,
-                                          TextBlockData* previousBlockData)
+bool SqliteSyntaxHighlighter::handleToken(TokenPtr token, int errorStart, TextBlockData* currBlockData, bool errorCarriedIn)
 {
-    qint64 start = token->start - idxModifier;
+    qint64 start = token->start;
     qint64 lgt = token->end - token->start + 1;
-    if (start < 0)
-    {
-        lgt += start; // cut length by num of chars before 0 (after idxModifier applied)
-        start = 0;
-    }
 
     if (createTriggerContext && token->type == Token::OTHER && (token->value.toLower() == "old" || token->value.toLower() == "new"))
         token->type = Token::KEYWORD;
@@ -197,9 +168,7 @@ bool SqliteSyntaxHighlighter::handleToken(TokenPtr token, qint32 idxModifier, in
                     ) ||
                     (
                         token->start == 0 &&
-                        previousBlockData &&
-                        previousBlockData->getEndsWithError() &&
-                        !previousBlockData->getEndsWithQuerySeparator()
+                        errorCarriedIn
                     );
     bool fatalError = (error && !limitedDamage) || wasError;
 
@@ -218,13 +187,6 @@ bool SqliteSyntaxHighlighter::handleToken(TokenPtr token, qint32 idxModifier, in
     // Apply format
     QSyntaxHighlighter::setFormat(start, lgt, format);
 
-    // Save block state
-    TolerantTokenPtr tolerantToken = token.dynamicCast<TolerantToken>();
-    if (tolerantToken->invalid)
-        setStateForUnfinishedToken(tolerantToken);
-    else
-        setCurrentBlockState(regulartTextBlockState);
-
     currBlockData->setEndsWithError(fatalError);
     currBlockData->setEndsWithQuerySeparator(querySeparator);
 
@@ -278,66 +240,50 @@ void SqliteSyntaxHighlighter::setObjectLinksEnabled(bool value)
 bool SqliteSyntaxHighlighter::isError(int start, int lgt, bool* limitedDamage)
 {
     start += currentBlock().position();
-    int end = start + lgt - 1;
-    for (const Error& error : errors)
-    {
-        if (error.from <= start && error.to >= end)
-        {
-            *limitedDamage = error.limitedDamage;
-            return true;
-        }
-    }
-    return false;
+    const Error* error = findRange(errors, errorsSorted, maxErrorLength, start, start + lgt - 1);
+    if (!error)
+        return false;
+
+    *limitedDamage = error->limitedDamage;
+    return true;
 }
 
 bool SqliteSyntaxHighlighter::isValid(int start, int lgt)
 {
     start += currentBlock().position();
-    int end = start + lgt - 1;
-    for (const DbObject& obj : dbObjects)
-    {
-        if (obj.from <= start && obj.to >= end)
-            return true;
-    }
-    return false;
+    return findRange(dbObjects, dbObjectsSorted, maxDbObjectLength, start, start + lgt - 1) != nullptr;
 }
 
-void SqliteSyntaxHighlighter::setStateForUnfinishedToken(TolerantTokenPtr tolerantToken)
+template <class T>
+const T* SqliteSyntaxHighlighter::findRange(QList<T>& ranges, bool& sorted, int maxLength, int start, int end)
 {
-    switch (tolerantToken->type)
+    if (!sorted)
     {
-        case Token::OTHER:
-        {
-            switch (tolerantToken->value.at(0).toLatin1())
-            {
-                case '[':
-                    setCurrentBlockState(static_cast<int>(TextBlockState::ID_1));
-                    break;
-                case '"':
-                    setCurrentBlockState(static_cast<int>(TextBlockState::ID_2));
-                    break;
-                case '`':
-                    setCurrentBlockState(static_cast<int>(TextBlockState::ID_3));
-                    break;
-            }
-            break;
-        }
-        case Token::STRING:
-            setCurrentBlockState(static_cast<int>(TextBlockState::STRING));
-            break;
-        case Token::COMMENT:
-            setCurrentBlockState(static_cast<int>(TextBlockState::COMMENT));
-            break;
-        case Token::BLOB:
-            setCurrentBlockState(static_cast<int>(TextBlockState::BLOB));
-            break;
-        default:
+        // Stable, so the range added first still wins among ranges starting at the same position
+        std::stable_sort(ranges.begin(), ranges.end(), [](const T& r1, const T& r2) {return r1.from < r2.from;});
+        sorted = true;
+    }
+
+    // Only ranges starting at most maxLength before the end can reach it
+    const T* result = nullptr;
+    auto it = std::upper_bound(ranges.cbegin(), ranges.cend(), start, [](int pos, const T& range) {return pos < range.from;});
+    while (it != ranges.cbegin())
+    {
+        --it;
+        if (it->from + maxLength < end)
             break;
+
+        if (it->to >= end)
+            result = &(*it);
     }
+    return result;
 }
+
 void SqliteSyntaxHighlighter::clearErrors()
 {
     errors.clear();
+    errorsSorted = true;
+    maxErrorLength = 0;
 }
 
 bool SqliteSyntaxHighlighter::haveErrors()
@@ -347,17 +293,27 @@ bool SqliteSyntaxHighlighter::haveErrors()
 
 void SqliteSyntaxHighlighter::addDbObject(int from, int to)
 {
+    if (!dbObjects.isEmpty() && dbObjects.last().from > from)
+        dbObjectsSorted = false;
+
     dbObjects << DbObject(from, to);
+    maxDbObjectLength = qMax(maxDbObjectLength, to - from);
 }
 
 void SqliteSyntaxHighlighter::clearDbObjects()
 {
     dbObjects.clear();
+    dbObjectsSorted = true;
+    maxDbObjectLength = 0;
 }
 
 void SqliteSyntaxHighlighter::addError(int from, int to, bool limitedDamage)
 {
+    if (!errors.isEmpty() && errors.last().from > from)
+        errorsSorted = false;
+
     errors << Error(from, to, limitedDamage);
+    maxErrorLength = qMax(maxErrorLength, to - from);
 }
 
 SqliteSyntaxHighlighter::Error::Error(int from, int to, bool limitedDamage) :
@@ -2,6 +2,7 @@
 #define SQLITESYNTAXHIGHLIGHTER_H
 
 #include "parser/token.h"
+#include "parser/lexer.h"
 #include "syntaxhighlighterplugin.h"
 #include "plugins/builtinplugin.h"
 #include "guiSQLiteStudio_global.h"
@@ -53,6 +54,7 @@ class GUI_API_EXPORT SqliteSyntaxHighlighter : public QSyntaxHighlighter
         };
 
         explicit SqliteSyntaxHighlighter(QTextDocument *parent);
+        ~SqliteSyntaxHighlighter();
 
         void setSqliteVersion(int version);
         void setFormat(State state, QTextCharFormat format);
@@ -80,17 +82,6 @@ class GUI_API_EXPORT SqliteSyntaxHighlighter : public QSyntaxHighlighter
         void highlightBlock(const QString &text);
 
     private:
-        enum class TextBlockState
-        {
-            REGULAR = -1, // default, the -1 is default of QSyntaxHighlighter
-            BLOB,         // x'blob'
-            STRING,       // 'string'
-            COMMENT,      // /* comment */
-            ID_1,         // [id]
-            ID_2,         // "id"
-            ID_3          // `id`
-        };
-
         struct Error
         {
             Error(int from, int to, bool limitedDamage = false);
@@ -110,31 +101,39 @@ class GUI_API_EXPORT SqliteSyntaxHighlighter : public QSyntaxHighlighter
 
         void setupMapping();
 
-        /**
-         * @brief getPreviousStatePrefix Provides prefix for previous block's state.
-         * @param textBlockState Previous text block's state.
-         * @return Prefix string (if any) for lexer to provide proper tokens according to previous state.
-         */
-        QString getPreviousStatePrefix(TextBlockState textBlockState);
-
         /**
          * @brief handleToken Highlights token.
          * @param token Token to handle.
-         * @param idxModifier Modifier for text highlighting in case of previous state defined by multi-character token. See getPreviousStatePrefix() for details.
+         * @param errorStart Document position of the first error in this block, or -1 if there was no error yet.
+         * @param currBlockData Data of the highlighted block.
+         * @param errorCarriedIn true if the previous block ended with an error in a statement that continues in this block.
          * @return true if the token is being marked as invalid (syntax error).
          */
-        bool handleToken(TokenPtr token, qint32 idxModifier, int errorStart, TextBlockData* currBlockData, TextBlockData* previousBlockData);
+        bool handleToken(TokenPtr token, int errorStart, TextBlockData* currBlockData, bool errorCarriedIn);
 
         bool isError(int start, int lgt, bool* limitedDamage);
         bool isValid(int start, int lgt);
 
+        /**
+         * @brief findRange Finds range containing given text.
+         * @param ranges Ranges to search. They're sorted by their beginning when not yet sorted.
+         * @param sorted Flag indicating whether the \p ranges are sorted already.
+         * @param maxLength Longest distance between beginning and end of any range in \p ranges.
+         * @param start Document position of the text beginning.
+         * @param end Document position of the text end (inclusive).
+         * @return Range containing the text, or null if there is no such range.
+         *
+         * Lookup is logarithmic, so highlighting a block doesn't get slower with the number of markers in the document.
+         */
+        template <class T>
+        static const T* findRange(QList<T>& ranges, bool& sorted, int maxLength, int start, int end);
+
         /**
          * @brief markUncheckedErrors Marks text as being uncheck for possible errors.
          * @param errorStart Start index of unchecked text.
          * Unchecked text is all text after first error, becuase it could not be parser, therefore could not be checked.
          */
         void markUncheckedErrors(int errorStart, int length);
-        void setStateForUnfinishedToken(TolerantTokenPtr tolerantToken);
 
         /**
          * @brief applyErrorFormat Applies error format properties to given format.
@@ -155,12 +154,27 @@ class GUI_API_EXPORT SqliteSyntaxHighlighter : public QSyntaxHighlighter
 
         void handleParenthesis(TokenPtr token, TextBlockData* data);
 
-        static const int regulartTextBlockState = static_cast<int>(TextBlockState::REGULAR);
+        /**
+         * @brief Text block state bits.
+         *
+         * The block state (QTextBlock::userState()) keeps everything needed to highlight the next block:
+         * the Lexer::OpenToken in the lowest bits and a flag for an error carried over to the next block.
+         * Qt rehighlights next block only if this state changes, so an edit affects only blocks following it
+         * while the state they start with keeps changing.
+         */
+        static constexpr int OPEN_TOKEN_MASK = 0x0f;
+        static constexpr int CARRIED_ERROR_FLAG = 0x10;
+
         int sqliteVersion = 3;
+        Lexer* lexer = nullptr;
         QHash<State,QTextCharFormat> formats;
         QHash<Token::Type,State> tokenTypeMapping;
         QList<Error> errors;
+        bool errorsSorted = true;
+        int maxErrorLength = 0;
         QList<DbObject> dbObjects;
+        bool dbObjectsSorted = true;
+        int maxDbObjectLength = 0;
         bool objectLinksEnabled = false;
         bool createTriggerContext = false;
 
@@ -1,4 +1,5 @@
 #include "cliutils.h"
+#include "common/unused.h"
 #include <QtGlobal>
 
 #if defined(Q_OS_WIN32)
@@ -7,41 +8,106 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 #endif
+#include <csignal>
+
+// Used when the output is not a terminal (i.e. it's piped to a file)
+static const int defaultCliColumns = 80;
+static const int defaultCliRows = 24;
+
+static volatile sig_atomic_t cliInterrupted = 0;
 
 #if defined(Q_OS_WIN32)
 
 int getCliColumns()
 {
     CONSOLE_SCREEN_BUFFER_INFO data;
-    GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &data);
+    if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &data))
+        return defaultCliColumns;
+
     return data.dwSize.X;
 }
 
 int getCliRows()
 {
     CONSOLE_SCREEN_BUFFER_INFO data;
-    GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &data);
+    if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &data))
+        return defaultCliRows;
+
     return data.dwSize.Y;
 }
 
+static BOOL WINAPI cliCtrlHandler(DWORD ctrlType)
+{
+    if (ctrlType != CTRL_C_EVENT)
+        return FALSE;
+
+    cliInterrupted = 1;
+    return TRUE;
+}
+
+void startCliInterruptCatching()
+{
+    cliInterrupted = 0;
+    SetConsoleCtrlHandler(cliCtrlHandler, TRUE);
+}
+
+void stopCliInterruptCatching()
+{
+    SetConsoleCtrlHandler(cliCtrlHandler, FALSE);
+}
+
 #elif defined(Q_OS_UNIX)
 
 int getCliColumns()
 {
     struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) != 0 || w.ws_col == 0)
+        return defaultCliColumns;
+
     return w.ws_col;
 }
 
 int getCliRows()
 {
     struct winsize w;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) != 0 || w.ws_row == 0)
+        return defaultCliRows;
+
     return w.ws_row;
 }
 
+static struct sigaction previousSigIntAction;
+
+static void cliSigIntHandler(int sig)
+{
+    UNUSED(sig);
+    cliInterrupted = 1;
+}
+
+void startCliInterruptCatching()
+{
+    cliInterrupted = 0;
+
+    struct sigaction action;
+    action.sa_handler = cliSigIntHandler;
+    sigemptyset(&action.sa_mask);
+    // Interrupted writes to stdout (i.e. a pipe) are resumed, so the output is not lost
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, &previousSigIntAction);
+}
+
+void stopCliInterruptCatching()
+{
+    sigaction(SIGINT, &previousSigIntAction, nullptr);
+}
+
 #endif
 
+bool isCliInterrupted()
+{
+    return cliInterrupted != 0;
+}
+
 QStringList toAsciiTree(const AsciiTree& tree, const QList<bool>& indents, bool topLevel, bool lastNode)
 {
     static const QString indentStr = "  | ";
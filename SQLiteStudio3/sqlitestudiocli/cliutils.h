@@ -9,6 +9,16 @@ void initCliUtils();
 int getCliColumns();
 int getCliRows();
 
+/**
+ * @brief Starts catching Ctrl+C pressed by the user.
+ *
+ * Until stopCliInterruptCatching() is called, Ctrl+C doesn't terminate the application.
+ * It's only remembered and can be checked with isCliInterrupted(), so long running output can stop gracefully.
+ */
+void startCliInterruptCatching();
+void stopCliInterruptCatching();
+bool isCliInterrupted();
+
 struct AsciiTree
 {
     QList<AsciiTree> childs;
@@ -32,6 +32,7 @@ void CliCommandSql::execute()
 
     // Executor deletes itself later when called with lambda.
     QueryExecutor *executor = new QueryExecutor(db, syntax.getArgument(STRING));
+    executor->setSkipRowCounting(true); // total row count is never displayed in CLI
     connect(executor, SIGNAL(executionFinished(SqlQueryPtr)), this, SIGNAL(execComplete()));
     connect(executor, SIGNAL(executionFailed(int,QString)), this, SLOT(executionFailed(int,QString)));
     connect(executor, SIGNAL(executionFailed(int,QString)), this, SIGNAL(execComplete()));
@@ -41,6 +42,8 @@ void CliCommandSql::execute()
         if (results->isError())
             return; // should not happen, since results handler function is called only for successful executions
 
+        startCliInterruptCatching();
+        flushTimer.start();
         switch (CFG_CLI.Console.ResultsDisplayMode.get())
         {
             case CliResultsDisplay::FIXED:
@@ -56,6 +59,7 @@ void CliCommandSql::execute()
                 printResultsClassic(executor, results);
                 break;
         }
+        stopCliInterruptCatching();
     });
 }
 
@@ -115,6 +119,8 @@ void CliCommandSql::printResultsClassic(QueryExecutor* executor, SqlQueryPtr res
         }
 
         qOut << "\n";
+        if (!rowPrinted())
+            break;
     }
     qOut.flush();
 }
@@ -155,7 +161,11 @@ void CliCommandSql::printResultsFixed(QueryExecutor* executor, SqlQueryPtr resul
 
     // Data
     while (results->hasNext())
+    {
         printColumnDataRow(widths, results->next(), resultColumnsCount);
+        if (!rowPrinted())
+            break;
+    }
 
     qOut.flush();
 }
@@ -177,8 +187,12 @@ void CliCommandSql::printResultsColumns(QueryExecutor* executor, SqlQueryPtr res
         return;
     }
 
-    // Preload data (we will calculate column widths basing on real values)
-    QList<SqlResultsRowPtr> allRows = results->getAll();
+    // Preload first rows only (we will calculate column widths basing on real values).
+    // Remaining rows are printed as they are read, so memory use doesn't depend on the results size.
+    int sampleSize = qMax(CFG_CLI.Console.ColumnsSampleRows.get(), 1);
+    QList<SqlResultsRowPtr> sampleRows;
+    while (sampleRows.size() < sampleSize && results->hasNext())
+        sampleRows << results->next();
 
     // Get widths of each column in every data row, remember the longest ones
     QList<SortedColumnWidth*> columnWidths;
@@ -192,7 +206,7 @@ void CliCommandSql::printResultsColumns(QueryExecutor* executor, SqlQueryPtr res
     }
 
     int dataLength;
-    for (const SqlResultsRowPtr& row : allRows)
+    for (const SqlResultsRowPtr& row : sampleRows)
     {
         for (int i = 0; i < resultColumnsCount; i++)
         {
@@ -226,10 +240,28 @@ void CliCommandSql::printResultsColumns(QueryExecutor* executor, SqlQueryPtr res
     for (SortedColumnWidth* colWd : columnWidths)
         finalWidths << colWd->getWidth();
 
+    qDeleteAll(columnWidths);
+
     printColumnHeader(finalWidths, headerNames);
 
-    for (SqlResultsRowPtr row : allRows)
+    bool interrupted = false;
+    for (const SqlResultsRowPtr& row : sampleRows)
+    {
         printColumnDataRow(finalWidths, row, resultColumnsCount);
+        if (!rowPrinted())
+        {
+            interrupted = true;
+            break;
+        }
+    }
+    sampleRows.clear();
+
+    // Values longer than the sampled ones are cut, just like those shrinked to fit into the terminal
+    while (!interrupted && results->hasNext())
+    {
+        printColumnDataRow(finalWidths, results->next(), resultColumnsCount);
+        interrupted = !rowPrinted();
+    }
 
     qOut.flush();
 }
@@ -268,6 +300,8 @@ void CliCommandSql::printResultsRowByRow(QueryExecutor* executor, SqlQueryPtr re
             i++;
         }
         rowCnt++;
+        if (!rowPrinted())
+            break;
     }
     qOut.flush();
 }
@@ -389,6 +423,27 @@ void CliCommandSql::printColumnDataRow(const QList<int>& widths, const SqlResult
     qOut << line.join("|");
 }
 
+bool CliCommandSql::rowPrinted()
+{
+    if (isCliInterrupted())
+    {
+        printInterrupted();
+        return false;
+    }
+
+    if (flushTimer.elapsed() >= flushInterval)
+    {
+        qOut.flush();
+        flushTimer.restart();
+    }
+    return true;
+}
+
+void CliCommandSql::printInterrupted()
+{
+    qOut << "\n" << tr("Printing results interrupted by user.") << "\n";
+}
+
 QString CliCommandSql::getValueString(const QVariant& value)
 {
     if (value.isValid() && !value.isNull())
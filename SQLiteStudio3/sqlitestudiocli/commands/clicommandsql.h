@@ -3,6 +3,7 @@
 
 #include "clicommand.h"
 #include "db/sqlquery.h"
+#include <QElapsedTimer>
 
 class QueryExecutor;
 
@@ -57,8 +58,21 @@ class CliCommandSql : public CliCommand
         void printColumnHeader(const QList<int>& widths, const QStringList& columns);
         void printColumnDataRow(const QList<int>& widths, const SqlResultsRowPtr& row, int rowIdCount);
 
+        /**
+         * @brief Called after every printed row.
+         * @return true if printing should continue, or false if user interrupted it with Ctrl+C.
+         *
+         * Flushes the output from time to time, so rows show up while following rows are still being read.
+         */
+        bool rowPrinted();
+        void printInterrupted();
+
         QString getValueString(const QVariant& value);
 
+        QElapsedTimer flushTimer;
+
+        static const int flushInterval = 200; // ms
+
     private slots:
         void executionFailed(int code, const QString& msg);
 };